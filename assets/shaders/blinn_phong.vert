@@ -9,13 +9,16 @@ layout (location = 2) in vec2 aTexCoord;  // Texture coordinates
 out vec3 FragPos;        // Fragment position in world space
 out vec3 Normal;         // Normal in world space
 out vec2 TexCoord;       // Texture coordinates
-out vec4 FragPosLightSpace; // Fragment position in light space (for shadow mapping)
+out float ViewDepth;      // Distance de vue (choix de la cascade d'ombre)
+
+// Même calcul de gl_Position que la pré-passe de profondeur (shadow.vert, DEPTH_PREPASS) :
+// profondeurs identiques au bit près pour le test GL_EQUAL
+invariant gl_Position;
 
 // Uniform matrices
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
-uniform mat4 lightSpaceMatrix;
 
 void main()
 {
@@ -29,9 +32,8 @@ void main()
     // Pass through texture coordinates
     TexCoord = aTexCoord;
 
-    // Calculate fragment position in light space for shadow mapping
-    FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
-
     // Transform vertex to clip space
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+    vec4 viewPosition = view * vec4(FragPos, 1.0);
+    ViewDepth = -viewPosition.z;
+    gl_Position = projection * viewPosition;
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+// Ombres des spots dans la shadow atlas (voir ShadowAtlas)
+#include "lights.glsl"
+#include "shadows.glsl"
+
+uniform sampler2D shadowAtlas;
+
+// Profondeur de la shadow map perspective ramenée en distance le long de l'axe du spot
+float linearizeShadowDepth(float depth, float nearPlane, float farPlane) {
+    float z = depth * 2.0 - 1.0;
+    return 2.0 * nearPlane * farPlane / (farPlane + nearPlane - z * (farPlane - nearPlane));
+}
+
+// Facteur d'ombre d'un spot (0 = éclairé, 1 = dans l'ombre)
+float spotShadow(Light light, vec3 fragPos, vec3 normal) {
+    if (light.shadowRect.z <= 0.0)
+        return 0.0;
+
+    // Décalage normal d'environ un texel à la distance du fragment
+    vec3 lightDir = normalize(light.position - fragPos);
+    float texelWorld = light.shadowParams.x * length(light.position - fragPos);
+    float NdotL = clamp(dot(normal, lightDir), 0.0, 1.0);
+    vec3 offsetPos = fragPos + normal * texelWorld * 1.5 * max(1.0 - NdotL, 0.2);
+
+    vec4 lightSpacePos = light.shadowMatrix * vec4(offsetPos, 1.0);
+    vec3 projCoords = lightSpacePos.xyz / lightSpacePos.w * 0.5 + 0.5;
+    if (any(lessThan(projCoords, vec3(0.0))) || any(greaterThan(projCoords, vec3(1.0))))
+        return 0.0;
+
+    // Comparaison en distance linéaire : biais constant d'un texel quelle que soit la profondeur
+    float nearPlane = light.shadowParams.y;
+    float farPlane = light.shadowParams.z;
+    float currentDistance = linearizeShadowDepth(projCoords.z, nearPlane, farPlane);
+    float bias = texelWorld;
+
+    // PCF limité à la tuile (les voisines appartiennent à d'autres lumières)
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowAtlas, 0));
+    vec2 tileMin = light.shadowRect.xy + 0.5 * texelSize;
+    vec2 tileMax = light.shadowRect.xy + light.shadowRect.zw - 0.5 * texelSize;
+    vec2 uv = light.shadowRect.xy + projCoords.xy * light.shadowRect.zw;
+
+    const int halfKernel = PCF_TAPS / 2;
+    float shadow = 0.0;
+    for (int x = -halfKernel; x <= halfKernel; ++x) {
+        for (int y = -halfKernel; y <= halfKernel; ++y) {
+            vec2 sampleUv = clamp(uv + vec2(x, y) * texelSize, tileMin, tileMax);
+            float closest = linearizeShadowDepth(texture(shadowAtlas, sampleUv).r, nearPlane, farPlane);
+            shadow += currentDistance - bias > closest ? 1.0 : 0.0;
+        }
+    }
+    return shadow / float(PCF_TAPS * PCF_TAPS);
+}
@@ -0,0 +1,85 @@
+// Cascades d'ombre de la lumière directionnelle (voir CascadedShadowMap)
+#include "shadows.glsl"
+
+#define MAX_CASCADES 4
+
+// Filtrage (voir ShadowFilter)
+#define SHADOW_FILTER_PCF 0
+#define SHADOW_FILTER_HARDWARE 1
+#define SHADOW_FILTER_POISSON 2
+#define SHADOW_FILTER_VSM 3
+#ifndef SHADOW_FILTER
+#define SHADOW_FILTER SHADOW_FILTER_PCF
+#endif
+
+uniform sampler2DArray shadowMap;
+#if SHADOW_FILTER == SHADOW_FILTER_HARDWARE
+uniform sampler2DArrayShadow shadowMapCompare;
+#elif SHADOW_FILTER == SHADOW_FILTER_VSM
+uniform sampler2DArray shadowMoments;
+uniform float vsmBleedReduction;
+#endif
+uniform int cascadeCount;
+uniform mat4 cascadeMatrices[MAX_CASCADES];
+// x = distance de vue de fin, y = taille d'un texel (monde), z = profondeur couverte
+uniform vec4 cascadeParams[MAX_CASCADES];
+uniform float cascadeBlendBand;   // Fraction de la cascade fondue avec la suivante
+uniform bool showCascades;
+
+// Ombre d'une cascade : le receveur est décalé le long de la normale d'un demi-texel, plus la
+// demi-largeur du noyau PCF sur les surfaces rasantes, ce qui remplace l'essentiel du biais
+float cascadeShadow(int cascade, vec3 fragPos, vec3 normal, vec3 lightDir) {
+    vec4 params = cascadeParams[cascade];
+    float NdotL = clamp(dot(normal, lightDir), 0.0, 1.0);
+    float kernelTexels = float(1 + PCF_TAPS / 2);
+    vec3 offsetPos = fragPos + normal * params.y * (0.5 + kernelTexels * (1.0 - NdotL));
+
+    vec4 lightSpacePos = cascadeMatrices[cascade] * vec4(offsetPos, 1.0);
+    vec3 projCoords = lightSpacePos.xyz / lightSpacePos.w * 0.5 + 0.5;
+    if (projCoords.z > 1.0)
+        return 0.0;
+
+    float bias = kernelTexels * params.y / params.z;
+#if SHADOW_FILTER == SHADOW_FILTER_HARDWARE
+    return sampleShadowLayerHardware(shadowMapCompare, projCoords, float(cascade), bias);
+#elif SHADOW_FILTER == SHADOW_FILTER_POISSON
+    return sampleShadowLayerPoisson(shadowMap, projCoords, float(cascade), bias, kernelTexels);
+#elif SHADOW_FILTER == SHADOW_FILTER_VSM
+    return sampleMomentsLayer(shadowMoments, projCoords, float(cascade), vsmBleedReduction);
+#else
+    return sampleShadowLayer(shadowMap, projCoords, float(cascade), bias);
+#endif
+}
+
+// Facteur d'ombre (0 = éclairé, 1 = dans l'ombre) selon la profondeur de vue du fragment
+float cascadedShadow(vec3 fragPos, vec3 normal, vec3 lightDir, float viewDepth) {
+    int cascade = 0;
+    while (cascade < cascadeCount - 1 && viewDepth > cascadeParams[cascade].x)
+        ++cascade;
+
+    float splitEnd = cascadeParams[cascade].x;
+    if (viewDepth > splitEnd)
+        return 0.0;
+
+    float splitStart = cascade > 0 ? cascadeParams[cascade - 1].x : 0.0;
+    float band = cascadeBlendBand * (splitEnd - splitStart);
+    float shadow = cascadeShadow(cascade, fragPos, normal, lightDir);
+
+    // Fondu vers la cascade suivante (ou vers l'absence d'ombre après la dernière)
+    float blend = band > 0.0 ? clamp((splitEnd - viewDepth) / band, 0.0, 1.0) : 1.0;
+    if (blend < 1.0) {
+        float next = cascade + 1 < cascadeCount ? cascadeShadow(cascade + 1, fragPos, normal, lightDir) : 0.0;
+        shadow = mix(next, shadow, blend);
+    }
+    return shadow;
+}
+
+// Couleur de debug de la cascade qui couvre le fragment
+vec3 cascadeDebugColor(float viewDepth) {
+    const vec3 colors[MAX_CASCADES] = vec3[](
+        vec3(1.0, 0.3, 0.3), vec3(0.3, 1.0, 0.3), vec3(0.3, 0.3, 1.0), vec3(1.0, 1.0, 0.3));
+    int cascade = 0;
+    while (cascade < cascadeCount - 1 && viewDepth > cascadeParams[cascade].x)
+        ++cascade;
+    return viewDepth > cascadeParams[cascade].x ? vec3(1.0) : colors[cascade];
+}
@@ -0,0 +1,110 @@
+#include "material.glsl"
+
+// Types de lumières (doivent correspondre à l'enum C++)
+#define DIRECTIONAL 0
+#define POINT 1
+#define SPOT 2
+
+// Structure de lumière
+struct Light {
+    int type;                 // Type de lumière (DIRECTIONAL, POINT, SPOT)
+
+// Propriétés communes
+    vec3 color;               // Couleur de la lumière
+    float intensity;          // Intensité
+
+// Pour les lumières directionnelles
+    vec3 direction;           // Direction de la lumière
+
+// Pour les lumières ponctuelles et spots
+    vec3 position;            // Position de la lumière
+    float constant;           // Atténuation constante
+    float linear;             // Atténuation linéaire
+    float quadratic;          // Atténuation quadratique
+
+// Pour les lumières spots uniquement
+    float cutOff;             // Cosinus de l'angle intérieur
+    float outerCutOff;        // Cosinus de l'angle extérieur
+    mat4 shadowMatrix;        // Projection de la tuile d'ombre
+    vec4 shadowRect;          // Tuile dans la shadow atlas (UV) ; largeur 0 = pas d'ombre
+    vec4 shadowParams;        // Spot : x = texel par unité de distance, y = near, z = far
+                              // Point : x = première couche, y = far, w = 1 si ombrée
+};
+
+// Calcul de l'éclairage pour une lumière directionnelle
+vec3 calculateDirectionalLight(Light light, Material material, vec3 normal, vec3 viewDir) {
+    vec3 lightDir = normalize(-light.direction);
+
+    // Diffuse (Lambert)
+    float diff = max(dot(normal, lightDir), 0.0);
+
+    // Specular (Blinn-Phong)
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), material.shininess);
+
+    // Combine results
+    vec3 ambient = light.color * material.ambient;
+    vec3 diffuse = light.color * diff * material.diffuse;
+    vec3 specular = light.color * spec * material.specular;
+
+    return (ambient + diffuse + specular) * light.intensity;
+}
+
+// Calcul de l'éclairage pour une lumière ponctuelle (shadow : 0 = éclairé, 1 = dans l'ombre)
+vec3 calculatePointLight(Light light, Material material, vec3 normal, vec3 fragPos, vec3 viewDir, float shadow) {
+    vec3 lightDir = normalize(light.position - fragPos);
+
+    // Diffuse (Lambert)
+    float diff = max(dot(normal, lightDir), 0.0);
+
+    // Specular (Blinn-Phong)
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), material.shininess);
+
+    // Attenuation
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+
+    // Combine results
+    vec3 ambient = light.color * material.ambient;
+    vec3 diffuse = light.color * diff * material.diffuse;
+    vec3 specular = light.color * spec * material.specular;
+
+    return (ambient + (1.0 - shadow) * (diffuse + specular)) * attenuation * light.intensity;
+}
+
+vec3 calculatePointLight(Light light, Material material, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    return calculatePointLight(light, material, normal, fragPos, viewDir, 0.0);
+}
+
+// Calcul de l'éclairage pour une lumière spot (shadow : 0 = éclairé, 1 = diffus et spéculaire masqués)
+vec3 calculateSpotLight(Light light, Material material, vec3 normal, vec3 fragPos, vec3 viewDir, float shadow) {
+    vec3 lightDir = normalize(light.position - fragPos);
+
+    // Diffuse (Lambert)
+    float diff = max(dot(normal, lightDir), 0.0);
+
+    // Specular (Blinn-Phong)
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), material.shininess);
+
+    // Attenuation
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+
+    // Spotlight intensity
+    float theta = dot(lightDir, normalize(-light.direction));
+    float epsilon = light.cutOff - light.outerCutOff;
+    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+
+    // Combine results
+    vec3 ambient = light.color * material.ambient;
+    vec3 diffuse = light.color * diff * material.diffuse;
+    vec3 specular = light.color * spec * material.specular;
+
+    return (ambient + (1.0 - shadow) * (diffuse + specular)) * attenuation * intensity * light.intensity;
+}
+
+vec3 calculateSpotLight(Light light, Material material, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    return calculateSpotLight(light, material, normal, fragPos, viewDir, 0.0);
+}
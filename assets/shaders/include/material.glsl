@@ -0,0 +1,7 @@
+// Propriétés du matériau (doivent correspondre à struct Material en C++)
+struct Material {
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+    float shininess;
+};
@@ -0,0 +1,65 @@
+// Ombres des lumières ponctuelles (voir PointShadowMaps) : six couches par lumière
+#include "lights.glsl"
+#include "shadows.glsl"
+
+uniform sampler2DArray pointShadowMaps;
+
+// Orientation des faces : mêmes tables que PointShadowMaps.cpp (+X, -X, +Y, -Y, +Z, -Z)
+const vec3 CUBE_FACE_DIRECTIONS[6] = vec3[](
+    vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0), vec3(0.0, 1.0, 0.0),
+    vec3(0.0, -1.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0));
+const vec3 CUBE_FACE_UPS[6] = vec3[](
+    vec3(0.0, -1.0, 0.0), vec3(0.0, -1.0, 0.0), vec3(0.0, 0.0, 1.0),
+    vec3(0.0, 0.0, -1.0), vec3(0.0, -1.0, 0.0), vec3(0.0, -1.0, 0.0));
+
+// Face du cube vue dans la direction 'dir' (axe dominant)
+int cubeFace(vec3 dir) {
+    vec3 a = abs(dir);
+    if (a.x >= a.y && a.x >= a.z)
+        return dir.x > 0.0 ? 0 : 1;
+    if (a.y >= a.z)
+        return dir.y > 0.0 ? 2 : 3;
+    return dir.z > 0.0 ? 4 : 5;
+}
+
+// Facteur d'ombre d'une lumière ponctuelle (0 = éclairé, 1 = dans l'ombre)
+float pointShadow(Light light, vec3 fragPos, vec3 normal) {
+    if (light.shadowParams.w <= 0.0)
+        return 0.0;
+
+    float resolution = float(textureSize(pointShadowMaps, 0).x);
+    float farPlane = light.shadowParams.y;
+
+    // Décalage normal d'un texel environ (face à 90° : un texel = 2 * distance / résolution)
+    vec3 lightDir = normalize(light.position - fragPos);
+    float texelWorld = 2.0 * length(light.position - fragPos) / resolution;
+    float NdotL = clamp(dot(normal, lightDir), 0.0, 1.0);
+    float kernelTexels = float(1 + PCF_TAPS / 2);
+    vec3 toFrag = fragPos + normal * texelWorld * (0.5 + kernelTexels * (1.0 - NdotL)) - light.position;
+
+    float currentDistance = length(toFrag);
+    if (currentDistance >= farPlane)
+        return 0.0;
+
+    // Projection sur la face : même convention que glm::lookAt + perspective 90°
+    int face = cubeFace(toFrag);
+    vec3 forward = CUBE_FACE_DIRECTIONS[face];
+    vec3 right = cross(forward, CUBE_FACE_UPS[face]);
+    vec3 up = cross(right, forward);
+    vec2 uv = 0.5 + 0.5 * vec2(dot(toFrag, right), dot(toFrag, up)) / dot(toFrag, forward);
+    float layer = light.shadowParams.x + float(face);
+
+    // Distances normalisées par far (comme shadow_point.frag), biais d'un texel
+    float current = (currentDistance - texelWorld) / farPlane;
+    const int halfKernel = PCF_TAPS / 2;
+    float texelSize = 1.0 / resolution;
+    float shadow = 0.0;
+    for (int x = -halfKernel; x <= halfKernel; ++x) {
+        for (int y = -halfKernel; y <= halfKernel; ++y) {
+            vec2 sampleUv = clamp(uv + vec2(x, y) * texelSize, vec2(0.5 * texelSize), vec2(1.0 - 0.5 * texelSize));
+            float closest = texture(pointShadowMaps, vec3(sampleUv, layer)).r;
+            shadow += current > closest ? 1.0 : 0.0;
+        }
+    }
+    return shadow / float(PCF_TAPS * PCF_TAPS);
+}
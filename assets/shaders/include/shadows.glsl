@@ -0,0 +1,109 @@
+// Largeur du noyau PCF (1 = un seul échantillon, 3 = 3x3, 5 = 5x5)
+#ifndef PCF_TAPS
+#define PCF_TAPS 3
+#endif
+
+// Facteur d'ombre d'une shadow map 2D (0 = éclairé, 1 = dans l'ombre)
+float ShadowCalculation(sampler2D shadowMap, vec4 fragPosLightSpace, vec3 normal, vec3 lightDir) {
+    // Perform perspective divide
+    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
+
+    // Transform to [0,1] range
+    projCoords = projCoords * 0.5 + 0.5;
+
+    // Check if fragment is outside light's projection
+    if (projCoords.z > 1.0)
+        return 0.0;
+
+    // Get depth of current fragment from light's perspective
+    float currentDepth = projCoords.z;
+
+    // Calculate shadow bias to prevent shadow acne
+    float bias = max(0.05 * (1.0 - dot(normal, lightDir)), 0.005);
+
+    // PCF (Percentage Closer Filtering) : bornes constantes, boucle déroulable
+    const int halfKernel = PCF_TAPS / 2;
+    float shadow = 0.0;
+    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
+    for (int x = -halfKernel; x <= halfKernel; ++x) {
+        for (int y = -halfKernel; y <= halfKernel; ++y) {
+            float pcfDepth = texture(shadowMap, projCoords.xy + vec2(x, y) * texelSize).r;
+            shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
+        }
+    }
+    shadow /= float(PCF_TAPS * PCF_TAPS);
+
+    return shadow;
+}
+
+// PCF sur une couche d'une shadow map 2D array (projCoords déjà dans [0,1])
+float sampleShadowLayer(sampler2DArray shadowMap, vec3 projCoords, float layer, float bias) {
+    const int halfKernel = PCF_TAPS / 2;
+    float shadow = 0.0;
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    for (int x = -halfKernel; x <= halfKernel; ++x) {
+        for (int y = -halfKernel; y <= halfKernel; ++y) {
+            float pcfDepth = texture(shadowMap, vec3(projCoords.xy + vec2(x, y) * texelSize, layer)).r;
+            shadow += projCoords.z - bias > pcfDepth ? 1.0 : 0.0;
+        }
+    }
+    return shadow / float(PCF_TAPS * PCF_TAPS);
+}
+
+
+// PCF matériel : chaque tap est une comparaison filtrée bilinéairement par le sampler
+// (GL_COMPARE_REF_TO_TEXTURE + GL_LINEAR), même grille que sampleShadowLayer
+float sampleShadowLayerHardware(sampler2DArrayShadow shadowMap, vec3 projCoords, float layer, float bias) {
+    const int halfKernel = PCF_TAPS / 2;
+    float lit = 0.0;
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    for (int x = -halfKernel; x <= halfKernel; ++x) {
+        for (int y = -halfKernel; y <= halfKernel; ++y) {
+            lit += texture(shadowMap, vec4(projCoords.xy + vec2(x, y) * texelSize, layer, projCoords.z - bias));
+        }
+    }
+    return 1.0 - lit / float(PCF_TAPS * PCF_TAPS);
+}
+
+// Disque de Poisson de 16 points dans le disque unité
+const vec2 POISSON_DISK[16] = vec2[](
+    vec2(-0.94201624, -0.39906216), vec2(0.94558609, -0.76890725),
+    vec2(-0.09418410, -0.92938870), vec2(0.34495938, 0.29387760),
+    vec2(-0.91588581, 0.45771432), vec2(-0.81544232, -0.87912464),
+    vec2(-0.38277543, 0.27676845), vec2(0.97484398, 0.75648379),
+    vec2(0.44323325, -0.97511554), vec2(0.53742981, -0.47373420),
+    vec2(-0.26496911, -0.41893023), vec2(0.79197514, 0.19090188),
+    vec2(-0.24188840, 0.99706507), vec2(-0.81409955, 0.91437590),
+    vec2(0.19984126, 0.78641367), vec2(0.14383161, -0.14100790));
+
+// Bruit "interleaved gradient" : angle de rotation du disque, différent pour chaque pixel
+float interleavedGradientNoise(vec2 pixel) {
+    return fract(52.9829189 * fract(dot(pixel, vec2(0.06711056, 0.00583715))));
+}
+
+// Disque de Poisson tourné par pixel : le crénelage du PCF devient un bruit fin
+float sampleShadowLayerPoisson(sampler2DArray shadowMap, vec3 projCoords, float layer, float bias, float radiusTexels) {
+    float angle = 6.28318531 * interleavedGradientNoise(gl_FragCoord.xy);
+    mat2 rotation = mat2(cos(angle), sin(angle), -sin(angle), cos(angle));
+    vec2 radius = radiusTexels / vec2(textureSize(shadowMap, 0).xy);
+    float shadow = 0.0;
+    for (int i = 0; i < 16; ++i) {
+        float depth = texture(shadowMap, vec3(projCoords.xy + rotation * POISSON_DISK[i] * radius, layer)).r;
+        shadow += projCoords.z - bias > depth ? 1.0 : 0.0;
+    }
+    return shadow / 16.0;
+}
+
+// Variance shadow map : borne de Chebyshev sur les moments filtrés (mips comprises).
+// bleedReduction ramène à 0 les faibles p_max, responsables du light bleeding.
+float sampleMomentsLayer(sampler2DArray moments, vec3 projCoords, float layer, float bleedReduction) {
+    vec2 m = texture(moments, vec3(projCoords.xy, layer)).rg;
+    if (projCoords.z <= m.x)
+        return 0.0;
+
+    float variance = max(m.y - m.x * m.x, 1e-6);
+    float d = projCoords.z - m.x;
+    float pMax = variance / (variance + d * d);
+    pMax = clamp((pMax - bleedReduction) / (1.0 - bleedReduction), 0.0, 1.0);
+    return 1.0 - pMax;
+}
\ No newline at end of file
@@ -7,12 +7,7 @@ in vec4 FragPosLightSpace[8];
 
 out vec4 FragColor;
 
-struct Material {
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    float shininess;
-};
+#include "include/material.glsl"
 
 struct Light {
     int type;           // 0 = directional, 1 = point, 2 = spot
@@ -9,13 +9,8 @@ in vec4 FragPosLightSpace;    // Fragment position in light space
 // Output color
 out vec4 FragColor;
 
-// Material properties
-struct Material {
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    float shininess;
-};
+#include "include/material.glsl"
+#include "include/shadows.glsl"
 
 // Light properties
 uniform vec3 lightPos;
@@ -31,43 +26,6 @@ uniform sampler2D shadowMap;
 // Optional diffuse texture (set to -1 if not used)
 uniform sampler2D diffuseTexture;
 
-// Function to calculate shadow factor
-float ShadowCalculation(vec4 fragPosLightSpace) {
-    // Perform perspective divide
-    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
-
-    // Transform to [0,1] range
-    projCoords = projCoords * 0.5 + 0.5;
-
-    // Check if fragment is outside light's projection
-    if(projCoords.z > 1.0)
-    return 0.0;
-
-    // Get closest depth value from light's perspective
-    float closestDepth = texture(shadowMap, projCoords.xy).r;
-
-    // Get depth of current fragment from light's perspective
-    float currentDepth = projCoords.z;
-
-    // Calculate shadow bias to prevent shadow acne
-    vec3 normal = normalize(Normal);
-    vec3 lightColor = normalize(lightPos - FragPos);
-    float bias = max(0.05 * (1.0 - dot(normal, lightColor)), 0.005);
-
-    // PCF (Percentage Closer Filtering) for softer shadows
-    float shadow = 0.0;
-    vec2 texelSize = 1.0 / textureSize(shadowMap, 0);
-    for(int x = -1; x <= 1; ++x) {
-        for(int y = -1; y <= 1; ++y) {
-            float pcfDepth = texture(shadowMap, projCoords.xy + vec2(x, y) * texelSize).r;
-            shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
-        }
-    }
-    shadow /= 9.0;
-
-    return shadow;
-}
-
 void main() {
     // Normalize the normal vector
     vec3 norm = normalize(Normal);
@@ -97,7 +55,7 @@ void main() {
     vec3 specular = spec * material.specular * lightColor;
 
     // Calculate shadow factor
-    float shadow = ShadowCalculation(FragPosLightSpace);
+    float shadow = ShadowCalculation(shadowMap, FragPosLightSpace, norm, lightDir);
 
     // Apply attenuation to diffuse and specular (not ambient)
     diffuse *= attenuation;
@@ -2,10 +2,23 @@
 
 layout (location = 0) in vec3 aPos;
 
+#ifdef DEPTH_PREPASS
+// Pré-passe de profondeur de la caméra : même calcul que blinn_phong.vert pour que la passe
+// principale (GL_EQUAL) retrouve exactement les mêmes profondeurs
+invariant gl_Position;
+uniform mat4 view;
+uniform mat4 projection;
+#else
 uniform mat4 lightSpaceMatrix;
+#endif
 uniform mat4 model;
 
 void main()
 {
+#ifdef DEPTH_PREPASS
+    vec3 worldPosition = vec3(model * vec4(aPos, 1.0));
+    gl_Position = projection * (view * vec4(worldPosition, 1.0));
+#else
     gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#version 330 core
+// Flou gaussien séparable des moments d'une shadow map (VSM)
+out vec2 Moments;
+
+uniform sampler2DArray source;
+uniform int sourceLayer;
+uniform bool sourceIsDepth;     // Première passe : la source est la profondeur, pas des moments
+uniform vec2 blurDirection;     // (1, 0) ou (0, 1)
+uniform int blurRadius;         // En texels
+
+vec2 fetchMoments(ivec2 texel, ivec2 maxTexel)
+{
+    vec4 value = texelFetch(source, ivec3(clamp(texel, ivec2(0), maxTexel), sourceLayer), 0);
+    return sourceIsDepth ? vec2(value.r, value.r * value.r) : value.rg;
+}
+
+void main()
+{
+    ivec2 center = ivec2(gl_FragCoord.xy);
+    ivec2 maxTexel = textureSize(source, 0).xy - 1;
+    ivec2 step = ivec2(blurDirection);
+
+    float sigma = max(float(blurRadius) * 0.5, 0.5);
+    vec2 sum = vec2(0.0);
+    float weightSum = 0.0;
+    for (int i = -blurRadius; i <= blurRadius; ++i) {
+        float weight = exp(-float(i * i) / (2.0 * sigma * sigma));
+        sum += fetchMoments(center + step * i, maxTexel) * weight;
+        weightSum += weight;
+    }
+    Moments = sum / weightSum;
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#version 330 core
+
+// Triangle couvrant l'écran, sans vertex buffer (VAO vide, 3 sommets)
+void main()
+{
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
\ No newline at end of file
@@ -4,6 +4,19 @@ layout (location = 0) in vec3 aPos;
 
 uniform mat4 model;
 
+#ifdef SINGLE_FACE
+// Rendu face par face (six passes) : pas d'étage géométrie
+uniform mat4 shadowMatrix;
+out vec4 FragPos;
+#endif
+
 void main() {
-    gl_Position = model * vec4(aPos, 1.0);
-}
\ No newline at end of file
+    vec4 worldPos = model * vec4(aPos, 1.0);
+#ifdef SINGLE_FACE
+    FragPos = worldPos;
+    gl_Position = shadowMatrix * worldPos;
+#else
+    // Position monde, projetée sur chaque face par le geometry shader
+    gl_Position = worldPos;
+#endif
+}
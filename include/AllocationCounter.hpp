@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+// Compteur d'allocations sur le tas, branché sur l'operator new global.
+// Permet de vérifier qu'une frame en régime établi n'alloue rien.
+class AllocationCounter {
+public:
+    // Nombre total d'appels à operator new depuis le lancement
+    static std::size_t getCount();
+
+    // Nombre total d'octets demandés depuis le lancement
+    static std::size_t getBytes();
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+
+// Options de la ligne de commande
+struct AppOptions {
+    // Mode sans fenêtre visible : rendu dans un FBO puis sortie
+    bool headless = false;
+    int frameCount = 100;           // Nombre de frames rendues en mode headless
+    std::string outputImage;        // Capture PPM de la dernière frame (optionnel)
+
+    // Benchmark : rejoue un chemin de caméra avec une horloge simulée fixe
+    std::string benchmarkCameraPath;
+    int warmupFrames = 60;
+    int measuredFrames = 300;
+    std::string reportPrefix = "benchmark_results";
+
+    // Trace CPU (Chrome trace JSON) écrite à la sortie, si compilée avec ENABLE_TRACING
+    std::string tracePath;
+
+    // Enregistrement d'un chemin de caméra pendant une session interactive
+    std::string recordCameraPath;
+
+    // Force la compilation des shaders (mesure du démarrage à froid)
+    bool disableProgramCache = false;
+
+    // Textures décodées à chaque lancement, non compressées (comparaison avec le cache BC1)
+    bool disableTextureCache = false;
+
+    // Maillages importés recompilés à chaque lancement (cache de maillages compilés ignoré)
+    bool disableMeshCache = false;
+
+    // Modèle (OBJ, glTF) ajouté à la scène
+    std::string modelPath;
+
+    // Monde découpé en cellules (.world), chargées en arrière-plan autour de la caméra
+    std::string worldPath;
+
+    // Scène de test de montée en charge (remplace les lumières par défaut), même graine = même scène
+    int stressObjects = 0;          // 0 = pas de scène de test
+    int stressDirectionalLights = 1;
+    int stressPointLights = 1;
+    int stressSpotLights = 1;
+    unsigned int stressSeed = 1;
+    bool stressAnimate = false;
+
+    // Mesure du débit d'import et de chargement d'un modèle, puis sortie
+    std::string meshBenchmarkPath;
+
+    // Budget de mémoire vidéo (Mo) : au-delà, les géométries streamables les moins récemment
+    // visibles sont évincées. 0 = illimité
+    int vramBudgetMB = 1024;
+
+    // Archive d'assets (assets.pack) : par défaut montée en headless / benchmark si elle existe.
+    // Donnée explicitement, elle est aussi utilisée en session interactive (sans rechargement à chaud)
+    std::string assetPackPath;
+    bool disableAssetPack = false;
+
+    // Ombres des lumières ponctuelles : 1 = passe unique (geometry shader), 6 = une passe par face
+    int pointShadowPasses = 1;
+
+    // Pré-passe de profondeur : la passe principale n'éclaire que les fragments visibles
+    bool depthPrepass = false;
+
+    // Filtrage des cascades (valeur de ShadowFilter) : pcf, hardware, poisson ou vsm
+    int shadowFilter = 0;
+
+    bool showHelp = false;
+};
+
+// Analyse argc/argv. Retourne false (et affiche l'erreur) si un argument est invalide.
+bool parseAppOptions(int argc, char** argv, AppOptions& options);
+
+// Affiche l'aide de la ligne de commande
+void printAppUsage(const char* programName);
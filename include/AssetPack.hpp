@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Archive d'assets projetée en mémoire (mmap / MapViewOfFile) : au démarrage, un seul fichier
+// est ouvert et les assets sont servis comme des vues sur la projection, sans lecture ni copie.
+// Les pages ne sont chargées qu'au premier accès.
+//
+// Format : en-tête, données des entrées (chacune alignée sur 64 octets), index trié par chemin
+// (recherche dichotomique) puis table des chemins. Une entrée peut être compressée en LZ4
+// (bloc) : elle est alors décompressée à la lecture et n'est plus accessible par view().
+// Les chemins sont relatifs au répertoire de travail et normalisés ("assets/shaders/basic.vert").
+//
+// L'archive est construite par l'outil asset_packer (cible CMake asset_pack).
+class AssetPack {
+public:
+    static const std::size_t ALIGNMENT = 64;
+    static const std::uint32_t FLAG_LZ4 = 1;
+
+    struct Entry {
+        std::uint64_t dataOffset;
+        std::uint64_t storedSize;       // Taille dans l'archive (compressée si FLAG_LZ4)
+        std::uint64_t size;             // Taille décompressée
+        std::uint32_t pathOffset;       // Dans la table des chemins
+        std::uint32_t pathLength;
+        std::uint32_t flags;
+        std::uint32_t reserved;
+    };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t entryCount;
+        std::uint64_t indexOffset;
+        std::uint64_t pathsOffset;
+        std::uint64_t pathsSize;
+    };
+
+    static const char MAGIC[8];
+    static const std::uint32_t VERSION = 1;
+
+    AssetPack() = default;
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // Projette l'archive et valide l'en-tête et l'index. Retourne false (message sur std::cerr)
+    // si le fichier est absent ou invalide.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    const std::string& getPath() const { return packPath; }
+    std::size_t getEntryCount() const { return entryCount; }
+    std::size_t getMappedSize() const { return mappedSize; }
+
+    // nullptr si 'path' n'est pas dans l'archive
+    const Entry* find(std::string_view path) const;
+    std::string_view getEntryPath(const Entry& entry) const;
+
+    // Octets d'une entrée non compressée, directement dans la projection (vide sinon).
+    // La vue reste valide tant que l'archive est ouverte.
+    std::string_view view(std::string_view path) const;
+
+    // Copie (et décompresse si besoin) l'entrée dans 'content'
+    bool read(std::string_view path, std::string& content) const;
+
+    // Normalise un chemin comme les clés de l'index ("a/b/../c.glsl" -> "a/c.glsl")
+    static std::string normalizePath(const std::string& path);
+
+    // Archive montée pour toute l'application : consultée par Shader et TextureCache avant
+    // les fichiers. À monter avant le premier chargement, lecture seule ensuite (sûre
+    // depuis les threads de décodage).
+    static bool mount(const std::string& path);
+    static void unmount();
+    static const AssetPack* getMounted();
+
+    // Fichier 'path' depuis l'archive montée, sinon depuis le disque
+    static bool readAsset(const std::string& path, std::string& content);
+
+private:
+    void* mapping = nullptr;
+    std::size_t mappedSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+    const unsigned char* base = nullptr;
+    const Entry* entries = nullptr;
+    std::size_t entryCount = 0;
+    const char* paths = nullptr;
+    std::string packPath;
+
+    bool validate();
+};
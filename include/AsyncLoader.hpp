@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Task.hpp"
+#include <GL/glew.h>
+#include <cstddef>
+#include <string>
+
+class Geometry;
+
+// Chargements asynchrones des ressources, en coroutines (Task) :
+// lecture et décodage sur un thread du JobSystem (caches de textures et de maillages,
+// archive d'assets), puis reprise sur le thread GL pour l'upload, dans le budget de
+// JobSystem::runMainThreadJobs. Aucune frame n'attend un chargement.
+//
+//   Task<AsyncLoader::Texture> texture = AsyncLoader::loadTexture("assets/images/top.jpg");
+//   ...
+//   if (texture.isReady() && texture.get().isValid()) { ... }
+//
+// Les coroutines doivent être lancées depuis le thread GL.
+class AsyncLoader {
+public:
+    struct Texture {
+        GLuint id = 0;              // GL_TEXTURE_2D avec toutes ses mips, 0 si échec
+        int width = 0;
+        int height = 0;
+        std::size_t bytes = 0;
+
+        bool isValid() const { return id != 0; }
+    };
+
+    struct Stats {
+        int textures = 0;
+        int meshes = 0;
+        int failures = 0;
+        int inFlight = 0;           // Chargements lancés, pas encore terminés
+        double latencyMs = 0.0;     // Cumul, du lancement à la ressource utilisable
+        double maxLatencyMs = 0.0;
+        double uploadMs = 0.0;      // Cumul du temps passé sur le thread GL
+        double maxUploadMs = 0.0;
+    };
+
+    // Texture 2D (BC1 + mips via le cache de textures)
+    static Task<Texture> loadTexture(std::string path);
+
+    // Maillage compilé (cache de maillages) transféré dans 'geometry', qui doit rester vivante
+    // jusqu'à la fin. Résultat false si la source est illisible.
+    static Task<bool> loadMesh(std::string path, Geometry* geometry);
+
+    static Stats getStats();
+    static void printReport();
+};
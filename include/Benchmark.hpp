@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "GpuProfiler.hpp"
+
+// Passes de rendu mesurées individuellement
+enum class RenderPass {
+    SHADOW,
+    DEPTH_PREPASS,
+    MAIN,
+    SKYBOX,
+    LIGHT_SOURCES,
+    GUI,
+    COUNT
+};
+
+constexpr int RENDER_PASS_COUNT = static_cast<int>(RenderPass::COUNT);
+const char* getRenderPassName(RenderPass pass);
+
+// Temps d'une frame, en millisecondes
+struct FrameTimings {
+    double cpuMs = 0.0;
+    double gpuMs = 0.0;
+    std::array<double, RENDER_PASS_COUNT> passCpuMs{};
+    std::array<double, RENDER_PASS_COUNT> passGpuMs{};
+};
+
+// Chronomètre CPU de la frame et de chaque passe (les temps GPU viennent du GpuProfiler)
+class FrameTimer {
+public:
+    void beginFrame();
+    void endFrame();
+
+    void beginPass(RenderPass pass);
+    void endPass(RenderPass pass);
+
+    // Temps CPU de la dernière frame terminée
+    const FrameTimings& getLastFrame() const { return lastFrame; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point frameStart;
+    std::array<Clock::time_point, RENDER_PASS_COUNT> passStart;
+    FrameTimings current;
+    FrameTimings lastFrame;
+};
+
+// Statistiques d'une série de mesures
+struct PercentileSummary {
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+
+    static PercentileSummary compute(std::vector<double> values);
+};
+
+// Contenu de la scène mesurée (objets hors terrain et monde en streaming, lumières actives)
+struct BenchmarkScene {
+    std::size_t objects = 0;
+    int directionalLights = 0;
+    int pointLights = 0;
+    int spotLights = 0;
+    unsigned int seed = 0;          // Graine de la scène de test (0 = scène par défaut)
+};
+
+// Collecte des frames d'un benchmark (warm-up puis frames mesurées) et écriture des rapports
+class BenchmarkRecorder {
+public:
+    BenchmarkRecorder(int warmupFrames, int measuredFrames);
+
+    int getTotalFrames() const { return warmupFrames + measuredFrames; }
+
+    // Recopié dans les rapports pour comparer des exécutions à scènes différentes
+    void setScene(const BenchmarkScene& description) { scene = description; }
+
+    // Les frames de warm-up sont ignorées
+    void recordCpu(int frameIndex, const FrameTimings& timings);
+    // Temps GPU d'une frame résolue ; les scopes de profondeur 0 nommés comme une passe
+    // (getRenderPassName) alimentent le détail par passe
+    void recordGpu(int frameIndex, double gpuMs, const std::vector<GpuProfiler::ScopeResult>& scopes);
+
+    // Écrit <prefix>.csv et <prefix>.json
+    bool writeReports(const std::string& prefix) const;
+
+    // Résumé lisible sur la sortie standard
+    void printSummary() const;
+
+private:
+    int warmupFrames;
+    int measuredFrames;
+    BenchmarkScene scene;
+    std::vector<FrameTimings> frames;
+    std::vector<bool> gpuValid;
+
+    FrameTimings* getMeasuredFrame(int frameIndex);
+    std::vector<double> collect(double FrameTimings::*field) const;
+    std::vector<double> collectPass(std::array<double, RENDER_PASS_COUNT> FrameTimings::*field,
+                                    int pass, bool gpu) const;
+    std::vector<double> collectGpu() const;
+};
+
+// Débit d'import (source -> maillage soudé et optimisé, un thread puis tous les cœurs) et de
+// chargement (entrée compilée -> buffers de Geometry) du modèle 'modelPath', résultats sur la
+// sortie standard. Nécessite un contexte GL courant. Retourne false si le modèle est illisible.
+bool runMeshBenchmark(const std::string& modelPath, int loadIterations = 10);
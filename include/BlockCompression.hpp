@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+// Compression BC1 (DXT1, GL_COMPRESSED_RGB_S3TC_DXT1_EXT) : blocs de 4x4 texels en 8 octets,
+// deux couleurs RGB565 et quatre niveaux interpolés. L'alpha est ignoré.
+namespace BlockCompression {
+    // Taille en octets d'une image BC1 (blocs partiels comptés entiers)
+    std::size_t bc1Size(int width, int height);
+
+    // Compresse une image RGBA8 ; 'output' doit contenir bc1Size(width, height) octets.
+    // Les extrémités suivent l'axe principal des couleurs du bloc (ACP), ce qui suit bien
+    // les dégradés (ciel, nuages) mieux qu'une simple boîte englobante.
+    void compressBC1(const unsigned char* rgba, int width, int height, unsigned char* output);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+
+// Écriture d'une entrée des caches disque (programmes, textures, maillages) : le contenu est
+// écrit dans un fichier temporaire propre à cet appel (processus + compteur), puis renommé.
+// Plusieurs threads ou plusieurs instances de l'application peuvent écrire la même entrée
+// en même temps : chacun publie une entrée complète, jamais un mélange des deux.
+//
+// Crée le dossier parent si besoin. Retourne false si l'écriture ou le renommage échoue
+// (le fichier temporaire est alors supprimé).
+bool writeCacheFile(const std::string& path, const std::function<void(std::ostream&)>& write);
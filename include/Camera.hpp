@@ -19,6 +19,8 @@ const float PITCH       =  0.0f;
 const float SPEED       =  5.0f;
 const float SENSITIVITY =  0.1f;
 const float ZOOM        =  45.0f;
+const float NEAR_PLANE  =  0.1f;
+const float FAR_PLANE   =  1000.0f;   // Terrain visible jusqu'à l'horizon
 
 class Camera {
 private:
@@ -71,6 +73,7 @@ public:
     // Camera manipulation
     void setPosition(const glm::vec3& newPosition);
     void setTarget(const glm::vec3& target);
+    void setOrientation(float newYaw, float newPitch);
     void setMovementSpeed(float speed);
     void setMouseSensitivity(float sensitivity);
     void setZoom(float newZoom);
@@ -83,6 +86,8 @@ public:
     float getZoom() const;
     float getYaw() const;
     float getPitch() const;
+    float getNearPlane() const;
+    float getFarPlane() const;
 
     // Reset camera to default state
     void reset();
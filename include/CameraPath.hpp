@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+class Camera;
+
+// Chemin de caméra enregistré (keyframes position + yaw/pitch)
+// Format texte, une keyframe par ligne : "time posX posY posZ yaw pitch"
+class CameraPath {
+public:
+    struct Keyframe {
+        float time;
+        glm::vec3 position;
+        float yaw;
+        float pitch;
+    };
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // Enregistrement : ajoute une keyframe à partir de l'état de la caméra
+    void record(float time, const Camera& camera);
+
+    // Place la caméra au temps donné (interpolation linéaire, le chemin boucle)
+    void apply(float time, Camera& camera) const;
+
+    bool isEmpty() const { return keyframes.empty(); }
+    float getDuration() const { return keyframes.empty() ? 0.0f : keyframes.back().time; }
+
+private:
+    std::vector<Keyframe> keyframes;
+};
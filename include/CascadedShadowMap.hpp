@@ -0,0 +1,110 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include "Camera.hpp"
+#include "RenderList.hpp"
+#include "Shader.hpp"
+#include "ShadowSettings.hpp"
+
+// Cascades d'ombre de la lumière directionnelle, stockées dans une texture de profondeur 2D array.
+// Les coupes suivent le schéma "practical split" (mélange logarithmique / uniforme) entre le near
+// de la caméra et la distance d'ombre ; chaque cascade est une projection orthographique ajustée
+// à la sphère englobante de sa tranche de frustum (stable en rotation), alignée sur les texels
+// pour éviter le scintillement, et étendue vers la lumière pour inclure les casters hors tranche.
+//
+// Chaque cascade a deux couches : une couche statique en cache (casters immobiles), redessinée
+// seulement quand la projection de la cascade ou les casters statiques changent, et la couche
+// utilisée par le shader, recomposée à partir de la copie statique et des casters dynamiques.
+// Le nombre de couches statiques redessinées par frame est borné ; une cascade non servie garde
+// sa projection précédente (cohérente avec son cache) jusqu'à son tour.
+//
+// Filtrage (ShadowSettings::filter) : la profondeur brute est toujours liée pour le PCF manuel et
+// le disque de Poisson ; le PCF matériel lit la même texture à travers un sampler de comparaison,
+// et les VSM lisent une texture de moments (profondeur, profondeur²) floutée et mipmappée, mise à
+// jour seulement pour les cascades recomposées.
+class CascadedShadowMap {
+public:
+    static constexpr int MAX_CASCADES = 4;
+
+    explicit CascadedShadowMap(int resolution);
+    ~CascadedShadowMap();
+
+    CascadedShadowMap(const CascadedShadowMap&) = delete;
+    CascadedShadowMap& operator=(const CascadedShadowMap&) = delete;
+
+    // Calcule les coupes et les matrices des cascades pour la frame, puis choisit les couches
+    // statiques à redessiner (dans la limite de settings.staticUpdateBudget)
+    void update(const Camera& camera, float aspectRatio, const glm::vec3& lightDirection,
+                const RenderList& casters, const ShadowSettings& settings);
+
+    // La couche statique de la cascade doit être redessinée cette frame
+    bool isStaticRefreshScheduled(int cascade) const { return staticRefreshScheduled[cascade]; }
+
+    // Lie le framebuffer de la couche statique (viewport compris) et efface sa profondeur
+    void beginStaticLayer(int cascade);
+
+    // Prépare la couche lue par le shader : copie de la couche statique (ou effacement sans cache).
+    // Retourne false si la couche de la frame précédente est encore valide : rien à dessiner.
+    bool beginCascade(int cascade, bool hasDynamicCasters);
+
+    // VSM : moments des cascades recomposées depuis le dernier appel, flou séparable en deux passes
+    // (horizontale depuis la profondeur, verticale vers la couche de moments) puis mipmaps.
+    // 'blurShader' : shadow_moments.vert/.frag. Retourne le nombre de cascades filtrées.
+    int prefilterMoments(Shader& blurShader, const ShadowSettings& settings);
+
+    // Uniformes lus par cascades.glsl : profondeur brute sur 'depthUnit', texture du filtre
+    // (sampler de comparaison ou moments) sur 'filterUnit'
+    void applyUniforms(Shader& shader, int depthUnit, int filterUnit, const ShadowSettings& settings) const;
+
+    int getCascadeCount() const { return cascadeCount; }
+    int getResolution() const { return resolution; }
+    GLuint getTexture() const { return depthTexture; }
+    const glm::mat4& getMatrix(int cascade) const { return matrices[cascade]; }
+    float getSplitDistance(int cascade) const { return splitDistances[cascade]; }
+    bool isCachingEnabled() const { return cachingEnabled; }
+
+    // Couches statiques redessinées / cascades réutilisées telles quelles lors de la dernière frame
+    int getStaticRefreshCount() const { return staticRefreshCount; }
+    int getReusedCascadeCount() const { return reusedCascadeCount; }
+
+private:
+    int resolution;
+    int cascadeCount;
+    GLuint depthTexture;
+    GLuint framebuffers[MAX_CASCADES];
+    GLuint staticTexture;
+    GLuint staticFramebuffers[MAX_CASCADES];
+    GLuint compareSampler;                  // GL_COMPARE_REF_TO_TEXTURE + GL_LINEAR
+
+    // VSM, créés au premier prefilterMoments()
+    GLuint momentsTexture;                  // RG32F 2D array mipmappée
+    GLuint momentsFramebuffers[MAX_CASCADES];
+    GLuint blurTexture;                     // Résultat de la passe horizontale (une couche)
+    GLuint blurFramebuffer;
+    GLuint fullscreenVertexArray;           // VAO vide : triangle plein écran généré par gl_VertexID
+    int momentsBlurRadius;
+    bool momentsValid[MAX_CASCADES];        // Moments calculés depuis la couche courante
+
+    glm::mat4 matrices[MAX_CASCADES];
+    float splitDistances[MAX_CASCADES];     // Distance de vue de fin de chaque cascade
+    float texelSizes[MAX_CASCADES];         // Taille d'un texel en unités monde
+    float depthRanges[MAX_CASCADES];        // Profondeur couverte par la projection
+
+    // Cache des couches statiques
+    bool cachingEnabled;
+    std::uint64_t staticCasterHash;         // Géométrie et matrices des casters statiques
+    bool staticValid[MAX_CASCADES];         // Couche statique rendue avec matrices[i] et le hash courant
+    bool staticHasContent[MAX_CASCADES];    // Couche statique déjà rendue au moins une fois
+    bool staticRefreshScheduled[MAX_CASCADES];
+    int staleFrames[MAX_CASCADES];          // Frames d'attente d'une cascade périmée (anti-famine)
+    bool liveValid[MAX_CASCADES];           // Couche lue par le shader à jour sans casters dynamiques
+    int staticRefreshCount;
+    int reusedCascadeCount;
+
+    // Projection ajustée à la tranche [sliceNear, sliceFar] (sans la mémoriser)
+    void fitCascade(float sliceNear, float sliceFar, const glm::mat4& inverseView,
+                    float tanHalfFovX, float tanHalfFovY, const glm::vec3& direction,
+                    const RenderList& casters, glm::mat4& matrix, float& texelSize, float& depthRange) const;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Surveillance de répertoires (inotify sous Linux) sur un thread dédié.
+// Les chemins modifiés sont regroupés et rendus au thread principal après un court délai,
+// pour qu'une sauvegarde en plusieurs écritures ne déclenche qu'un seul rechargement.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Surveille les fichiers d'un répertoire (non récursif)
+    bool watchDirectory(const std::string& directory);
+
+    // Chemins canoniques des fichiers modifiés et stables depuis au moins 'debounce'
+    std::vector<std::string> takeChanges(std::chrono::milliseconds debounce = std::chrono::milliseconds(100));
+
+    bool isSupported() const { return inotifyFd >= 0; }
+
+private:
+    void threadLoop();
+
+    int inotifyFd;
+    std::unordered_map<int, std::string> watchedDirectories;  // Descripteur inotify -> répertoire
+    std::mutex mutex;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> changes;
+    std::atomic<bool> stopping;
+    std::thread thread;
+};
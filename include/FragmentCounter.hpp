@@ -0,0 +1,60 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <cstdint>
+#include "GpuProfiler.hpp"
+
+// Passes dont les fragments sont comptés
+enum class FragmentPass {
+    DEPTH_PREPASS,  // Fragments écrits dans le depth buffer par la pré-passe
+    LIT,            // Fragments éclairés par la passe principale (blinn_phong.frag)
+    COUNT
+};
+
+constexpr int FRAGMENT_PASS_COUNT = static_cast<int>(FragmentPass::COUNT);
+
+// Compteur de fragments ayant passé le test de profondeur (GL_SAMPLES_PASSED) : mesure de
+// l'overdraw. Comme pour le GpuProfiler, les requêtes sont relues FRAME_LATENCY frames plus
+// tard pour ne jamais bloquer le CPU sur le GPU. Une seule passe comptée à la fois.
+class FragmentCounter {
+public:
+    static const int FRAME_LATENCY = GpuProfiler::FRAME_LATENCY;
+
+    FragmentCounter();
+    ~FragmentCounter();
+
+    FragmentCounter(const FragmentCounter&) = delete;
+    FragmentCounter& operator=(const FragmentCounter&) = delete;
+
+    // Relit la plus ancienne frame en attente si ses résultats sont disponibles (sans bloquer).
+    // Retourne true si une frame a été résolue ; à appeler en boucle avant beginFrame().
+    bool collect();
+
+    void beginFrame(int frameIndex);
+    void endFrame();
+
+    void begin(FragmentPass pass);
+    void end();
+
+    // Dernière frame résolue ; une passe non comptée dans cette frame n'a pas été mesurée
+    bool wasMeasured(FragmentPass pass) const { return resolvedMeasured[static_cast<int>(pass)]; }
+    std::uint64_t getFragments(FragmentPass pass) const { return resolvedFragments[static_cast<int>(pass)]; }
+
+private:
+    struct FrameQueries {
+        std::array<GLuint, FRAGMENT_PASS_COUNT> queries{};
+        std::array<bool, FRAGMENT_PASS_COUNT> measured{};
+        int frameIndex = -1;
+        bool pending = false;
+    };
+
+    std::array<FrameQueries, FRAME_LATENCY> frames;
+    FrameQueries* current;
+    bool active;
+
+    std::array<std::uint64_t, FRAGMENT_PASS_COUNT> resolvedFragments{};
+    std::array<bool, FRAGMENT_PASS_COUNT> resolvedMeasured{};
+
+    bool resolve(FrameQueries& frame);
+};
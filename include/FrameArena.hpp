@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// Allocateur linéaire (bump allocator) pour les allocations transitoires d'une frame.
+// Réinitialisé en début de frame ; les désallocations individuelles sont ignorées.
+// Compatible std::pmr : std::pmr::vector<T> v(&frameArena);
+class FrameArena : public std::pmr::memory_resource {
+public:
+    explicit FrameArena(std::size_t capacity = 256 * 1024);
+    ~FrameArena() override = default;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Libère tout le contenu de la frame précédente.
+    // Si la frame a débordé, le buffer est agrandi pour les frames suivantes.
+    void reset();
+
+    // Statistiques
+    std::size_t getUsed() const { return offset; }
+    std::size_t getCapacity() const { return capacity; }
+    std::size_t getHighWater() const { return highWater; }
+    std::size_t getOverflowBytes() const { return overflowBytes; }
+
+private:
+    std::unique_ptr<std::byte[]> buffer;
+    std::size_t capacity;
+    std::size_t offset;
+    std::size_t highWater;
+    std::size_t overflowBytes;
+
+    // Débordement : servi par le tas jusqu'au prochain reset()
+    std::pmr::monotonic_buffer_resource overflow;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// Frustum de vue extrait d'une matrice view-projection (méthode Gribb/Hartmann)
+class Frustum {
+public:
+    Frustum();
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    // Test sphère englobante / frustum (conservatif)
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+
+private:
+    glm::vec4 planes[6];  // left, right, bottom, top, near, far (normales vers l'intérieur)
+};
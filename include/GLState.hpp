@@ -0,0 +1,48 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+
+// Cache de l'état OpenGL du thread de rendu : les appels qui ne changent rien ne sont pas
+// transmis au driver. Tout le code du renderer doit passer par ces fonctions pour les états
+// suivis ; après du code externe qui modifie l'état (ImGui...), appeler invalidate().
+class GLState {
+public:
+    static const int MAX_TEXTURE_UNITS = 16;
+
+    // Appels transmis au driver / évités depuis le dernier resetCounters()
+    struct Counters {
+        std::size_t issued = 0;
+        std::size_t filtered = 0;
+    };
+
+    static void useProgram(GLuint program);
+    static void bindVertexArray(GLuint vao);
+    static void bindTexture(GLuint unit, GLenum target, GLuint texture);
+    static void bindSampler(GLuint unit, GLuint sampler);   // 0 = paramètres de la texture
+    // Unité active, pour les appels qui agissent sur la texture liée (glGenerateMipmap...)
+    static void setActiveTexture(GLuint unit);
+    static void bindFramebuffer(GLuint framebuffer);    // GL_FRAMEBUFFER (lecture et écriture)
+    static void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    static void setScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    static void setEnabled(GLenum capability, bool enabled);  // GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND, GL_SCISSOR_TEST
+    static void setDepthFunc(GLenum func);
+    static void setDepthMask(bool writeEnabled);
+    static void setColorMask(bool writeEnabled);        // Les quatre composantes ensemble
+    static void setCullFace(GLenum face);
+    static void setPolygonMode(GLenum mode);            // GL_FRONT_AND_BACK
+
+    // Objets supprimés : l'identifiant peut être réutilisé par le driver
+    static void forgetProgram(GLuint program);
+    static void forgetVertexArray(GLuint vao);
+    static void forgetTexture(GLuint texture);
+    static void forgetSampler(GLuint sampler);
+    static void forgetFramebuffer(GLuint framebuffer);
+
+    // Tout l'état devient inconnu : les prochains appels sont tous transmis
+    static void invalidate();
+
+    static void resetCounters();
+    static const Counters& getCounters();
+};
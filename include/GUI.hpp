@@ -10,6 +10,13 @@ struct DirectionalLight;
 struct PointLight;
 struct SpotLight;
 #include "Light.hpp"
+#include "RenderStats.hpp"
+#include "GpuProfiler.hpp"
+#include "ShadowSettings.hpp"
+#include "ResourceManager.hpp"
+#include "WorldStreamer.hpp"
+#include "Terrain.hpp"
+#include "StressScene.hpp"
 
 class GUI {
 public:
@@ -26,7 +33,30 @@ public:
                         LightManager* lightManager,
                         glm::vec3* cameraPos,
                         bool* wireframe = nullptr,
-                        bool* showLightSources = nullptr);
+                        bool* showLightSources = nullptr,
+                        bool* depthPrepass = nullptr);
+
+    // Fenêtre de statistiques de performance
+    void showStatsWindow(const RenderStats& stats);
+
+    // Profileur GPU : timeline des scopes de la dernière frame résolue + graphe glissant
+    void showGpuProfilerWindow(const GpuProfiler& profiler);
+
+    // Réglages des cascades d'ombre et du filtrage (avec le coût GPU mesuré de chaque filtre)
+    void showShadowWindow(ShadowSettings& settings, const RenderStats& stats);
+
+    // Mémoire GPU par catégorie et budget de streaming. Retourne true si le budget a changé.
+    bool showMemoryWindow(const ResourceManager::Stats& stats, int* budgetMegabytes);
+
+    // Scène de test de montée en charge : nombre d'objets et de lumières, graine, animation.
+    // Retourne true s'il faut régénérer la scène (ou rétablir la scène par défaut).
+    bool showStressSceneWindow(StressSceneSettings& settings, std::size_t objectCount);
+
+    // Terrain : distance de subdivision du quadtree, budgets, chunks dessinés et résidents
+    void showTerrainWindow(Terrain::Settings& settings, const Terrain::Stats& stats);
+
+    // Streaming du monde : rayons de chargement, budget de transfert, latence et mémoire résidente
+    void showStreamingWindow(WorldStreamer::Settings& settings, const WorldStreamer::Stats& stats);
 
     // Utility
     bool wantCaptureMouse() const;
@@ -35,6 +65,13 @@ public:
 private:
     bool m_showDemoWindow;
     bool m_showMainWindow;
+    bool m_showStatsWindow;
+    bool m_showGpuProfilerWindow;
+    bool m_showShadowWindow;
+    bool m_showMemoryWindow;
+    bool m_showStreamingWindow;
+    bool m_showTerrainWindow;
+    bool m_showStressSceneWindow;
 
     // Helper functions for light UI
     void showDirectionalLightControls(DirectionalLight* light, int index);
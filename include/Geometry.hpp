@@ -1,6 +1,9 @@
 #pragma once
 
 #include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <string>
 #include <vector>
 
 // Structure pour stocker les données d'un vertex
@@ -10,14 +13,28 @@ struct Vertex {
     float u, v;             // Coordonnées de texture
 };
 
+// Sphère englobante (centre de la boîte englobante, rayon au sommet le plus éloigné).
+// Partagée par Geometry et le cache de maillages compilés : bornes identiques en mémoire et en cache.
+void computeBoundingSphere(const Vertex* vertices, std::size_t vertexCount, glm::vec3& center, float& radius);
+
 // Classe pour générer et gérer des géométries
 class Geometry {
 private:
     GLuint VAO, VBO, EBO;
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
+    GLsizei drawVertexCount, drawIndexCount;
+    std::size_t gpuBytes;   // Vertex + index buffers (comptés par ResourceManager)
     bool initialized;
 
+    // Sphère englobante en espace objet (calculée dans setupMesh)
+    glm::vec3 boundsCenter;
+    float boundsRadius;
+
+    void computeBounds();
+    void uploadBuffers(const Vertex* vertexData, std::size_t vertexCount, const unsigned int* indexData,
+                       std::size_t indexCount, GLuint sharedIndexBuffer = 0);
+
 public:
     Geometry();
     ~Geometry();
@@ -33,9 +50,23 @@ public:
     void generateCylinder(float radius = 0.1f, float height = 2.0f, int sectorCount = 8);
     void generateWireCylinder(float radius = 0.1f, float height = 2.0f, int sectorCount = 8);
 
+    // Maillage importé (OBJ, glTF) via le cache de maillages compilés. Retourne false si
+    // la source est illisible.
+    bool loadMesh(const std::string& path);
+
     // Initialisation des buffers OpenGL
     void setupMesh();
 
+    // Buffers remplis directement depuis des données externes (entrée compilée lue ou projetée) :
+    // la géométrie n'en garde pas de copie CPU
+    void setupMesh(const Vertex* vertexData, std::size_t vertexCount, const unsigned int* indexData,
+                   std::size_t indexCount, const glm::vec3& center, float radius);
+
+    // Sommets propres, indices lus dans un buffer partagé entre géométries de même topologie
+    // (chunks de terrain) : le buffer est lié au VAO mais reste à son propriétaire
+    void setupMesh(const Vertex* vertexData, std::size_t vertexCount, GLuint sharedIndexBuffer,
+                   std::size_t indexCount, const glm::vec3& center, float radius);
+
     // Rendu
     void render() const;
     void renderWireframe() const;  // Nouveau: rendu en lignes pour wireframe
@@ -43,8 +74,11 @@ public:
     // Nettoyage
     void cleanup();
 
-    // Accesseurs
+    // Accesseurs (vides pour un maillage chargé avec loadMesh)
     const std::vector<Vertex>& getVertices() const { return vertices; }
     const std::vector<unsigned int>& getIndices() const { return indices; }
     bool isInitialized() const { return initialized; }
+    std::size_t getGpuBytes() const { return gpuBytes; }
+    const glm::vec3& getBoundsCenter() const { return boundsCenter; }
+    float getBoundsRadius() const { return boundsRadius; }
 };
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <vector>
+
+// Profileur GPU à base de timestamps (glQueryCounter / GL_TIMESTAMP).
+// Les scopes peuvent être imbriqués ; les résultats sont relus FRAME_LATENCY
+// frames plus tard pour ne jamais bloquer le CPU sur le GPU.
+class GpuProfiler {
+public:
+    static const int FRAME_LATENCY = 4;     // Frames en vol avant relecture
+    static const int MAX_SCOPES = 64;       // Scopes par frame
+    static const int HISTORY_SIZE = 240;    // Frames conservées pour le graphe
+
+    // Résultat d'un scope (temps relatifs au début de la frame, en ms)
+    struct ScopeResult {
+        const char* name;
+        int depth;
+        double startMs;
+        double durationMs;
+    };
+
+    // Scope RAII
+    class Scope {
+    public:
+        Scope(GpuProfiler& profiler, const char* name) : profiler(profiler) { profiler.beginScope(name); }
+        ~Scope() { profiler.endScope(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        GpuProfiler& profiler;
+    };
+
+    GpuProfiler();
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // Relit la plus ancienne frame en attente si ses résultats sont disponibles (sans bloquer).
+    // Retourne true si une frame a été résolue ; à appeler en boucle avant beginFrame().
+    bool collect();
+
+    void beginFrame(int frameIndex);
+    void endFrame();
+
+    void beginScope(const char* name);
+    void endScope();
+
+    // Dernière frame résolue
+    int getResolvedFrameIndex() const { return resolvedFrameIndex; }
+    double getResolvedFrameMs() const { return resolvedFrameMs; }
+    const std::vector<ScopeResult>& getResolvedScopes() const { return resolvedScopes; }
+
+    // Historique des temps de frame GPU (buffer circulaire)
+    const std::array<float, HISTORY_SIZE>& getHistory() const { return history; }
+    int getHistoryOffset() const { return historyOffset; }
+
+    bool isSupported() const { return supported; }
+
+private:
+    struct ScopeQueries {
+        const char* name;
+        int depth;
+    };
+
+    struct FrameQueries {
+        // Timestamps : [0] début de frame, [1] fin de frame, puis paires début/fin par scope
+        std::array<GLuint, 2 + 2 * MAX_SCOPES> queries{};
+        std::array<ScopeQueries, MAX_SCOPES> scopes{};
+        int scopeCount = 0;
+        int frameIndex = -1;
+        bool pending = false;
+    };
+
+    std::array<FrameQueries, FRAME_LATENCY> frames;
+    FrameQueries* current;
+
+    // Pile des scopes ouverts (indices dans current->scopes)
+    std::array<int, MAX_SCOPES> scopeStack{};
+    int stackDepth;
+
+    int resolvedFrameIndex;
+    double resolvedFrameMs;
+    std::vector<ScopeResult> resolvedScopes;
+
+    std::array<float, HISTORY_SIZE> history{};
+    int historyOffset;
+
+    bool supported;
+
+    bool resolve(FrameQueries& frame);
+};
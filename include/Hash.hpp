@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Hash FNV-1a 64 bits (clés de cache : shaders, textures, assets)
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3ull;
+
+inline std::uint64_t hashBytes(const void* data, std::size_t size, std::uint64_t seed = FNV_OFFSET_BASIS) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = seed;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+inline std::uint64_t hashString(std::string_view text, std::uint64_t seed = FNV_OFFSET_BASIS) {
+    // La longueur est mélangée pour que ("ab","c") et ("a","bc") diffèrent
+    std::uint64_t length = text.size();
+    return hashBytes(text.data(), text.size(), hashBytes(&length, sizeof(length), seed));
+}
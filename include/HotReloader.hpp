@@ -0,0 +1,51 @@
+#pragma once
+
+#include "FileWatcher.hpp"
+#include "Shader.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ShaderCompiler;
+class ShaderVariants;
+
+// Rechargement à chaud des assets modifiés sur disque.
+// Seuls les programmes qui lisent le fichier modifié (#include compris) sont recompilés,
+// en arrière-plan via le ShaderCompiler ; le nouveau programme remplace l'ancien entre deux
+// frames une fois prêt. En cas d'erreur, l'ancien programme reste en place.
+class HotReloader {
+public:
+    explicit HotReloader(ShaderCompiler* compiler);
+
+    bool watchDirectory(const std::string& directory);
+
+    void addShader(Shader* shader);
+    void addShaderVariants(ShaderVariants* variants);
+
+    // Autres assets (textures, meshes...) : callback appelé sur le thread principal
+    void addFile(const std::string& path, std::function<void()> onChanged);
+
+    // Thread principal, entre deux frames
+    void update();
+
+    int getReloadCount() const { return reloadCount; }
+
+private:
+    struct PendingReload {
+        Shader* target;
+        std::unique_ptr<Shader> replacement;
+    };
+
+    void scheduleShaderReload(Shader& shader, const std::string& changedPath);
+    bool isPending(const Shader& shader) const;
+
+    FileWatcher watcher;
+    ShaderCompiler* compiler;
+    std::vector<Shader*> shaders;
+    std::vector<ShaderVariants*> variantSets;
+    std::unordered_map<std::string, std::vector<std::function<void()>>> fileListeners;  // Chemin canonique
+    std::vector<PendingReload> pending;
+    int reloadCount;
+};
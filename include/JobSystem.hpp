@@ -0,0 +1,56 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+
+// Pool de threads de travail pour les chargements (lecture, décodage, import) et file des
+// travaux à exécuter sur le thread GL. Les coroutines de chargement (Task) passent de l'un
+// à l'autre avec co_await JobSystem::switchToWorker() / switchToMainThread().
+//
+// Le thread GL vide sa file une fois par frame (runMainThreadJobs), avec un budget de temps :
+// les uploads d'une scène qui arrive en flux sont étalés sur plusieurs frames.
+//
+// Sans initialize() (outils), submit() exécute le travail immédiatement sur le thread appelant.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    // threadCount = 0 : un thread par cœur, moins le thread GL (au moins un).
+    // Le thread appelant devient le thread GL.
+    static void initialize(int threadCount = 0);
+
+    // Termine les travaux en cours sur les threads ; la file du thread GL est abandonnée
+    static void shutdown();
+
+    static void submit(Job job);
+    static void submitToMainThread(Job job);
+
+    // Thread GL : exécute les travaux en attente jusqu'à épuisement du budget (au moins un).
+    // budgetMs <= 0 : toute la file. Retourne le nombre de travaux exécutés.
+    static int runMainThreadJobs(double budgetMs = 0.0);
+
+    // Thread GL : exécute la file jusqu'à ce que 'done' soit vrai (chargements bloquants du
+    // mode headless et du benchmark)
+    static void waitOnMainThread(const std::function<bool()>& done);
+
+    static bool isMainThread();
+    static int getWorkerCount();
+    static int getPendingCount();       // Travaux en file (threads et thread GL)
+
+    // co_await : reprend la coroutine sur un thread de travail
+    struct WorkerAwaiter {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const { submit([handle] { handle.resume(); }); }
+        void await_resume() const noexcept {}
+    };
+
+    // co_await : reprend la coroutine sur le thread GL (immédiatement si elle y est déjà)
+    struct MainThreadAwaiter {
+        bool await_ready() const noexcept { return isMainThread(); }
+        void await_suspend(std::coroutine_handle<> handle) const { submitToMainThread([handle] { handle.resume(); }); }
+        void await_resume() const noexcept {}
+    };
+
+    static WorkerAwaiter switchToWorker() { return {}; }
+    static MainThreadAwaiter switchToMainThread() { return {}; }
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+// Format bloc LZ4 (séquences littéraux + copie), compatible avec LZ4_decompress_safe.
+// Compression gloutonne à table de hachage : rapide, ratio correct sur du texte (shaders).
+namespace LZ4 {
+    // Taille maximale d'un bloc compressé pour 'size' octets d'entrée
+    std::size_t compressBound(std::size_t size);
+
+    // Retourne la taille compressée ; 'output' doit contenir compressBound(size) octets
+    std::size_t compress(const unsigned char* input, std::size_t size, unsigned char* output);
+
+    // Retourne false si le bloc est invalide ou ne fait pas exactement 'outputSize' octets
+    bool decompress(const unsigned char* input, std::size_t inputSize, unsigned char* output, std::size_t outputSize);
+}
@@ -35,6 +35,9 @@ struct Light {
     // Méthode virtuelle pour envoyer les uniformes au shader
     virtual void sendToShader(Shader& shader, int index) const = 0;
 
+    // Distance au-delà de laquelle l'atténuation rend la contribution négligeable (< 1/256)
+    float getRange() const;
+
     // Destructeur virtuel
     virtual ~Light() {}
 };
@@ -59,10 +62,13 @@ struct DirectionalLight : public Light {
 struct PointLight : public Light {
     glm::vec3 position;     // Position de la lumière
 
+    // Ombre dans les PointShadowMaps, renseignée chaque frame par PointShadowMaps::update
+    glm::vec4 shadowParams; // x = première couche, y = far, w = 1 si ombrée
+
     PointLight(const glm::vec3& pos = glm::vec3(0.0f, 0.0f, 0.0f),
                const glm::vec3& col = glm::vec3(1.0f),
                float intens = 1.0f)
-            : Light(LightType::POINT, col, intens), position(pos) {}
+            : Light(LightType::POINT, col, intens), position(pos), shadowParams(0.0f) {}
 
     void sendToShader(Shader& shader, int index) const override;
     virtual ~PointLight() {}
@@ -75,6 +81,11 @@ struct SpotLight : public Light {
     float cutOff;           // Angle intérieur du cône (en degrés)
     float outerCutOff;      // Angle extérieur du cône (en degrés)
 
+    // Ombre dans la shadow atlas, renseignée chaque frame par ShadowAtlas::update
+    glm::mat4 shadowMatrix;
+    glm::vec4 shadowRect;   // Tuile en UV (x, y, largeur, hauteur) ; largeur 0 = pas d'ombre
+    glm::vec4 shadowParams; // x = taille d'un texel par unité de distance, y = near, z = far
+
     SpotLight(const glm::vec3& pos = glm::vec3(0.0f, 0.0f, 0.0f),
               const glm::vec3& dir = glm::vec3(0.0f, -1.0f, 0.0f),
               float cutoff = 12.5f,
@@ -82,7 +93,8 @@ struct SpotLight : public Light {
               const glm::vec3& col = glm::vec3(1.0f),
               float intens = 1.0f)
             : Light(LightType::SPOT, col, intens), position(pos),
-              direction(glm::normalize(dir)), cutOff(cutoff), outerCutOff(outerCutoff) {}
+              direction(glm::normalize(dir)), cutOff(cutoff), outerCutOff(outerCutoff),
+              shadowMatrix(1.0f), shadowRect(0.0f), shadowParams(0.0f) {}
 
     void sendToShader(Shader& shader, int index) const override;
     virtual ~SpotLight() {}
@@ -90,9 +102,18 @@ struct SpotLight : public Light {
 
 // Gestionnaire de lumières
 class LightManager {
+public:
+    static const int MAX_LIGHTS = 8;  // Nombre maximum de lumières supportées
+
+    // Nombre de lumières actives par type (clé de permutation du shader)
+    struct LightCounts {
+        int directional = 0;
+        int point = 0;
+        int spot = 0;
+    };
+
 private:
     std::vector<std::unique_ptr<Light>> lights;
-    static const int MAX_LIGHTS = 8;  // Nombre maximum de lumières supportées
 
 public:
     // Ajouter une lumière
@@ -100,9 +121,14 @@ public:
     void addPointLight(const PointLight& light);
     void addSpotLight(const SpotLight& light);
 
-    // Envoyer toutes les lumières au shader
+    // Envoyer les lumières actives au shader, triées par type
     void sendLightsToShader(Shader& shader) const;
 
+    LightCounts countEnabledLights() const;
+
+    // Première lumière directionnelle active : lights[0] dans le shader, projette l'ombre
+    const DirectionalLight* getShadowCaster() const;
+
     // Accès aux lumières pour l'UI
     std::vector<std::unique_ptr<Light>>& getLights() { return lights; }
     const std::vector<std::unique_ptr<Light>>& getLights() const { return lights; }
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include "MeshImporter.hpp"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Cache des maillages compilés : au premier chargement, la source (OBJ, glTF) est importée et
+// optimisée (MeshImporter) puis écrite au format binaire compilé ; les chargements suivants
+// lisent l'entrée en une seule lecture, ou la servent directement depuis l'archive d'assets
+// ("<source>.mesh"), et les sommets et indices vont tels quels dans les buffers de Geometry.
+//
+// Format d'une entrée : en-tête de 64 octets (clé, nombres de sommets et d'indices, sphère
+// englobante, offsets) puis les sommets (format Vertex) et les indices 32 bits, chacun aligné
+// sur 64 octets. Clé : chemin, taille et date de la source, version de l'importeur.
+//
+// load() peut être appelée depuis des threads de chargement (aucun appel GL).
+class MeshCache {
+public:
+    // Maillage prêt pour Geometry::setupMesh : vues sur l'entrée lue ou projetée
+    struct CompiledMesh {
+        const Vertex* vertices = nullptr;
+        std::size_t vertexCount = 0;
+        const unsigned int* indices = nullptr;
+        std::size_t indexCount = 0;
+        glm::vec3 boundsCenter = glm::vec3(0.0f);
+        float boundsRadius = 0.0f;
+        std::vector<unsigned char> storage;     // Entrée lue depuis le disque (vide si projetée)
+
+        CompiledMesh() = default;
+        CompiledMesh(CompiledMesh&&) = default;
+        CompiledMesh& operator=(CompiledMesh&&) = default;
+        // Les vues pointent dans 'storage' : pas de copie
+        CompiledMesh(const CompiledMesh&) = delete;
+        CompiledMesh& operator=(const CompiledMesh&) = delete;
+
+        bool isValid() const { return vertexCount > 0; }
+        std::size_t getByteSize() const { return vertexCount * sizeof(Vertex) + indexCount * sizeof(unsigned int); }
+    };
+
+    struct Stats {
+        int hits = 0;
+        int packHits = 0;           // Dont entrées servies par l'archive d'assets
+        int misses = 0;             // Maillages importés
+        double hitMs = 0.0;
+        double missMs = 0.0;
+        std::size_t bytes = 0;
+    };
+
+    static void setDirectory(const std::string& directory);
+    static const std::string& getDirectory();
+
+    // Désactivé : maillages importés à chaque chargement
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Maillage compilé de 'sourcePath'. Retourne false si la source est illisible ou invalide.
+    // 'importStats' (optionnel) reçoit les mesures de l'import si la source a été importée.
+    static bool load(const std::string& sourcePath, CompiledMesh& mesh, MeshImporter::Stats* importStats = nullptr);
+
+    // Entrée au format compilé, telle que stockée dans une archive d'assets (outil asset_packer)
+    static void serialize(const MeshImporter::MeshData& mesh, std::string& bytes);
+    static const char* getPackSuffix() { return ".mesh"; }
+
+    static Stats getStats();
+    static void printReport();
+
+private:
+    static std::string getEntryPath(std::uint64_t key);
+};
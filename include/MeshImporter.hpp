@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Geometry.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Import des maillages sources (OBJ, glTF 2.0 .gltf/.glb) vers le format de Geometry :
+//  - OBJ : fichier découpé en blocs de lignes analysés en parallèle (indices relatifs résolus
+//    après coup), polygones triangulés en éventail ;
+//  - glTF : une tâche par primitive (triangles), transformations des nœuds de la scène appliquées ;
+//  - sommets soudés (table de hachage sur position / normale / uv), normales lissées calculées
+//    quand la source n'en a pas ;
+//  - indices réordonnés pour le cache de sommets (Tipsify), puis sommets réordonnés dans leur
+//    ordre de première utilisation (localité des lectures).
+//
+// Pas d'appel GL : utilisable depuis l'outil asset_packer et les threads de chargement.
+class MeshImporter {
+public:
+    struct MeshData {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    struct Stats {
+        int threads = 0;
+        std::size_t sourceBytes = 0;
+        std::size_t corners = 0;        // Sommets avant soudure (3 par triangle)
+        double readMs = 0.0;
+        double parseMs = 0.0;
+        double weldMs = 0.0;            // Soudure + normales
+        double optimizeMs = 0.0;
+        float acmrBefore = 0.0f;        // Défauts de cache moyens par triangle (cache FIFO de 16)
+        float acmrAfter = 0.0f;
+    };
+
+    // .obj, .gltf ou .glb
+    static bool isSupported(const std::string& path);
+
+    // Importe, soude et optimise 'path'. 'threadCount' = 0 : un thread par cœur.
+    // Retourne false (message sur std::cerr) si le fichier est illisible ou ne contient aucun triangle.
+    static bool importFile(const std::string& path, MeshData& mesh, Stats* stats = nullptr, int threadCount = 0);
+
+    // Ordre des triangles favorable au cache post-transformation (Sander et al., Tipsify)
+    static void optimizeVertexCache(std::vector<unsigned int>& indices, std::size_t vertexCount, int cacheSize = 16);
+
+    // Sommets renumérotés dans l'ordre de première utilisation ; les sommets inutilisés sont retirés
+    static void optimizeVertexFetch(MeshData& mesh);
+
+    static float computeACMR(const std::vector<unsigned int>& indices, std::size_t vertexCount, int cacheSize = 16);
+};
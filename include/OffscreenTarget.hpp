@@ -0,0 +1,35 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <string>
+
+// Cible de rendu hors écran (FBO couleur RGBA8 + profondeur)
+// Utilisée par le mode headless à la place du framebuffer par défaut
+class OffscreenTarget {
+public:
+    OffscreenTarget(int width, int height);
+    ~OffscreenTarget();
+
+    OffscreenTarget(const OffscreenTarget&) = delete;
+    OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+    void bind() const;
+    bool isComplete() const { return complete; }
+
+    GLuint getFramebuffer() const { return framebuffer; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    std::int64_t getByteSize() const { return static_cast<std::int64_t>(width) * height * 8; }
+
+    // Relit le buffer couleur et l'écrit au format PPM binaire (P6)
+    bool saveToPPM(const std::string& path) const;
+
+private:
+    GLuint framebuffer;
+    GLuint colorBuffer;
+    GLuint depthBuffer;
+    int width;
+    int height;
+    bool complete;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Frustum.hpp"
+#include "Light.hpp"
+#include "RenderList.hpp"
+#include "Shader.hpp"
+#include "ShadowSettings.hpp"
+
+// Ombres omnidirectionnelles des lumières ponctuelles. Chaque lumière ombrée occupe six couches
+// consécutives d'une texture de profondeur 2D array (une par face de cube, distance à la lumière
+// / far), lue par un seul sampler2DArray : le shader d'éclairage choisit la face lui-même.
+//
+// Deux chemins de rendu, comparables dans le profileur GPU :
+//  - une passe par lumière : le geometry shader duplique chaque triangle vers les faces de son
+//    masque (gl_Layer), le masque étant calculé par objet sur le CPU (culling par face) ;
+//  - six passes par lumière, une par face, sans geometry shader.
+class PointShadowMaps {
+public:
+    static constexpr int MAX_LIGHTS = 4;
+
+    struct ShadowedLight {
+        PointLight* light;
+        int firstLayer;
+        float farPlane;
+        glm::mat4 faceMatrices[6];
+        Frustum faceFrustums[6];
+    };
+
+    explicit PointShadowMaps(int resolution);
+    ~PointShadowMaps();
+
+    PointShadowMaps(const PointShadowMaps&) = delete;
+    PointShadowMaps& operator=(const PointShadowMaps&) = delete;
+
+    // Choisit les lumières ombrées (actives, zone d'influence visible, les plus importantes)
+    // et renseigne leurs données d'ombre
+    void update(LightManager& lightManager, const glm::vec3& cameraPosition, const glm::mat4& viewProjection,
+                float tanHalfFov, const ShadowSettings& settings);
+
+    // Faces (bits 0 à 5) dont le frustum contient la sphère englobante de l'objet
+    int computeFaceMask(const ShadowedLight& shadowed, const DrawItem& item) const;
+
+    // Rendu d'une passe unique : lie le framebuffer en couches, efface toutes les faces
+    void beginSinglePass() const;
+    void applySinglePassUniforms(Shader& shader, const ShadowedLight& shadowed) const;
+
+    // Rendu face par face : lie et efface la couche de la face
+    void beginFace(const ShadowedLight& shadowed, int face) const;
+
+    const std::vector<ShadowedLight>& getLights() const { return lights; }
+    int getResolution() const { return resolution; }
+    GLuint getTexture() const { return depthTexture; }
+    std::int64_t getTextureBytes() const {
+        return static_cast<std::int64_t>(resolution) * resolution * sizeof(float) * MAX_LIGHTS * 6;
+    }
+
+private:
+    int resolution;
+    GLuint depthTexture;
+    GLuint layeredFramebuffer;
+    GLuint faceFramebuffers[MAX_LIGHTS * 6];
+
+    std::vector<ShadowedLight> lights;
+    std::vector<std::pair<float, PointLight*>> candidates;
+};
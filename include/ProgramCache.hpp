@@ -0,0 +1,48 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <initializer_list>
+
+// Cache disque des programmes liés (glGetProgramBinary / glProgramBinary).
+// La clé combine le source des shaders, les defines et le driver (vendor/renderer/version) :
+// un changement de l'un d'eux produit une nouvelle entrée, et une entrée refusée par le
+// driver est supprimée puis reconstruite.
+class ProgramCache {
+public:
+    struct Stats {
+        int hits = 0;
+        int misses = 0;
+        double hitMs = 0.0;     // Temps total des programmes chargés depuis le cache
+        double missMs = 0.0;    // Temps total des programmes compilés
+    };
+
+    static void setDirectory(const std::string& directory);
+    static const std::string& getDirectory();
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Clé d'un programme à partir de ses sources (déjà préprocessées)
+    static std::uint64_t computeKey(std::initializer_list<std::string_view> sources);
+
+    // Charge le binaire dans 'program'. Retourne false si absent ou invalide.
+    static bool load(GLuint program, std::uint64_t key);
+
+    // À appeler avant glLinkProgram pour que le binaire soit récupérable
+    static void prepare(GLuint program);
+
+    // Enregistre le binaire d'un programme lié avec succès
+    static void store(GLuint program, std::uint64_t key);
+
+    // Statistiques de démarrage (cache chaud vs froid)
+    static void recordBuild(bool cacheHit, double milliseconds);
+    static Stats getStats();
+    static void printReport();
+
+private:
+    static bool isSupported();
+    static std::string getEntryPath(std::uint64_t key);
+};
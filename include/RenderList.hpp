@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "Geometry.hpp"
+#include "Material.hpp"
+#include "Frustum.hpp"
+#include "ResourceManager.hpp"
+
+// Objet persistant de la scène (construit une fois dans initializeScene)
+struct SceneObject {
+    GeometryHandle geometry;        // Géométrie possédée par ResourceManager
+    Material material;
+    glm::vec3 position;
+    glm::vec3 scale;
+    glm::vec3 rotationAxis;
+    float rotationSpeed;    // Radians par seconde (0 = objet statique)
+
+    SceneObject(GeometryHandle geom, const Material& mat,
+                const glm::vec3& pos = glm::vec3(0.0f),
+                const glm::vec3& scl = glm::vec3(1.0f),
+                const glm::vec3& axis = glm::vec3(0.0f, 1.0f, 0.0f),
+                float speed = 0.0f)
+            : geometry(geom), material(mat), position(pos), scale(scl),
+              rotationAxis(axis), rotationSpeed(speed) {}
+
+    bool isStatic() const { return rotationSpeed == 0.0f; }
+    glm::mat4 getModelMatrix(float time) const;
+};
+
+// Élément de rendu transitoire, reconstruit à chaque frame dans l'arène
+struct DrawItem {
+    const Geometry* geometry;
+    GeometryHandle handle;
+    const Material* material;
+    glm::mat4 model;
+    glm::vec3 center;       // Sphère englobante en espace monde
+    float radius;
+    bool isStatic;
+};
+
+// Conteneurs de frame (à construire avec l'arène de frame comme ressource)
+using RenderList = std::pmr::vector<DrawItem>;
+using CullResult = std::pmr::vector<const DrawItem*>;
+using FrameString = std::pmr::string;
+
+// Construit la liste de rendu de la frame à partir des objets de la scène
+// (objets dont la géométrie est résidente)
+void buildRenderList(const std::vector<SceneObject>& objects, float time, RenderList& out);
+
+// Ajoute les éléments d'un autre ensemble d'objets (cellules du monde en streaming)
+void appendRenderList(const std::vector<SceneObject>& objects, float time, RenderList& out);
+
+// Ne garde que les éléments dont la sphère englobante intersecte le frustum
+void cullRenderList(const RenderList& items, const Frustum& frustum, CullResult& out);
+
+// Trie les éléments de l'avant vers l'arrière (centre de la sphère englobante) : les
+// fragments masqués échouent au test de profondeur avant le fragment shader (early-Z)
+void sortFrontToBack(CullResult& items, const glm::vec3& viewPosition);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ShadowSettings.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Statistiques de la dernière frame, affichées dans la fenêtre "Performance"
+struct RenderStats {
+    // Temps
+    double cpuFrameMs = 0.0;
+    double gpuFrameMs = 0.0;            // Relu avec quelques frames de retard
+
+    // Mémoire
+    std::size_t heapAllocations = 0;    // Appels à operator new pendant la frame
+    std::size_t heapBytes = 0;          // Octets alloués sur le tas pendant la frame
+    std::size_t arenaUsed = 0;          // Octets consommés dans l'arène de frame
+    std::size_t arenaCapacity = 0;
+
+    // Scène
+    std::size_t objectsTotal = 0;
+    std::size_t objectsVisible = 0;     // Après frustum culling
+    std::size_t shadowCasters = 0;      // Objets dessinés dans les shadow maps
+    int shadowStaticRefreshes = 0;      // Couches statiques redessinées
+    int shadowCascadesReused = 0;       // Cascades reprises de la frame précédente
+    std::size_t shadowAtlasTiles = 0;   // Spots avec une tuile dans la shadow atlas
+    float shadowAtlasUsage = 0.0f;      // Fraction de l'atlas attribuée
+    std::size_t pointShadowLights = 0;
+    std::size_t pointShadowFaceDraws = 0;   // Couples (objet, face de cube) dessinés
+    // GPU des objets éclairés + préfiltrage, moyenne glissante par ShadowFilter (0 = pas mesuré)
+    double shadowFilterGpuMs[static_cast<int>(ShadowFilter::COUNT)] = {};
+
+    // Overdraw : fragments ayant passé le test de profondeur (relus avec retard)
+    bool depthPrepass = false;          // Pré-passe active dans la frame mesurée
+    std::uint64_t prepassFragments = 0; // Écrits dans le depth buffer par la pré-passe
+    std::uint64_t litFragments = 0;     // Éclairés par la passe principale
+    std::size_t screenPixels = 0;
+    // GPU pré-passe + objets éclairés, moyenne glissante sans [0] et avec [1] pré-passe (0 = pas mesuré)
+    double depthPrepassGpuMs[2] = {};
+
+    // Shaders
+    std::size_t shaderVariantsReady = 0;
+    std::size_t shaderVariantsTotal = 0;
+    int shaderCompilesPending = 0;      // Compilations en arrière-plan
+    int asyncLoadsPending = 0;          // Chargements asynchrones (AsyncLoader) en cours
+
+    // Cache d'état GL (passes de la scène, hors GUI)
+    std::size_t glCallsIssued = 0;
+    std::size_t glCallsFiltered = 0;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class Geometry;
+class Frustum;
+
+// Poignée générationnelle : indice d'emplacement + génération. Une poignée libérée devient
+// périmée (la génération de l'emplacement a changé) au lieu de pointer sur une autre
+// ressource. Simple valeur copiable : pas de compteur de références.
+template <typename T>
+struct ResourceHandle {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;   // 0 : poignée nulle
+
+    bool isValid() const { return generation != 0; }
+    bool operator==(const ResourceHandle& other) const = default;
+};
+
+using GeometryHandle = ResourceHandle<Geometry>;
+
+enum class ResourceCategory {
+    GEOMETRY,       // Vertex et index buffers
+    TEXTURE,        // Textures chargées (skybox, AsyncLoader)
+    SHADOW_MAP,     // Cascades, atlas des spots, cubes des lumières ponctuelles
+    RENDER_TARGET,  // Framebuffers hors écran
+    COUNT
+};
+
+const char* getResourceCategoryName(ResourceCategory category);
+
+// Propriétaire central des ressources GPU de la scène et comptabilité de la mémoire vidéo.
+//
+// - Géométries : possédées par le gestionnaire, désignées par des GeometryHandle. Celles qui
+//   ont une source (modèles importés) sont "streamables" : au-delà du budget, les moins
+//   récemment visibles perdent leurs buffers GL (LRU) et sont rechargées en arrière-plan
+//   (AsyncLoader) quand leur dernière position connue revient dans le champ de la caméra.
+// - Mémoire : chaque buffer et texture GL est compté par catégorie (trackMemory) par la
+//   classe qui l'alloue, y compris hors des poignées (shadow maps, cibles hors écran).
+//
+// Thread GL uniquement.
+class ResourceManager {
+public:
+    struct CategoryStats {
+        std::size_t bytes = 0;
+        int count = 0;              // Allocations vivantes
+    };
+
+    struct Stats {
+        CategoryStats categories[static_cast<int>(ResourceCategory::COUNT)];
+        std::size_t totalBytes = 0;
+        std::size_t budgetBytes = 0;            // 0 : illimité
+        int geometries = 0;                     // Poignées vivantes
+        int streamable = 0;
+        int resident = 0;                       // Dont streamables avec leurs buffers
+        int loading = 0;
+        int evictions = 0;                      // Cumuls
+        int reloads = 0;
+    };
+
+    // Prend possession de 'geometry'. 'sourcePath' non vide : géométrie streamable, rechargée
+    // depuis cette source (cache de maillages) après une éviction.
+    static GeometryHandle addGeometry(std::unique_ptr<Geometry> geometry, const std::string& name,
+                                      const std::string& sourcePath = std::string());
+
+    // nullptr si la poignée est périmée. Une géométrie évincée reste accessible (sphère
+    // englobante) mais n'est pas initialisée : isInitialized() == false.
+    static Geometry* getGeometry(GeometryHandle handle);
+
+    static void release(GeometryHandle handle);
+
+    // Source d'une géométrie streamable modifiée sur disque (rechargement à chaud) : recharge
+    // en arrière-plan, la version courante reste dessinée jusqu'au remplacement
+    static void reloadSource(GeometryHandle handle);
+
+    // Géométrie dessinée cette frame, à cette position (sphère englobante en espace monde)
+    static void markVisible(GeometryHandle handle, const glm::vec3& center, float radius);
+
+    // Une fois par frame, après markVisible : recharge les géométries évincées revenues dans
+    // le champ, puis évince les moins récemment visibles tant que le budget est dépassé
+    static void update(const Frustum& viewFrustum);
+
+    // bytes > 0 : allocation, bytes < 0 : libération
+    static void trackMemory(ResourceCategory category, std::int64_t bytes);
+
+    static void setBudget(std::size_t bytes);
+    static std::size_t getBudget();
+
+    static Stats getStats();
+    static void printReport();
+
+    // Détruit toutes les géométries (avant la destruction du contexte GL)
+    static void clear();
+};
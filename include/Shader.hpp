@@ -2,17 +2,97 @@
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
+
+// Defines injectés après #version (nom, valeur) : sélection d'une permutation
+using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
 
 class Shader {
+public:
+    // État de construction du programme (compilation asynchrone possible)
+    enum class Status {
+        PENDING,    // Sources prêtes, compilation soumise ou en attente
+        READY,      // Programme lié, utilisable
+        FAILED      // Erreur de compilation ou d'édition de liens
+    };
+
+    // Tag : construire sans compiler, la compilation est confiée à un ShaderCompiler
+    struct Deferred {};
+
+private:
     GLuint programID;
+    GLuint vertexShaderID;
+    GLuint geometryShaderID;
+    GLuint fragmentShaderID;
+
+    // Origine du programme, pour le reconstruire (rechargement à chaud)
+    std::string vertexPath;
+    std::string geometryPath;           // Vide : pas d'étage géométrie
+    std::string fragmentPath;
+    ShaderDefines defines;
+    std::set<std::string> sourceFiles;  // Chemins canoniques lus, #include compris
+
+    // Sources préprocessées, gardées jusqu'à la fin de la compilation
+    std::string vertexCode;
+    std::string geometryCode;
+    std::string fragmentCode;
+
+    std::uint64_t cacheKey;
+    bool cacheHit;
+    std::chrono::steady_clock::time_point buildStart;
+    std::atomic<Status> status;
 
     // Utility function for checking shader compilation/linking errors
-    void checkCompileErrors(GLuint shader, std::string type);
+    bool checkCompileErrors(GLuint shader, std::string type);
+
+    // GLSL preprocessing: #include "file" (relative, included once) and defines
+    static bool readFile(const std::string& path, std::string& content);
+    static void expandIncludes(const std::string& path, std::set<std::string>& included, std::string& output);
+    static std::string preprocess(const std::string& path, const ShaderDefines& defines, std::set<std::string>& included);
 
 public:
     // Constructor reads and builds the shader
-    Shader(const std::string& vertexPath, const std::string& fragmentPath);
+    Shader(const std::string& vertexPath, const std::string& fragmentPath, const ShaderDefines& defines = {});
+
+    // Reads and preprocesses the sources only; the build is done by beginBuild()/finishBuild()
+    Shader(const std::string& vertexPath, const std::string& fragmentPath, const ShaderDefines& defines, Deferred);
+
+    // Same with a geometry stage between the vertex and fragment stages
+    Shader(const std::string& vertexPath, const std::string& geometryPath, const std::string& fragmentPath,
+           const ShaderDefines& defines = {});
+    Shader(const std::string& vertexPath, const std::string& geometryPath, const std::string& fragmentPath,
+           const ShaderDefines& defines, Deferred);
+
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    // Submit phase: loads the program binary from the cache, or submits compile and link
+    void beginBuild();
+
+    // Poll phase: true once the driver has finished (GL_KHR_parallel_shader_compile)
+    bool isBuildComplete() const;
+
+    // Checks errors, stores the binary in the cache and marks the shader READY or FAILED
+    void finishBuild();
+
+    // Hot reload: a new deferred shader built from the same files and defines
+    std::unique_ptr<Shader> createReloaded() const;
+
+    // True if the program was built from this file (canonical path)
+    bool dependsOn(const std::string& canonicalPath) const;
+
+    // Takes the program of 'other' (READY) and gives it the current one, released with 'other'
+    void swapProgram(Shader& other);
+
+    Status getStatus() const { return status.load(std::memory_order_acquire); }
+    bool isReady() const { return getStatus() == Status::READY; }
 
     // Destructor
     ~Shader();
@@ -21,18 +101,18 @@ public:
     void use();
 
     // Utility uniform functions
-    void setUniform(const std::string& name, bool value);
-    void setUniform(const std::string& name, int value);
-    void setUniform(const std::string& name, float value);
-    void setUniform(const std::string& name, const glm::vec2& value);
-    void setUniform(const std::string& name, float x, float y);
-    void setUniform(const std::string& name, const glm::vec3& value);
-    void setUniform(const std::string& name, float x, float y, float z);
-    void setUniform(const std::string& name, const glm::vec4& value);
-    void setUniform(const std::string& name, float x, float y, float z, float w);
-    void setUniform(const std::string& name, const glm::mat2& mat);
-    void setUniform(const std::string& name, const glm::mat3& mat);
-    void setUniform(const std::string& name, const glm::mat4& mat);
+    void setUniform(const char* name, bool value);
+    void setUniform(const char* name, int value);
+    void setUniform(const char* name, float value);
+    void setUniform(const char* name, const glm::vec2& value);
+    void setUniform(const char* name, float x, float y);
+    void setUniform(const char* name, const glm::vec3& value);
+    void setUniform(const char* name, float x, float y, float z);
+    void setUniform(const char* name, const glm::vec4& value);
+    void setUniform(const char* name, float x, float y, float z, float w);
+    void setUniform(const char* name, const glm::mat2& mat);
+    void setUniform(const char* name, const glm::mat3& mat);
+    void setUniform(const char* name, const glm::mat4& mat);
 
     // Get shader program ID
     GLuint getID() const;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Shader.hpp"
+
+// Compilation asynchrone des shaders, en deux phases : submit() puis poll() à chaque frame.
+// - PARALLEL_EXTENSION : GL_KHR_parallel_shader_compile, le driver compile en arrière-plan
+//   et poll() finalise les programmes terminés (GL_COMPLETION_STATUS_KHR)
+// - WORKER_THREAD : un thread dédié compile avec un contexte GL partagé (fenêtre invisible)
+// - SYNCHRONOUS : repli, un programme compilé par poll() pour étaler le coût sur les frames
+class ShaderCompiler {
+public:
+    enum class Mode {
+        PARALLEL_EXTENSION,
+        WORKER_THREAD,
+        SYNCHRONOUS
+    };
+
+    // mainWindow : contexte avec lequel le contexte du thread de compilation est partagé
+    explicit ShaderCompiler(GLFWwindow* mainWindow);
+    ~ShaderCompiler();
+
+    ShaderCompiler(const ShaderCompiler&) = delete;
+    ShaderCompiler& operator=(const ShaderCompiler&) = delete;
+
+    // Soumet un shader construit avec Shader::Deferred (il doit rester vivant jusqu'à la fin)
+    void submit(Shader* shader);
+
+    // Thread de rendu, une fois par frame : finalise les compilations terminées
+    void poll();
+
+    // Attend la fin de toutes les compilations soumises (warm-up au démarrage)
+    void waitIdle();
+
+    int getPendingCount() const { return pendingCount.load(std::memory_order_acquire); }
+    Mode getMode() const { return mode; }
+    static const char* getModeName(Mode mode);
+
+private:
+    void workerLoop();
+
+    Mode mode;
+    GLFWwindow* workerWindow;
+    std::thread worker;
+
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<Shader*> queue;          // WORKER_THREAD / SYNCHRONOUS : en attente de compilation
+    std::vector<Shader*> inFlight;      // PARALLEL_EXTENSION : soumis au driver
+    std::atomic<int> pendingCount;
+    bool stopping;
+};
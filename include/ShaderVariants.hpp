@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Shader.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ShaderCompiler;
+
+// Clé de permutation du shader d'éclairage, déduite de l'état de rendu
+struct ShaderVariantKey {
+    bool shadows = false;
+    int numDirLights = 0;
+    int numPointLights = 0;
+    int numSpotLights = 0;
+    int pcfTaps = 3;            // Largeur du noyau PCF (1, 3, 5...)
+    int shadowFilter = 0;       // ShadowFilter des cascades
+
+    // Clé compacte (4 bits par compteur) pour l'indexation du cache
+    std::uint32_t pack() const;
+
+    // Defines GLSL correspondants (LIGHT_PERMUTATION, SHADOWS, NUM_*_LIGHTS, PCF_TAPS, SHADOW_FILTER)
+    ShaderDefines toDefines() const;
+};
+
+// Variantes spécialisées d'un couple vertex/fragment, compilées à la demande puis gardées.
+// Avec un ShaderCompiler, les variantes sont compilées en arrière-plan et la variante
+// générique sert de repli tant qu'elles ne sont pas prêtes.
+class ShaderVariants {
+public:
+    ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath, ShaderCompiler* compiler = nullptr);
+
+    // Variante spécialisée si elle est prête, sinon la variante générique
+    // (la compilation de la spécialisée est soumise au premier appel)
+    Shader& get(const ShaderVariantKey& key);
+
+    // Variante générique (boucle dynamique sur les lumières), valable pour tout état
+    Shader& getGeneric();
+
+    // Soumet la variante générique et une liste de variantes sans attendre
+    void warmUp(const std::vector<ShaderVariantKey>& keys);
+
+    // Variante générique et toutes les variantes spécialisées (rechargement à chaud)
+    void forEachShader(const std::function<void(Shader&)>& visit);
+
+    size_t getVariantCount() const { return variants.size(); }
+    size_t getReadyCount() const;
+
+private:
+    Shader& request(const ShaderVariantKey& key);
+
+    std::string vertexPath;
+    std::string fragmentPath;
+    ShaderCompiler* compiler;
+    std::unordered_map<std::uint32_t, std::unique_ptr<Shader>> variants;
+    std::unique_ptr<Shader> generic;
+};
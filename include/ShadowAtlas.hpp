@@ -0,0 +1,60 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Light.hpp"
+#include "ShadowSettings.hpp"
+
+// Shadow atlas des spots : une seule texture de profondeur découpée en tuiles carrées.
+// Les tuiles sont redistribuées chaque frame par un allocateur buddy 2D (blocs de taille
+// puissance de deux, découpés en quatre). Les spots sont servis par importance décroissante
+// (intensité x taille projetée de leur zone d'influence) ; la taille de tuile suit l'importance
+// et descend d'un cran tant que la place manque. Toutes les tuiles sont rendues dans une seule
+// passe (viewport + scissor par tuile).
+class ShadowAtlas {
+public:
+    static constexpr int MIN_TILE_SIZE = 128;
+
+    struct Tile {
+        SpotLight* light;
+        glm::ivec4 rect;        // x, y, largeur, hauteur en texels
+        glm::mat4 matrix;
+        float importance;
+    };
+
+    explicit ShadowAtlas(int size);    // Puissance de deux
+    ~ShadowAtlas();
+
+    ShadowAtlas(const ShadowAtlas&) = delete;
+    ShadowAtlas& operator=(const ShadowAtlas&) = delete;
+
+    // Attribue les tuiles aux spots actifs visibles et renseigne leurs données d'ombre
+    void update(LightManager& lightManager, const glm::vec3& cameraPosition, const glm::mat4& viewProjection,
+                float tanHalfFov, const ShadowSettings& settings);
+
+    // Passe d'ombre : begin() lie l'atlas et l'efface, beginTile() restreint le rendu à une tuile
+    void begin() const;
+    void beginTile(int tile) const;
+    void end() const;
+
+    const std::vector<Tile>& getTiles() const { return tiles; }
+    int getSize() const { return size; }
+    GLuint getTexture() const { return depthTexture; }
+    std::int64_t getTextureBytes() const { return static_cast<std::int64_t>(size) * size * sizeof(float); }
+    float getUsage() const;             // Fraction de la surface attribuée
+
+private:
+    int size;
+    GLuint depthTexture;
+    GLuint framebuffer;
+
+    std::vector<Tile> tiles;
+    std::vector<Tile> candidates;
+    std::vector<std::vector<glm::ivec2>> freeBlocks;   // Par niveau : taille = size >> niveau
+
+    // Allocateur buddy 2D : coin bas-gauche du bloc, ou (-1, -1) si aucun bloc libre
+    void resetAllocator();
+    glm::ivec2 allocate(int tileSize);
+};
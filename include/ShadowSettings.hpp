@@ -0,0 +1,38 @@
+#pragma once
+
+// Filtrage des cascades (valeurs du define SHADOW_FILTER de cascades.glsl)
+enum class ShadowFilter {
+    PCF = 0,            // Grille PCF_TAPS x PCF_TAPS de comparaisons manuelles (GL_NEAREST)
+    HARDWARE_PCF = 1,   // sampler2DArrayShadow : chaque tap est une comparaison bilinéaire
+    POISSON = 2,        // Disque de Poisson tourné par pixel
+    VSM = 3,            // Variance shadow maps : moments floutés et mipmappés
+    COUNT
+};
+
+// Réglages des ombres, modifiables depuis la fenêtre "Shadows"
+struct ShadowSettings {
+    // Cascades de la lumière directionnelle
+    int cascadeCount = 3;           // 1 à CascadedShadowMap::MAX_CASCADES
+    float splitLambda = 0.75f;      // Répartition des coupes : 0 = uniforme, 1 = logarithmique
+    float maxDistance = 50.0f;      // Distance couverte par les cascades (bornée par le far de la caméra)
+    float blendBand = 0.1f;         // Fraction de chaque cascade fondue avec la suivante
+    bool showCascades = false;      // Coloration de debug par cascade
+
+    // Cache des casters statiques
+    bool cacheStaticShadows = true; // Couche statique réutilisée tant que la cascade ne bouge pas
+    int staticUpdateBudget = 2;     // Couches statiques redessinées par frame (0 = illimité)
+
+    // Spots dans la shadow atlas
+    bool spotShadows = true;
+    int atlasMaxTileSize = 1024;    // Tuile du spot le plus important (puissance de deux)
+
+    // Lumières ponctuelles (six faces par lumière)
+    bool pointShadows = true;
+    bool pointShadowsSinglePass = true; // Geometry shader (gl_Layer) ou une passe par face
+
+    // Filtrage
+    ShadowFilter filter = ShadowFilter::PCF;
+    int pcfTaps = 3;                // Largeur du noyau PCF (1, 3 ou 5), aussi rayon du disque de Poisson
+    int vsmBlurRadius = 2;          // Rayon du flou séparable des moments, en texels
+    float vsmBleedReduction = 0.3f; // Part de p_max ramenée à 0 contre le light bleeding
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Light.hpp"
+#include "RenderList.hpp"
+#include <vector>
+
+// Scène de test de montée en charge : N objets tirés parmi les primitives et les matériaux
+// prédéfinis (Material::create*), répartis sur le plateau plat du terrain autour de la scène
+// d'origine, et M lumières de chaque type à la place des lumières par défaut.
+//
+// Déterministe : une même graine donne la même scène sur toutes les plateformes (générateur
+// pseudo-aléatoire propre, pas de std::*_distribution dont le résultat dépend de la
+// bibliothèque standard), ce qui permet de comparer des benchmarks entre machines.
+struct StressSceneSettings {
+    bool enabled = false;
+    unsigned int seed = 1;
+    int objectCount = 1000;
+    int directionalLights = 1;
+    int pointLights = 1;
+    int spotLights = 1;
+    bool animate = false;           // Rotation d'un objet sur deux (listes de rendu dynamiques)
+};
+
+// Primitive utilisable par le générateur, posée sur le sol à y = halfHeight x échelle
+struct StressScenePrimitive {
+    GeometryHandle geometry;
+    float halfHeight;
+};
+
+// Remplace le contenu de 'objects' et les lumières de 'lights'. Le nombre total de lumières
+// est limité à LightManager::MAX_LIGHTS (taille du tableau du shader) : les types sont servis
+// à tour de rôle et le nombre réellement créé est retourné.
+LightManager::LightCounts generateStressScene(const StressSceneSettings& settings,
+                                              const std::vector<StressScenePrimitive>& primitives,
+                                              std::vector<SceneObject>& objects, LightManager& lights);
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// Tâche asynchrone C++20 produisant une valeur de type T (non void).
+//
+//   Task<AsyncLoader::Texture> loadSky() {
+//       AsyncLoader::Texture texture = co_await AsyncLoader::loadTexture("assets/images/top.jpg");
+//       ...
+//   }
+//
+// La coroutine démarre immédiatement sur le thread appelant et se détache : elle va au bout
+// même si la Task est détruite. La Task est une poignée (copiable) sur son résultat :
+// isReady() indique s'il est disponible, sans bloquer, et co_await reprend l'appelant quand
+// il l'est, sur le thread qui l'a produit (une seule coroutine peut l'attendre).
+// Pas d'exceptions : les échecs sont dans T.
+template <typename T>
+class Task {
+    struct State {
+        std::mutex mutex;
+        std::optional<T> value;
+        std::coroutine_handle<> continuation;
+
+        // false : la valeur est déjà là, l'appelant ne doit pas se suspendre
+        bool setContinuation(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (value) return false;
+            continuation = handle;
+            return true;
+        }
+    };
+
+public:
+    struct promise_type {
+        std::shared_ptr<State> state = std::make_shared<State>();
+
+        // Fin de la coroutine : le cadre est libéré puis l'éventuel appelant reprend
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept {
+                std::shared_ptr<State> state = handle.promise().state;
+                std::coroutine_handle<> continuation;
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    continuation = std::exchange(state->continuation, nullptr);
+                }
+                handle.destroy();
+                if (continuation) continuation.resume();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        Task get_return_object() { return Task(state); }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() const noexcept { std::terminate(); }
+
+        void return_value(T result) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->value.emplace(std::move(result));
+        }
+    };
+
+    Task() = default;
+
+    bool isValid() const { return state != nullptr; }
+
+    bool isReady() const {
+        if (!state) return false;
+        std::lock_guard<std::mutex> lock(state->mutex);
+        return state->value.has_value();
+    }
+
+    // Seulement quand isReady()
+    const T& get() const { return *state->value; }
+
+    bool await_ready() const { return isReady(); }
+    bool await_suspend(std::coroutine_handle<> handle) const { return state->setContinuation(handle); }
+    T await_resume() const { return *state->value; }
+
+private:
+    explicit Task(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+    std::shared_ptr<State> state;
+};
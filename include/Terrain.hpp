@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Material.hpp"
+#include "RenderList.hpp"
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Terrain à champ de hauteur (bruit fractal, plat autour de la scène) en chunks de grille
+// de taille fixe, niveau de détail choisi par un quadtree sur le CPU.
+//
+// Chaque nœud du quadtree est un chunk de CHUNK_QUADS x CHUNK_QUADS quads couvrant son
+// emprise : la racine couvre tout le terrain, chaque niveau divise l'espacement des
+// sommets par deux. Tous les chunks ont la même topologie et partagent un seul buffer
+// d'indices ; seuls les sommets (en espace monde) leur sont propres. Des jupes verticales
+// sur les bords masquent les fissures entre chunks de niveaux différents.
+//
+// Un nœud est subdivisé quand la caméra est à moins de lodDistance fois sa taille et que
+// ses quatre enfants sont résidents ; sinon il est dessiné lui-même et les enfants manquants
+// sont générés sur les threads du JobSystem (les plus proches d'abord). Les chunks sont des
+// géométries de ResourceManager : leur sphère englobante sert au culling et aux ombres.
+class Terrain {
+public:
+    static constexpr int CHUNK_QUADS = 32;
+
+    struct Settings {
+        float lodDistance = 1.0f;       // Subdivision sous lodDistance x taille du nœud
+        int uploadsPerFrame = 8;        // Chunks transférés par frame (0 = illimité)
+        int maxGenerationsInFlight = 8;
+    };
+
+    struct Stats {
+        int chunksSelected = 0;         // Dessinés cette frame (avant culling)
+        int chunksResident = 0;
+        int chunksGenerating = 0;       // Demandés, pas encore transférés
+        int deepestLevel = 0;
+        std::size_t trianglesSelected = 0;
+        std::size_t residentBytes = 0;  // Sommets des chunks + buffer d'indices partagé
+        int generated = 0;
+        int evicted = 0;
+        double generationMs = 0.0;      // Cumul sur les threads
+        double maxGenerationMs = 0.0;
+        double selectMs = 0.0;          // Parcours du quadtree de la dernière frame
+    };
+
+    // size : côté du terrain (centré sur l'origine) ; leafSize : côté des chunks les plus fins
+    Terrain(float size = 4096.0f, float leafSize = 16.0f);
+    ~Terrain();
+
+    Terrain(const Terrain&) = delete;
+    Terrain& operator=(const Terrain&) = delete;
+
+    // Hauteur du sol (utilisable depuis n'importe quel thread)
+    float getHeight(float x, float z) const;
+
+    // Une fois par frame, sur le thread GL : sélection des nœuds, demandes de génération,
+    // transferts dans le budget, éviction des chunks inutilisés
+    void update(const glm::vec3& cameraPosition);
+
+    // Bloque jusqu'à ce que la sélection autour de la position soit complète (headless)
+    void finishLoading(const glm::vec3& cameraPosition);
+
+    // Chunks sélectionnés à la dernière mise à jour (statiques, en espace monde)
+    const std::vector<SceneObject>& getObjects() const { return objects; }
+
+    Settings& getSettings() { return settings; }
+    const Stats& getStats() const { return stats; }
+    void printReport() const;
+
+private:
+    struct Chunk;
+
+    enum class NodeState {
+        EMPTY,
+        GENERATING,
+        RESIDENT
+    };
+
+    struct Node {
+        NodeState state = NodeState::EMPTY;
+        GeometryHandle geometry;
+        std::uint32_t request = 0;          // Résultats périmés ignorés
+        std::uint64_t lastUsedFrame = 0;
+        float minY = 0.0f;                  // Hauteurs du chunk (connues une fois généré)
+        float maxY = 0.0f;
+        std::size_t bytes = 0;
+    };
+
+    struct Request {
+        float distance;
+        std::uint64_t key;
+    };
+
+    // Thread de travail : hauteurs, normales et jupes d'un nœud (aucun appel GL)
+    static void generateChunk(float terrainSize, Chunk& chunk);
+
+    static std::uint64_t makeKey(int level, int x, int z);
+    float getNodeSize(int level) const { return size / static_cast<float>(1 << level); }
+    float getDistance(int level, int x, int z, const Node& node, const glm::vec3& position) const;
+
+    void selectNode(int level, int x, int z, const glm::vec3& position);
+    void requestNode(std::uint64_t key);
+    void uploadChunk(Chunk& chunk);
+    void releaseNode(Node& node);
+
+    Settings settings;
+    Stats stats;
+    float size;
+    int maxLevel;
+    Material material;
+    GLuint indexBuffer;
+    std::uint64_t frame;
+
+    std::unordered_map<std::uint64_t, Node> nodes;
+    std::vector<SceneObject> objects;
+    std::vector<Request> requests;          // Réutilisés d'une frame à l'autre
+
+    // Chunks générés remis par les threads (via la file du thread GL)
+    std::shared_ptr<std::vector<Chunk>> readyChunks;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Cache disque des textures transcodées : au premier chargement, l'image source (JPEG, PNG...)
+// est décodée, sa chaîne de mips calculée puis compressée en BC1, et le résultat écrit dans
+// le répertoire du cache. Les chargements suivants lisent directement les blocs, prêts pour
+// glCompressedTexImage2D. La clé combine le chemin, la taille et la date de la source et la
+// version du transcodeur : modifier l'image suffit à reconstruire l'entrée.
+//
+// Format d'une entrée (inspiré de KTX2, sans Data Format Descriptor) : en-tête, index des
+// niveaux (offset, taille) puis les niveaux contigus, du plus grand au plus petit.
+//
+// Si une archive d'assets est montée (AssetPack), l'entrée "<source>.tex" qu'elle contient
+// est servie directement depuis la projection, sans lecture ni copie.
+//
+// load() peut être appelée depuis des threads de décodage (aucun appel GL).
+class TextureCache {
+public:
+    struct Level {
+        int width = 0;
+        int height = 0;
+        std::size_t offset = 0;     // Depuis getData()
+        std::size_t size = 0;
+    };
+
+    // Image prête à être transférée : blocs BC1 ou, si la compression est indisponible, RGBA8
+    struct Image {
+        GLenum internalFormat = 0;  // GL_COMPRESSED_RGB_S3TC_DXT1_EXT ou GL_RGBA8
+        std::vector<Level> levels;
+        std::vector<unsigned char> data;
+        const unsigned char* mappedData = nullptr;  // Niveaux dans une archive projetée (data vide)
+        std::size_t mappedSize = 0;
+
+        const unsigned char* getData() const { return mappedData ? mappedData : data.data(); }
+        std::size_t getDataSize() const { return mappedData ? mappedSize : data.size(); }
+        bool isValid() const { return !levels.empty(); }
+        bool isCompressed() const { return internalFormat != GL_RGBA8; }
+        int getWidth() const { return levels.empty() ? 0 : levels[0].width; }
+        int getHeight() const { return levels.empty() ? 0 : levels[0].height; }
+    };
+
+    struct Stats {
+        int hits = 0;
+        int packHits = 0;           // Dont entrées servies par l'archive d'assets
+        int misses = 0;             // Images transcodées (ou décodées sans cache)
+        double hitMs = 0.0;
+        double missMs = 0.0;
+        std::size_t bytes = 0;      // Taille des images chargées (mips comprises)
+    };
+
+    static void setDirectory(const std::string& directory);
+    static const std::string& getDirectory();
+
+    // Désactivé : images décodées à chaque chargement, non compressées
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // GL_EXT_texture_compression_s3tc (BC1) : sans elle, le cache est contourné
+    static bool isCompressionSupported();
+
+    // Image de 'sourcePath' avec sa chaîne de mips complète. Retourne false si la source
+    // est illisible.
+    static bool load(const std::string& sourcePath, Image& image);
+
+    // Décode 'sourcePath' et construit la chaîne de mips, en BC1 si 'compress' (sans cache)
+    static bool transcode(const std::string& sourcePath, bool compress, Image& image);
+
+    // Entrée au format du cache, telle que stockée dans une archive d'assets (outil asset_packer)
+    static void serialize(const Image& image, std::string& bytes);
+    static const char* getPackSuffix() { return ".tex"; }
+
+    // Transfère 'image' dans la cible liée ('target' : GL_TEXTURE_2D ou une face de cubemap).
+    // 'pixels' : base des données (Image::getData(), ou offset dans le PBO lié à GL_PIXEL_UNPACK_BUFFER)
+    static void upload(GLenum target, const Image& image, const unsigned char* pixels);
+
+    static Stats getStats();
+    static void printReport();
+
+private:
+    static std::string getEntryPath(std::uint64_t key);
+};
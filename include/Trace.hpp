@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Marqueurs CPU au format Chrome trace (chrome://tracing, Perfetto).
+//
+//   TRACE_SCOPE("shadow_pass");
+//
+// Activés uniquement si ENABLE_TRACING est défini (option CMake ENABLE_TRACING) :
+// sinon les macros ne génèrent aucun code. Chaque thread écrit dans son propre
+// buffer circulaire, sans verrou ; le nom doit être une chaîne littérale.
+#ifdef ENABLE_TRACING
+    #define TRACE_CONCAT_INNER(a, b) a##b
+    #define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+    #define TRACE_SCOPE(name) Tracer::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+    #define TRACE_THREAD_NAME(name) Tracer::setThreadName(name)
+#else
+    #define TRACE_SCOPE(name) ((void)0)
+    #define TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+class Tracer {
+public:
+    // Scope RAII utilisé par TRACE_SCOPE
+    class Scope {
+    public:
+        explicit Scope(const char* name) : name(name), start(now()) {}
+        ~Scope() { record(name, start, now()); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        const char* name;
+        std::uint64_t start;
+    };
+
+    static constexpr bool isEnabled() {
+#ifdef ENABLE_TRACING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Horloge monotone en nanosecondes
+    static std::uint64_t now();
+
+    // Enregistre un événement complet dans le buffer du thread appelant
+    static void record(const char* name, std::uint64_t startNs, std::uint64_t endNs);
+
+    // Nom du thread appelant dans la trace
+    static void setThreadName(const char* name);
+
+    // Écrit tous les buffers au format JSON Chrome trace
+    static bool writeChromeTrace(const std::string& path);
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Material.hpp"
+#include "RenderList.hpp"
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Monde découpé en cellules d'une grille (plan XZ), chargées et déchargées en arrière-plan
+// selon leur distance à la caméra.
+//
+// Format texte (.world), une directive par ligne :
+//   cell_size <taille>
+//   object <maillage> <matériau> r g b  posX posY posZ  scaleX scaleY scaleZ  yaw
+// <maillage> : sphere, cube, cylinder, cone, plane ou un fichier OBJ / glTF (cache de
+// maillages compilés) ; <matériau> : plastic, metal, rubber ou wood ; yaw en degrés.
+// Chaque objet appartient à la cellule qui contient sa position.
+//
+// Une cellule est compilée sur un thread du JobSystem : les maillages de ses objets sont
+// transformés en espace monde et fusionnés en un bloc par matériau (un draw call par
+// matériau et par cellule). Le thread GL transfère les cellules prêtes, les plus proches
+// d'abord, dans la limite d'un budget d'octets par frame.
+//
+// Hystérésis : une cellule est demandée sous loadRadius et déchargée au-delà de unloadRadius
+// (> loadRadius), pour qu'une caméra à la frontière ne la recharge pas à chaque pas.
+class WorldStreamer {
+public:
+    struct Settings {
+        float loadRadius = 60.0f;
+        float unloadRadius = 75.0f;
+        int uploadBudgetKB = 512;       // Ko transférés par frame (au moins une cellule, 0 = illimité)
+        int maxLoadsInFlight = 4;       // Cellules compilées en parallèle sur les threads
+    };
+
+    struct Stats {
+        int cellsTotal = 0;
+        int cellsResident = 0;
+        int cellsQueued = 0;            // Dans le rayon, pas encore lancées
+        int cellsLoading = 0;           // En compilation sur un thread
+        int cellsReady = 0;             // Compilées, en attente de transfert
+        int loads = 0;
+        int unloads = 0;
+        int cancelled = 0;              // Sorties du rayon pendant leur chargement
+        std::size_t residentBytes = 0;
+        std::size_t peakResidentBytes = 0;
+        double latencyMs = 0.0;         // Cumul, de l'entrée dans le rayon à la cellule affichable
+        double maxLatencyMs = 0.0;
+        double uploadMs = 0.0;          // Transferts de la dernière frame
+        double maxUploadMs = 0.0;
+    };
+
+    WorldStreamer();
+    ~WorldStreamer();
+
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    // Lit la description du monde (objets répartis en cellules, rien n'est chargé).
+    // Thread GL : les primitives sont générées une fois ici.
+    bool load(const std::string& path);
+
+    // Une fois par frame, sur le thread GL : file de priorité des cellules à charger,
+    // déchargements, transfert des cellules prêtes dans le budget
+    void update(const glm::vec3& cameraPosition);
+
+    // Bloque jusqu'à ce que toutes les cellules dans le rayon de chargement soient résidentes
+    // (mode headless et benchmark)
+    void finishLoading(const glm::vec3& cameraPosition);
+
+    // Objets des cellules résidentes (un par matériau et par cellule, statiques)
+    const std::vector<SceneObject>& getObjects() const { return objects; }
+
+    Settings& getSettings() { return settings; }
+    const Stats& getStats() const { return stats; }
+    void printReport() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Data;
+    struct CompiledCell;
+
+    enum class CellState {
+        UNLOADED,
+        LOADING,
+        READY,
+        RESIDENT
+    };
+
+    struct Chunk {
+        GeometryHandle geometry;
+        int material;
+    };
+
+    struct Cell {
+        glm::ivec2 coordinates;
+        CellState state = CellState::UNLOADED;
+        std::uint32_t request = 0;          // Incrémenté à chaque demande (résultats périmés ignorés)
+        bool wanted = false;                // Dans le rayon de chargement, pas encore résidente
+        Clock::time_point wantedTime;       // Entrée dans le rayon (origine de la latence)
+        std::vector<Chunk> chunks;
+        std::size_t bytes = 0;
+    };
+
+    // Thread de travail : aucun appel GL
+    static void compileCell(const Data& world, CompiledCell& compiled);
+
+    float getDistance(const Cell& cell, const glm::vec3& position) const;
+    void requestCell(std::uint32_t index);
+    void uploadCell(CompiledCell& compiled);
+    void unloadCell(Cell& cell);
+    void rebuildObjects();
+
+    Settings settings;
+    Stats stats;
+    std::shared_ptr<const Data> data;       // Partagé avec les compilations en cours
+    std::vector<Cell> cells;
+    std::vector<SceneObject> objects;
+
+    // Cellules compilées remises par les threads (via la file du thread GL)
+    std::shared_ptr<std::vector<CompiledCell>> readyCells;
+};
@@ -0,0 +1,56 @@
+#include "AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<std::size_t> allocationCount{0};
+    std::atomic<std::size_t> allocatedBytes{0};
+
+    void* countedAlloc(std::size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (void* p = std::malloc(size == 0 ? 1 : size)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+        // aligned_alloc exige une taille multiple de l'alignement
+        std::size_t align = static_cast<std::size_t>(alignment);
+        std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) & ~(align - 1);
+        if (void* p = std::aligned_alloc(align, rounded)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+std::size_t AllocationCounter::getCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+std::size_t AllocationCounter::getBytes() {
+    return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+// Remplacement des operator new/delete globaux (les variantes nothrow délèguent à celles-ci)
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Variantes alignées (utilisées notamment par std::pmr::new_delete_resource)
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAlignedAlloc(size, alignment); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
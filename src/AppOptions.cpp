@@ -0,0 +1,191 @@
+#include "AppOptions.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+bool parseAppOptions(int argc, char** argv, AppOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+
+        // Arguments avec valeur
+        auto nextValue = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << name << std::endl;
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (std::strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(arg, "--frames") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.frameCount = std::atoi(value);
+            if (options.frameCount <= 0) {
+                std::cerr << "Invalid frame count: " << value << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--output") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.outputImage = value;
+        } else if (std::strcmp(arg, "--benchmark") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.benchmarkCameraPath = value;
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.warmupFrames = std::atoi(value);
+            if (options.warmupFrames < 0) {
+                std::cerr << "Invalid warm-up frame count: " << value << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--measure") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.measuredFrames = std::atoi(value);
+            if (options.measuredFrames <= 0) {
+                std::cerr << "Invalid measured frame count: " << value << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--report") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.reportPrefix = value;
+        } else if (std::strcmp(arg, "--trace") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.tracePath = value;
+        } else if (std::strcmp(arg, "--record-camera") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.recordCameraPath = value;
+        } else if (std::strcmp(arg, "--no-program-cache") == 0) {
+            options.disableProgramCache = true;
+        } else if (std::strcmp(arg, "--no-texture-cache") == 0) {
+            options.disableTextureCache = true;
+        } else if (std::strcmp(arg, "--no-mesh-cache") == 0) {
+            options.disableMeshCache = true;
+        } else if (std::strcmp(arg, "--model") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.modelPath = value;
+        } else if (std::strcmp(arg, "--world") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.worldPath = value;
+        } else if (std::strcmp(arg, "--stress-objects") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.stressObjects = std::atoi(value);
+            if (options.stressObjects <= 0) {
+                std::cerr << "Invalid stress object count: " << value << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--stress-lights") == 0) {
+            // M (de chaque type) ou directionnelles,ponctuelles,spots
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            int directional = 0, point = 0, spot = 0;
+            char extra = 0;
+            int fields = std::sscanf(value, "%d,%d,%d%c", &directional, &point, &spot, &extra);
+            if (fields == 1) {
+                point = spot = directional;
+            }
+            if ((fields != 1 && fields != 3) || directional < 0 || point < 0 || spot < 0) {
+                std::cerr << "Invalid stress light count (M or dir,point,spot): " << value << std::endl;
+                return false;
+            }
+            options.stressDirectionalLights = directional;
+            options.stressPointLights = point;
+            options.stressSpotLights = spot;
+        } else if (std::strcmp(arg, "--stress-seed") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.stressSeed = static_cast<unsigned int>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--stress-animate") == 0) {
+            options.stressAnimate = true;
+        } else if (std::strcmp(arg, "--mesh-benchmark") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.meshBenchmarkPath = value;
+        } else if (std::strcmp(arg, "--vram-budget") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.vramBudgetMB = std::atoi(value);
+            if (options.vramBudgetMB < 0) {
+                std::cerr << "Invalid VRAM budget: " << value << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--asset-pack") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.assetPackPath = value;
+        } else if (std::strcmp(arg, "--no-asset-pack") == 0) {
+            options.disableAssetPack = true;
+        } else if (std::strcmp(arg, "--shadow-filter") == 0) {
+            static const char* const filterNames[] = { "pcf", "hardware", "poisson", "vsm" };
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.shadowFilter = -1;
+            for (int filter = 0; filter < 4; ++filter) {
+                if (std::strcmp(value, filterNames[filter]) == 0) {
+                    options.shadowFilter = filter;
+                }
+            }
+            if (options.shadowFilter < 0) {
+                std::cerr << "Invalid shadow filter (pcf, hardware, poisson or vsm): " << value << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--point-shadow-passes") == 0) {
+            const char* value = nextValue(arg);
+            if (!value) return false;
+            options.pointShadowPasses = std::atoi(value);
+            if (options.pointShadowPasses != 1 && options.pointShadowPasses != 6) {
+                std::cerr << "Invalid point shadow pass count (1 or 6): " << value << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--depth-prepass") == 0) {
+            options.depthPrepass = true;
+        } else if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            options.showHelp = true;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void printAppUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n"
+              << "  --headless         Render offscreen (no visible window) and exit\n"
+              << "  --frames <N>       Number of frames to render in headless mode (default 100)\n"
+              << "  --output <file>    Write the last headless frame as a PPM image\n"
+              << "  --benchmark <path> Replay a recorded camera path with a fixed clock and report frame times\n"
+              << "  --warmup <N>       Benchmark warm-up frames, not measured (default 60)\n"
+              << "  --measure <M>      Benchmark measured frames (default 300)\n"
+              << "  --report <prefix>  Benchmark report files <prefix>.csv and <prefix>.json\n"
+              << "  --record-camera <path>  Record the camera path of an interactive session\n"
+              << "  --trace <file>     Write a Chrome trace at exit (needs ENABLE_TRACING; F9 dumps trace.json)\n"
+              << "  --no-program-cache Always compile shaders, ignoring the program binary cache\n"
+              << "  --no-texture-cache Decode textures at every start and upload them uncompressed\n"
+              << "  --no-mesh-cache    Always re-import models, ignoring the compiled mesh cache\n"
+              << "  --model <file>     Add an OBJ or glTF model to the scene\n"
+              << "  --world <file>     Stream a cell-partitioned world (.world) around the camera\n"
+              << "  --stress-objects <N>  Replace the default lights with a generated stress scene of N objects\n"
+              << "  --stress-lights <M|d,p,s>  Stress scene lights of each type, or per type (default 1, 8 in total at most)\n"
+              << "  --stress-seed <S>  Stress scene random seed (default 1)\n"
+              << "  --stress-animate   Rotate half of the stress scene objects\n"
+              << "  --mesh-benchmark <file>  Measure import and compiled-load throughput of a model, then exit\n"
+              << "  --vram-budget <MB> GPU memory budget; least recently visible streamed meshes are evicted (default 1024, 0 = unlimited)\n"
+              << "  --asset-pack <file> Serve shaders and textures from a memory-mapped asset pack (default assets.pack when headless)\n"
+              << "  --no-asset-pack    Always read assets from loose files\n"
+              << "  --shadow-filter <pcf|hardware|poisson|vsm>  Cascade shadow filtering mode\n"
+              << "  --point-shadow-passes <1|6>  Point light cube shadows in one geometry-shader pass or one pass per face\n"
+              << "  --depth-prepass    Lay down depth first so the lit pass shades each pixel once\n"
+              << "  --help             Show this help\n";
+}
@@ -0,0 +1,211 @@
+#include "AssetPack.hpp"
+#include "LZ4.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char AssetPack::MAGIC[8] = {'A', 'S', 'S', 'E', 'T', 'P', 'K', '1'};
+
+namespace {
+    std::unique_ptr<AssetPack> mountedPack;
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    TRACE_SCOPE("AssetPack::open");
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Asset pack not found: " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    HANDLE fileMapping = fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    void* view = fileMapping ? MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        std::cerr << "Failed to map asset pack: " << path << std::endl;
+        if (fileMapping) CloseHandle(fileMapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = fileMapping;
+    mapping = view;
+    mappedSize = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        std::cerr << "Asset pack not found: " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    // La projection garde sa propre référence sur le fichier
+    ::close(descriptor);
+    if (view == MAP_FAILED) {
+        std::cerr << "Failed to map asset pack: " << path << std::endl;
+        return false;
+    }
+    mapping = view;
+    mappedSize = static_cast<std::size_t>(info.st_size);
+#endif
+
+    base = static_cast<const unsigned char*>(mapping);
+    packPath = path;
+    if (!validate()) {
+        std::cerr << "Invalid asset pack: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    if (mapping) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapping);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(mapping, mappedSize);
+#endif
+    }
+    mapping = nullptr;
+    mappedSize = 0;
+    base = nullptr;
+    entries = nullptr;
+    entryCount = 0;
+    paths = nullptr;
+    packPath.clear();
+}
+
+bool AssetPack::validate() {
+    if (mappedSize < sizeof(Header)) return false;
+
+    Header header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) return false;
+
+    // Index et table des chemins entièrement dans le fichier
+    std::uint64_t indexSize = static_cast<std::uint64_t>(header.entryCount) * sizeof(Entry);
+    if (header.indexOffset % alignof(Entry) != 0 || header.indexOffset > mappedSize ||
+        indexSize > mappedSize - header.indexOffset ||
+        header.pathsOffset > mappedSize || header.pathsSize > mappedSize - header.pathsOffset) {
+        return false;
+    }
+
+    entries = reinterpret_cast<const Entry*>(base + header.indexOffset);
+    entryCount = header.entryCount;
+    paths = reinterpret_cast<const char*>(base + header.pathsOffset);
+
+    for (std::size_t i = 0; i < entryCount; ++i) {
+        const Entry& entry = entries[i];
+        if (entry.dataOffset % ALIGNMENT != 0 || entry.dataOffset > mappedSize ||
+            entry.storedSize > mappedSize - entry.dataOffset ||
+            static_cast<std::uint64_t>(entry.pathOffset) + entry.pathLength > header.pathsSize ||
+            (!(entry.flags & FLAG_LZ4) && entry.storedSize != entry.size)) {
+            return false;
+        }
+        // Recherche dichotomique : l'index doit être strictement trié
+        if (i > 0 && getEntryPath(entries[i - 1]) >= getEntryPath(entry)) return false;
+    }
+    return true;
+}
+
+const AssetPack::Entry* AssetPack::find(std::string_view path) const {
+    const Entry* end = entries + entryCount;
+    const Entry* found = std::lower_bound(entries, end, path, [this](const Entry& entry, std::string_view key) {
+        return getEntryPath(entry) < key;
+    });
+    if (found == end || getEntryPath(*found) != path) return nullptr;
+    return found;
+}
+
+std::string_view AssetPack::getEntryPath(const Entry& entry) const {
+    return std::string_view(paths + entry.pathOffset, entry.pathLength);
+}
+
+std::string_view AssetPack::view(std::string_view path) const {
+    const Entry* entry = find(path);
+    if (!entry || (entry->flags & FLAG_LZ4)) return std::string_view();
+    return std::string_view(reinterpret_cast<const char*>(base + entry->dataOffset), entry->size);
+}
+
+bool AssetPack::read(std::string_view path, std::string& content) const {
+    const Entry* entry = find(path);
+    if (!entry) return false;
+
+    const unsigned char* stored = base + entry->dataOffset;
+    if (!(entry->flags & FLAG_LZ4)) {
+        content.assign(reinterpret_cast<const char*>(stored), entry->size);
+        return true;
+    }
+
+    content.resize(entry->size);
+    if (!LZ4::decompress(stored, entry->storedSize, reinterpret_cast<unsigned char*>(content.data()), entry->size)) {
+        std::cerr << "Corrupted asset in pack " << packPath << ": " << path << std::endl;
+        content.clear();
+        return false;
+    }
+    return true;
+}
+
+std::string AssetPack::normalizePath(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool AssetPack::mount(const std::string& path) {
+    auto pack = std::make_unique<AssetPack>();
+    if (!pack->open(path)) return false;
+    mountedPack = std::move(pack);
+    return true;
+}
+
+void AssetPack::unmount() {
+    mountedPack.reset();
+}
+
+const AssetPack* AssetPack::getMounted() {
+    return mountedPack.get();
+}
+
+bool AssetPack::readAsset(const std::string& path, std::string& content) {
+    if (mountedPack && mountedPack->read(normalizePath(path), content)) {
+        return true;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::stringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+    return true;
+}
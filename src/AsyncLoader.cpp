@@ -0,0 +1,118 @@
+#include "AsyncLoader.hpp"
+#include "Geometry.hpp"
+#include "GLState.hpp"
+#include "JobSystem.hpp"
+#include "MeshCache.hpp"
+#include "ResourceManager.hpp"
+#include "TextureCache.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    AsyncLoader::Stats loaderStats;
+    std::mutex statsMutex;
+
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    void recordStart() {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        ++loaderStats.inFlight;
+    }
+
+    void recordEnd(bool succeeded, bool isTexture, double latencyMs, double uploadMs) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        --loaderStats.inFlight;
+        if (!succeeded) {
+            ++loaderStats.failures;
+            return;
+        }
+        ++(isTexture ? loaderStats.textures : loaderStats.meshes);
+        loaderStats.latencyMs += latencyMs;
+        loaderStats.maxLatencyMs = std::max(loaderStats.maxLatencyMs, latencyMs);
+        loaderStats.uploadMs += uploadMs;
+        loaderStats.maxUploadMs = std::max(loaderStats.maxUploadMs, uploadMs);
+    }
+}
+
+Task<AsyncLoader::Texture> AsyncLoader::loadTexture(std::string path) {
+    Clock::time_point start = Clock::now();
+    recordStart();
+
+    co_await JobSystem::switchToWorker();
+    TextureCache::Image image;
+    bool loaded = TextureCache::load(path, image);
+
+    co_await JobSystem::switchToMainThread();
+    Texture texture;
+    if (!loaded) {
+        std::cerr << "Failed to load texture: " << path << std::endl;
+        recordEnd(false, true, 0.0, 0.0);
+        co_return texture;
+    }
+
+    TRACE_SCOPE("AsyncLoader::uploadTexture");
+    Clock::time_point uploadStart = Clock::now();
+    glGenTextures(1, &texture.id);
+    GLState::bindTexture(0, GL_TEXTURE_2D, texture.id);
+    TextureCache::upload(GL_TEXTURE_2D, image, image.getData());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size()) - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    texture.width = image.getWidth();
+    texture.height = image.getHeight();
+    texture.bytes = image.getDataSize();
+    ResourceManager::trackMemory(ResourceCategory::TEXTURE, static_cast<std::int64_t>(texture.bytes));
+
+    recordEnd(true, true, elapsedMs(start), elapsedMs(uploadStart));
+    co_return texture;
+}
+
+Task<bool> AsyncLoader::loadMesh(std::string path, Geometry* geometry) {
+    Clock::time_point start = Clock::now();
+    recordStart();
+
+    co_await JobSystem::switchToWorker();
+    MeshCache::CompiledMesh mesh;
+    bool loaded = MeshCache::load(path, mesh);
+
+    co_await JobSystem::switchToMainThread();
+    if (!loaded) {
+        std::cerr << "Failed to load mesh: " << path << std::endl;
+        recordEnd(false, false, 0.0, 0.0);
+        co_return false;
+    }
+
+    TRACE_SCOPE("AsyncLoader::uploadMesh");
+    Clock::time_point uploadStart = Clock::now();
+    geometry->setupMesh(mesh.vertices, mesh.vertexCount, mesh.indices, mesh.indexCount,
+                        mesh.boundsCenter, mesh.boundsRadius);
+
+    recordEnd(true, false, elapsedMs(start), elapsedMs(uploadStart));
+    co_return true;
+}
+
+AsyncLoader::Stats AsyncLoader::getStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return loaderStats;
+}
+
+void AsyncLoader::printReport() {
+    Stats stats = getStats();
+    int loads = stats.textures + stats.meshes;
+    if (loads + stats.failures == 0) return;
+
+    std::cout << "Async loads: " << stats.textures << " textures, " << stats.meshes << " meshes, "
+              << stats.failures << " failed; latency " << (loads > 0 ? stats.latencyMs / loads : 0.0)
+              << " ms avg (max " << stats.maxLatencyMs << " ms), GL thread " << stats.uploadMs
+              << " ms total (max " << stats.maxUploadMs << " ms per upload) on "
+              << JobSystem::getWorkerCount() << " worker(s)" << std::endl;
+}
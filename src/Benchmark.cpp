@@ -0,0 +1,272 @@
+#include "Benchmark.hpp"
+#include "Geometry.hpp"
+#include "MeshCache.hpp"
+#include "MeshImporter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+const char* getRenderPassName(RenderPass pass) {
+    switch (pass) {
+        case RenderPass::SHADOW:        return "shadow";
+        case RenderPass::DEPTH_PREPASS: return "depth_prepass";
+        case RenderPass::MAIN:          return "main";
+        case RenderPass::SKYBOX:        return "skybox";
+        case RenderPass::LIGHT_SOURCES: return "light_sources";
+        case RenderPass::GUI:           return "gui";
+        default:                        return "unknown";
+    }
+}
+
+// ============================================================================
+// FrameTimer
+// ============================================================================
+void FrameTimer::beginFrame() {
+    current = FrameTimings();
+    frameStart = Clock::now();
+}
+
+void FrameTimer::endFrame() {
+    current.cpuMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+    lastFrame = current;
+}
+
+void FrameTimer::beginPass(RenderPass pass) {
+    passStart[static_cast<int>(pass)] = Clock::now();
+}
+
+void FrameTimer::endPass(RenderPass pass) {
+    int index = static_cast<int>(pass);
+    current.passCpuMs[index] += std::chrono::duration<double, std::milli>(Clock::now() - passStart[index]).count();
+}
+
+// ============================================================================
+// PercentileSummary
+// ============================================================================
+PercentileSummary PercentileSummary::compute(std::vector<double> values) {
+    PercentileSummary summary;
+    if (values.empty()) return summary;
+
+    std::sort(values.begin(), values.end());
+
+    // Percentile "nearest rank"
+    auto percentile = [&](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+        return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+    };
+
+    summary.p50 = percentile(50.0);
+    summary.p95 = percentile(95.0);
+    summary.p99 = percentile(99.0);
+    summary.max = values.back();
+    summary.mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    return summary;
+}
+
+// ============================================================================
+// BenchmarkRecorder
+// ============================================================================
+BenchmarkRecorder::BenchmarkRecorder(int warmupFrames, int measuredFrames)
+    : warmupFrames(warmupFrames), measuredFrames(measuredFrames),
+      frames(measuredFrames), gpuValid(measuredFrames, false) {}
+
+FrameTimings* BenchmarkRecorder::getMeasuredFrame(int frameIndex) {
+    int measured = frameIndex - warmupFrames;
+    if (measured < 0 || measured >= measuredFrames) return nullptr;
+    return &frames[measured];
+}
+
+void BenchmarkRecorder::recordCpu(int frameIndex, const FrameTimings& timings) {
+    if (FrameTimings* frame = getMeasuredFrame(frameIndex)) {
+        frame->cpuMs = timings.cpuMs;
+        frame->passCpuMs = timings.passCpuMs;
+    }
+}
+
+void BenchmarkRecorder::recordGpu(int frameIndex, double gpuMs,
+                                  const std::vector<GpuProfiler::ScopeResult>& scopes) {
+    FrameTimings* frame = getMeasuredFrame(frameIndex);
+    if (!frame) return;
+
+    frame->gpuMs = gpuMs;
+    frame->passGpuMs.fill(0.0);
+    for (const auto& scope : scopes) {
+        if (scope.depth != 0) continue;
+        for (int pass = 0; pass < RENDER_PASS_COUNT; ++pass) {
+            if (std::strcmp(scope.name, getRenderPassName(static_cast<RenderPass>(pass))) == 0) {
+                frame->passGpuMs[pass] += scope.durationMs;
+            }
+        }
+    }
+    gpuValid[frameIndex - warmupFrames] = true;
+}
+
+std::vector<double> BenchmarkRecorder::collect(double FrameTimings::*field) const {
+    std::vector<double> values;
+    values.reserve(frames.size());
+    for (const auto& frame : frames) {
+        values.push_back(frame.*field);
+    }
+    return values;
+}
+
+std::vector<double> BenchmarkRecorder::collectGpu() const {
+    std::vector<double> values;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (gpuValid[i]) values.push_back(frames[i].gpuMs);
+    }
+    return values;
+}
+
+std::vector<double> BenchmarkRecorder::collectPass(std::array<double, RENDER_PASS_COUNT> FrameTimings::*field,
+                                                   int pass, bool gpu) const {
+    std::vector<double> values;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (gpu && !gpuValid[i]) continue;
+        values.push_back((frames[i].*field)[pass]);
+    }
+    return values;
+}
+
+namespace {
+    void writeJsonSummary(std::ostream& out, const PercentileSummary& s) {
+        out << "{\"p50\": " << s.p50 << ", \"p95\": " << s.p95 << ", \"p99\": " << s.p99
+            << ", \"max\": " << s.max << ", \"mean\": " << s.mean << "}";
+    }
+
+    void writeCsvRow(std::ostream& out, const std::string& metric, const PercentileSummary& s) {
+        out << metric << "," << s.p50 << "," << s.p95 << "," << s.p99 << "," << s.max << "," << s.mean << "\n";
+    }
+}
+
+bool BenchmarkRecorder::writeReports(const std::string& prefix) const {
+    PercentileSummary cpu = PercentileSummary::compute(collect(&FrameTimings::cpuMs));
+    PercentileSummary gpu = PercentileSummary::compute(collectGpu());
+
+    // CSV : une ligne par métrique
+    std::ofstream csv(prefix + ".csv");
+    if (!csv) {
+        std::cerr << "Failed to write benchmark report: " << prefix << ".csv" << std::endl;
+        return false;
+    }
+    csv << std::fixed << std::setprecision(4);
+    csv << "metric,p50_ms,p95_ms,p99_ms,max_ms,mean_ms\n";
+    writeCsvRow(csv, "cpu_frame", cpu);
+    writeCsvRow(csv, "gpu_frame", gpu);
+    for (int pass = 0; pass < RENDER_PASS_COUNT; ++pass) {
+        std::string name = getRenderPassName(static_cast<RenderPass>(pass));
+        writeCsvRow(csv, "cpu_" + name, PercentileSummary::compute(collectPass(&FrameTimings::passCpuMs, pass, false)));
+        writeCsvRow(csv, "gpu_" + name, PercentileSummary::compute(collectPass(&FrameTimings::passGpuMs, pass, true)));
+    }
+
+    // JSON : même contenu, structuré
+    std::ofstream json(prefix + ".json");
+    if (!json) {
+        std::cerr << "Failed to write benchmark report: " << prefix << ".json" << std::endl;
+        return false;
+    }
+    json << std::fixed << std::setprecision(4);
+    json << "{\n";
+    json << "  \"warmup_frames\": " << warmupFrames << ",\n";
+    json << "  \"measured_frames\": " << measuredFrames << ",\n";
+    json << "  \"gpu_frames\": " << collectGpu().size() << ",\n";
+    json << "  \"scene\": {\"objects\": " << scene.objects << ", \"directional_lights\": " << scene.directionalLights
+         << ", \"point_lights\": " << scene.pointLights << ", \"spot_lights\": " << scene.spotLights
+         << ", \"seed\": " << scene.seed << "},\n";
+    json << "  \"cpu_frame_ms\": "; writeJsonSummary(json, cpu); json << ",\n";
+    json << "  \"gpu_frame_ms\": "; writeJsonSummary(json, gpu); json << ",\n";
+    json << "  \"passes\": {\n";
+    for (int pass = 0; pass < RENDER_PASS_COUNT; ++pass) {
+        json << "    \"" << getRenderPassName(static_cast<RenderPass>(pass)) << "\": {\"cpu_ms\": ";
+        writeJsonSummary(json, PercentileSummary::compute(collectPass(&FrameTimings::passCpuMs, pass, false)));
+        json << ", \"gpu_ms\": ";
+        writeJsonSummary(json, PercentileSummary::compute(collectPass(&FrameTimings::passGpuMs, pass, true)));
+        json << "}" << (pass + 1 < RENDER_PASS_COUNT ? "," : "") << "\n";
+    }
+    json << "  }\n";
+    json << "}\n";
+
+    return static_cast<bool>(csv) && static_cast<bool>(json);
+}
+
+void BenchmarkRecorder::printSummary() const {
+    PercentileSummary cpu = PercentileSummary::compute(collect(&FrameTimings::cpuMs));
+    PercentileSummary gpu = PercentileSummary::compute(collectGpu());
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Benchmark (" << measuredFrames << " frames, " << warmupFrames << " warm-up)\n"
+              << "  Scene: " << scene.objects << " objects, " << scene.directionalLights << " directional, "
+              << scene.pointLights << " point, " << scene.spotLights << " spot lights\n"
+              << "  CPU frame: p50 " << cpu.p50 << " ms, p95 " << cpu.p95 << " ms, p99 " << cpu.p99
+              << " ms, max " << cpu.max << " ms\n"
+              << "  GPU frame: p50 " << gpu.p50 << " ms, p95 " << gpu.p95 << " ms, p99 " << gpu.p99
+              << " ms, max " << gpu.max << " ms" << std::endl;
+}
+
+// ============================================================================
+// Mesh import / load benchmark
+// ============================================================================
+bool runMeshBenchmark(const std::string& modelPath, int loadIterations) {
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    // Import : lecture + analyse + soudure + optimisation, sans cache
+    // Un thread puis tous les cœurs (une seule mesure sur une machine à un cœur)
+    std::vector<int> threadCounts = {1};
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (hardwareThreads > 1) threadCounts.push_back(hardwareThreads);
+    MeshImporter::MeshData mesh;
+    MeshImporter::Stats stats;
+    std::cout << std::fixed << std::setprecision(1);
+    for (int threads : threadCounts) {
+        auto start = Clock::now();
+        if (!MeshImporter::importFile(modelPath, mesh, &stats, threads)) return false;
+        double totalMs = elapsedMs(start);
+
+        if (threads == 1) {
+            std::cout << "Mesh benchmark: " << modelPath << " ("
+                      << static_cast<double>(stats.sourceBytes) / (1024.0 * 1024.0) << " MB, "
+                      << mesh.indices.size() / 3 << " triangles, " << stats.corners << " corners welded to "
+                      << mesh.vertices.size() << " vertices)" << std::endl;
+        }
+        double triangles = static_cast<double>(mesh.indices.size() / 3);
+        std::cout << "  Import, " << std::setw(2) << threads << " thread(s): read " << stats.readMs
+                  << " ms, parse " << stats.parseMs << " ms, weld " << stats.weldMs << " ms, optimize "
+                  << stats.optimizeMs << " ms = " << totalMs << " ms ("
+                  << static_cast<double>(stats.sourceBytes) / (1024.0 * 1024.0) / (totalMs / 1000.0) << " MB/s, "
+                  << triangles / 1.0e6 / (totalMs / 1000.0) << " Mtri/s)" << std::endl;
+    }
+    std::cout << std::setprecision(3) << "  Vertex cache (ACMR, FIFO 16): " << stats.acmrBefore << " -> "
+              << stats.acmrAfter << std::setprecision(1) << std::endl;
+
+    // Chargement compilé : une lecture de l'entrée (ou une vue sur l'archive) puis les buffers GL
+    MeshCache::CompiledMesh compiled;
+    if (!MeshCache::load(modelPath, compiled)) return false;
+    std::vector<double> readMs, uploadMs;
+    Geometry geometry;
+    for (int i = 0; i < loadIterations; ++i) {
+        auto start = Clock::now();
+        MeshCache::load(modelPath, compiled);
+        readMs.push_back(elapsedMs(start));
+
+        start = Clock::now();
+        geometry.setupMesh(compiled.vertices, compiled.vertexCount, compiled.indices, compiled.indexCount,
+                           compiled.boundsCenter, compiled.boundsRadius);
+        glFinish();
+        uploadMs.push_back(elapsedMs(start));
+    }
+    PercentileSummary read = PercentileSummary::compute(readMs);
+    PercentileSummary upload = PercentileSummary::compute(uploadMs);
+    double megabytes = static_cast<double>(compiled.getByteSize()) / (1024.0 * 1024.0);
+    std::cout << std::setprecision(2) << "  Compiled load (p50 of " << loadIterations << "): read " << read.p50
+              << " ms + upload " << upload.p50 << " ms for " << megabytes << " MB ("
+              << megabytes / 1024.0 / ((read.p50 + upload.p50) / 1000.0) << " GB/s)" << std::endl;
+    return true;
+}
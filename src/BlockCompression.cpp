@@ -0,0 +1,138 @@
+#include "BlockCompression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+    std::uint16_t packRGB565(const float color[3]) {
+        int r = std::clamp(static_cast<int>(std::lround(color[0] * 31.0f / 255.0f)), 0, 31);
+        int g = std::clamp(static_cast<int>(std::lround(color[1] * 63.0f / 255.0f)), 0, 63);
+        int b = std::clamp(static_cast<int>(std::lround(color[2] * 31.0f / 255.0f)), 0, 31);
+        return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void unpackRGB565(std::uint16_t packed, int color[3]) {
+        int r = (packed >> 11) & 31;
+        int g = (packed >> 5) & 63;
+        int b = packed & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    // Un bloc de 16 texels RGB -> 8 octets
+    void compressBlock(const unsigned char texels[16][4], unsigned char* output) {
+        // Moyenne et covariance des couleurs
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 3; ++c) mean[c] += texels[i][c];
+        }
+        for (float& m : mean) m /= 16.0f;
+
+        float cov[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};   // rr rg rb gg gb bb
+        for (int i = 0; i < 16; ++i) {
+            float r = texels[i][0] - mean[0];
+            float g = texels[i][1] - mean[1];
+            float b = texels[i][2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
+
+        // Axe principal par itération de la puissance
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            float length = std::max({std::abs(x), std::abs(y), std::abs(z)});
+            if (length < 1e-6f) break;
+            axis[0] = x / length;
+            axis[1] = y / length;
+            axis[2] = z / length;
+        }
+
+        // Extrémités : projections extrêmes sur l'axe, resserrées d'1/16 (erreur moyenne plus faible)
+        float minProj = 1e30f, maxProj = -1e30f;
+        for (int i = 0; i < 16; ++i) {
+            float p = (texels[i][0] - mean[0]) * axis[0] + (texels[i][1] - mean[1]) * axis[1]
+                    + (texels[i][2] - mean[2]) * axis[2];
+            minProj = std::min(minProj, p);
+            maxProj = std::max(maxProj, p);
+        }
+        float axisLengthSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        float inset = (maxProj - minProj) / 16.0f;
+        float endpoints[2][3];
+        for (int c = 0; c < 3; ++c) {
+            float scale = axisLengthSq > 0.0f ? axis[c] / axisLengthSq : 0.0f;
+            endpoints[0][c] = std::clamp(mean[c] + (maxProj - inset) * scale, 0.0f, 255.0f);
+            endpoints[1][c] = std::clamp(mean[c] + (minProj + inset) * scale, 0.0f, 255.0f);
+        }
+
+        std::uint16_t color0 = packRGB565(endpoints[0]);
+        std::uint16_t color1 = packRGB565(endpoints[1]);
+        // color0 > color1 sélectionne le mode quatre couleurs (sans transparence)
+        if (color0 < color1) std::swap(color0, color1);
+
+        std::uint32_t indices = 0;
+        if (color0 != color1) {
+            int palette[4][3];
+            unpackRGB565(color0, palette[0]);
+            unpackRGB565(color1, palette[1]);
+            for (int c = 0; c < 3; ++c) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+            for (int i = 0; i < 16; ++i) {
+                int best = 0;
+                int bestError = 1 << 30;
+                for (int p = 0; p < 4; ++p) {
+                    int dr = texels[i][0] - palette[p][0];
+                    int dg = texels[i][1] - palette[p][1];
+                    int db = texels[i][2] - palette[p][2];
+                    int error = dr * dr + dg * dg + db * db;
+                    if (error < bestError) {
+                        bestError = error;
+                        best = p;
+                    }
+                }
+                indices |= static_cast<std::uint32_t>(best) << (2 * i);
+            }
+        }
+
+        output[0] = static_cast<unsigned char>(color0 & 0xFF);
+        output[1] = static_cast<unsigned char>(color0 >> 8);
+        output[2] = static_cast<unsigned char>(color1 & 0xFF);
+        output[3] = static_cast<unsigned char>(color1 >> 8);
+        for (int i = 0; i < 4; ++i) {
+            output[4 + i] = static_cast<unsigned char>((indices >> (8 * i)) & 0xFF);
+        }
+    }
+}
+
+namespace BlockCompression {
+    std::size_t bc1Size(int width, int height) {
+        std::size_t blocksX = (std::max(width, 1) + 3) / 4;
+        std::size_t blocksY = (std::max(height, 1) + 3) / 4;
+        return blocksX * blocksY * 8;
+    }
+
+    void compressBC1(const unsigned char* rgba, int width, int height, unsigned char* output) {
+        int blocksX = (width + 3) / 4;
+        int blocksY = (height + 3) / 4;
+        unsigned char texels[16][4];
+        for (int by = 0; by < blocksY; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx) {
+                // Bloc partiel en bord d'image : texels répétés
+                for (int y = 0; y < 4; ++y) {
+                    int sy = std::min(by * 4 + y, height - 1);
+                    for (int x = 0; x < 4; ++x) {
+                        int sx = std::min(bx * 4 + x, width - 1);
+                        const unsigned char* source = rgba + (static_cast<std::size_t>(sy) * width + sx) * 4;
+                        std::copy(source, source + 4, texels[y * 4 + x]);
+                    }
+                }
+                compressBlock(texels, output + (static_cast<std::size_t>(by) * blocksX + bx) * 8);
+            }
+        }
+    }
+}
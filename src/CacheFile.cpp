@@ -0,0 +1,47 @@
+#include "CacheFile.hpp"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    std::atomic<std::uint32_t> tempFileCounter{0};
+
+    unsigned long getProcessId() {
+#ifdef _WIN32
+        return static_cast<unsigned long>(GetCurrentProcessId());
+#else
+        return static_cast<unsigned long>(getpid());
+#endif
+    }
+}
+
+bool writeCacheFile(const std::string& path, const std::function<void(std::ostream&)>& write) {
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+    std::string tempPath = path + "." + std::to_string(getProcessId()) + "." +
+                           std::to_string(tempFileCounter.fetch_add(1)) + ".tmp";
+    bool written;
+    {
+        std::ofstream file(tempPath, std::ios::binary);
+        if (!file) return false;
+        write(file);
+        written = static_cast<bool>(file.flush());
+    }
+
+    if (written) {
+        std::filesystem::rename(tempPath, path, error);
+        if (!error) return true;
+    }
+    std::filesystem::remove(tempPath, error);
+    return false;
+}
@@ -25,7 +25,7 @@ glm::mat4 Camera::getViewMatrix() const
 
 glm::mat4 Camera::getProjectionMatrix(float aspectRatio) const
 {
-    return glm::perspective(glm::radians(zoom), aspectRatio, 0.1f, 100.0f);
+    return glm::perspective(glm::radians(zoom), aspectRatio, NEAR_PLANE, FAR_PLANE);
 }
 
 void Camera::processKeyboard(CameraMovement direction, float deltaTime)
@@ -93,6 +93,14 @@ void Camera::setTarget(const glm::vec3& target)
     updateCameraVectors();
 }
 
+void Camera::setOrientation(float newYaw, float newPitch)
+{
+    yaw = newYaw;
+    pitch = std::clamp(newPitch, -89.0f, 89.0f);
+
+    updateCameraVectors();
+}
+
 void Camera::setMovementSpeed(float speed)
 {
     movementSpeed = speed;
@@ -143,6 +151,16 @@ float Camera::getPitch() const
     return pitch;
 }
 
+float Camera::getNearPlane() const
+{
+    return NEAR_PLANE;
+}
+
+float Camera::getFarPlane() const
+{
+    return FAR_PLANE;
+}
+
 void Camera::reset()
 {
     position = glm::vec3(0.0f, 0.0f, 3.0f);
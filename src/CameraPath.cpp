@@ -0,0 +1,82 @@
+#include "CameraPath.hpp"
+#include "Camera.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool CameraPath::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open camera path: " << path << std::endl;
+        return false;
+    }
+
+    keyframes.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream stream(line);
+        Keyframe key;
+        if (stream >> key.time >> key.position.x >> key.position.y >> key.position.z >> key.yaw >> key.pitch) {
+            keyframes.push_back(key);
+        }
+    }
+
+    // Les keyframes doivent être triées par temps pour l'interpolation
+    std::sort(keyframes.begin(), keyframes.end(),
+              [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+
+    if (keyframes.empty()) {
+        std::cerr << "Camera path has no keyframes: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CameraPath::save(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to write camera path: " << path << std::endl;
+        return false;
+    }
+
+    file << "# time posX posY posZ yaw pitch\n";
+    for (const auto& key : keyframes) {
+        file << key.time << " " << key.position.x << " " << key.position.y << " " << key.position.z
+             << " " << key.yaw << " " << key.pitch << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+void CameraPath::record(float time, const Camera& camera) {
+    keyframes.push_back({time, camera.getPosition(), camera.getYaw(), camera.getPitch()});
+}
+
+void CameraPath::apply(float time, Camera& camera) const {
+    if (keyframes.empty()) return;
+
+    float duration = getDuration();
+    if (duration > 0.0f) {
+        time = std::fmod(time, duration);
+    }
+
+    // Première keyframe dont le temps dépasse t
+    auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+                                 [](float t, const Keyframe& key) { return t < key.time; });
+    if (next == keyframes.begin() || next == keyframes.end()) {
+        const Keyframe& key = (next == keyframes.end()) ? keyframes.back() : keyframes.front();
+        camera.setPosition(key.position);
+        camera.setOrientation(key.yaw, key.pitch);
+        return;
+    }
+
+    const Keyframe& a = *(next - 1);
+    const Keyframe& b = *next;
+    float t = (time - a.time) / (b.time - a.time);
+
+    camera.setPosition(glm::mix(a.position, b.position, t));
+    camera.setOrientation(a.yaw + (b.yaw - a.yaw) * t, a.pitch + (b.pitch - a.pitch) * t);
+}
@@ -0,0 +1,470 @@
+#include "CascadedShadowMap.hpp"
+#include "GLState.hpp"
+#include "Hash.hpp"
+#include "ResourceManager.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    // Noms des uniformes, construits une seule fois
+    struct CascadeUniformNames {
+        std::string matrix;
+        std::string params;
+    };
+
+    const CascadeUniformNames& uniformNames(int cascade) {
+        static const std::array<CascadeUniformNames, CascadedShadowMap::MAX_CASCADES> names = [] {
+            std::array<CascadeUniformNames, CascadedShadowMap::MAX_CASCADES> table;
+            for (int i = 0; i < CascadedShadowMap::MAX_CASCADES; ++i) {
+                std::string index = "[" + std::to_string(i) + "]";
+                table[i] = {"cascadeMatrices" + index, "cascadeParams" + index};
+            }
+            return table;
+        }();
+        return names[cascade];
+    }
+}
+
+namespace {
+    // Octets des textures, pour ResourceManager
+    std::int64_t getDepthArrayBytes(int resolution) {
+        return static_cast<std::int64_t>(resolution) * resolution * sizeof(float) * CascadedShadowMap::MAX_CASCADES;
+    }
+
+    std::int64_t getMomentsArrayBytes(int resolution, int layers) {
+        std::int64_t bytes = 0;
+        for (int size = resolution; size > 0; size >>= 1) {
+            bytes += static_cast<std::int64_t>(size) * size * 2 * sizeof(float) * layers;
+        }
+        return bytes;
+    }
+
+    // Texture de profondeur 2D array et un framebuffer par couche
+    GLuint createDepthArray(int resolution, GLuint* framebuffers) {
+        GLuint texture;
+        glGenTextures(1, &texture);
+        GLState::bindTexture(0, GL_TEXTURE_2D_ARRAY, texture);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, resolution, resolution,
+                     CascadedShadowMap::MAX_CASCADES, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+        // Un framebuffer par couche : pas de réattachement pendant la passe d'ombre
+        glGenFramebuffers(CascadedShadowMap::MAX_CASCADES, framebuffers);
+        for (int i = 0; i < CascadedShadowMap::MAX_CASCADES; ++i) {
+            GLState::bindFramebuffer(framebuffers[i]);
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, i);
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+                std::cerr << "ERROR::CASCADED_SHADOW_MAP: framebuffer " << i << " incomplete" << std::endl;
+            }
+        }
+        GLState::bindFramebuffer(0);
+        ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, getDepthArrayBytes(resolution));
+        return texture;
+    }
+
+    // Moments (profondeur, profondeur²) mipmappés et un framebuffer couleur par couche
+    GLuint createMomentsArray(int resolution, int layers, GLuint* framebuffers) {
+        int levels = 1;
+        while ((resolution >> levels) > 0) ++levels;
+
+        GLuint texture;
+        glGenTextures(1, &texture);
+        GLState::bindTexture(0, GL_TEXTURE_2D_ARRAY, texture);
+        for (int level = 0; level < levels; ++level) {
+            int size = std::max(1, resolution >> level);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RG32F, size, size, layers, 0, GL_RG, GL_FLOAT, NULL);
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        // Hors de la cascade : moyenne 1, variance nulle -> éclairé
+        float borderMoments[] = { 1.0f, 1.0f, 0.0f, 0.0f };
+        glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderMoments);
+
+        glGenFramebuffers(layers, framebuffers);
+        for (int i = 0; i < layers; ++i) {
+            GLState::bindFramebuffer(framebuffers[i]);
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture, 0, i);
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+                std::cerr << "ERROR::CASCADED_SHADOW_MAP: moments framebuffer " << i << " incomplete" << std::endl;
+            }
+        }
+        GLState::bindFramebuffer(0);
+        ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, getMomentsArrayBytes(resolution, layers));
+        return texture;
+    }
+
+    void deleteDepthArray(GLuint texture, GLuint* framebuffers) {
+        for (int i = 0; i < CascadedShadowMap::MAX_CASCADES; ++i) {
+            GLState::forgetFramebuffer(framebuffers[i]);
+        }
+        GLState::forgetTexture(texture);
+        glDeleteFramebuffers(CascadedShadowMap::MAX_CASCADES, framebuffers);
+        glDeleteTextures(1, &texture);
+    }
+
+    // Hash des casters statiques : change si l'un d'eux est ajouté, retiré ou déplacé
+    std::uint64_t hashStaticCasters(const RenderList& casters) {
+        std::uint64_t hash = FNV_OFFSET_BASIS;
+        for (const DrawItem& item : casters) {
+            if (!item.isStatic) continue;
+            hash = hashBytes(&item.geometry, sizeof(item.geometry), hash);
+            hash = hashBytes(&item.model, sizeof(item.model), hash);
+        }
+        return hash;
+    }
+}
+
+CascadedShadowMap::CascadedShadowMap(int resolution)
+    : resolution(resolution), cascadeCount(0), depthTexture(0), framebuffers{},
+      staticTexture(0), staticFramebuffers{}, compareSampler(0), momentsTexture(0), momentsFramebuffers{},
+      blurTexture(0), blurFramebuffer(0), fullscreenVertexArray(0), momentsBlurRadius(-1),
+      cachingEnabled(false), staticCasterHash(0), staticRefreshCount(0), reusedCascadeCount(0) {
+
+    depthTexture = createDepthArray(resolution, framebuffers);
+    staticTexture = createDepthArray(resolution, staticFramebuffers);
+
+    // PCF matériel : même texture, comparaison et filtrage bilinéaire faits par le sampler
+    glGenSamplers(1, &compareSampler);
+    glSamplerParameteri(compareSampler, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glSamplerParameteri(compareSampler, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glSamplerParameteri(compareSampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glSamplerParameteri(compareSampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glSamplerParameteri(compareSampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glSamplerParameteri(compareSampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    float borderDepth[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    glSamplerParameterfv(compareSampler, GL_TEXTURE_BORDER_COLOR, borderDepth);
+
+    for (int i = 0; i < MAX_CASCADES; ++i) {
+        matrices[i] = glm::mat4(1.0f);
+        splitDistances[i] = 0.0f;
+        texelSizes[i] = 0.0f;
+        depthRanges[i] = 1.0f;
+        staticValid[i] = false;
+        staticHasContent[i] = false;
+        staticRefreshScheduled[i] = false;
+        staleFrames[i] = 0;
+        liveValid[i] = false;
+        momentsValid[i] = false;
+    }
+}
+
+CascadedShadowMap::~CascadedShadowMap() {
+    deleteDepthArray(depthTexture, framebuffers);
+    deleteDepthArray(staticTexture, staticFramebuffers);
+    ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, -getDepthArrayBytes(resolution));
+    ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, -getDepthArrayBytes(resolution));
+    GLState::forgetSampler(compareSampler);
+    glDeleteSamplers(1, &compareSampler);
+
+    if (momentsTexture != 0) {
+        deleteDepthArray(momentsTexture, momentsFramebuffers);
+        GLState::forgetFramebuffer(blurFramebuffer);
+        GLState::forgetTexture(blurTexture);
+        GLState::forgetVertexArray(fullscreenVertexArray);
+        glDeleteFramebuffers(1, &blurFramebuffer);
+        glDeleteTextures(1, &blurTexture);
+        glDeleteVertexArrays(1, &fullscreenVertexArray);
+        ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, -getMomentsArrayBytes(resolution, MAX_CASCADES));
+        ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, -getMomentsArrayBytes(resolution, 1));
+    }
+}
+
+void CascadedShadowMap::update(const Camera& camera, float aspectRatio, const glm::vec3& lightDirection,
+                               const RenderList& casters, const ShadowSettings& settings) {
+    TRACE_SCOPE("CascadedShadowMap::update");
+
+    int requestedCount = std::clamp(settings.cascadeCount, 1, MAX_CASCADES);
+    float nearPlane = camera.getNearPlane();
+    float farPlane = std::min(camera.getFarPlane(), settings.maxDistance);
+
+    // Changement de configuration : tout le cache repart de zéro
+    if (requestedCount != cascadeCount || settings.cacheStaticShadows != cachingEnabled) {
+        for (int i = 0; i < MAX_CASCADES; ++i) {
+            staticValid[i] = false;
+            staticHasContent[i] = false;
+            liveValid[i] = false;
+            staleFrames[i] = 0;
+        }
+    }
+    cascadeCount = requestedCount;
+    cachingEnabled = settings.cacheStaticShadows;
+
+    std::uint64_t casterHash = hashStaticCasters(casters);
+    if (casterHash != staticCasterHash) {
+        staticCasterHash = casterHash;
+        for (bool& valid : staticValid) {
+            valid = false;
+        }
+    }
+
+    // Practical split scheme : C_i = lambda * C_log + (1 - lambda) * C_uni
+    for (int i = 0; i < cascadeCount; ++i) {
+        float p = static_cast<float>(i + 1) / static_cast<float>(cascadeCount);
+        float logSplit = nearPlane * std::pow(farPlane / nearPlane, p);
+        float uniformSplit = nearPlane + (farPlane - nearPlane) * p;
+        splitDistances[i] = settings.splitLambda * logSplit + (1.0f - settings.splitLambda) * uniformSplit;
+    }
+
+    glm::mat4 inverseView = glm::inverse(camera.getViewMatrix());
+    float tanHalfFovY = std::tan(glm::radians(camera.getZoom()) * 0.5f);
+    float tanHalfFovX = tanHalfFovY * aspectRatio;
+    glm::vec3 direction = glm::normalize(lightDirection);
+
+    struct Candidate {
+        int cascade;
+        float priority;
+        glm::mat4 matrix;
+        float texelSize;
+        float depthRange;
+    };
+    Candidate candidates[MAX_CASCADES];
+    int candidateCount = 0;
+
+    float sliceNear = nearPlane;
+    for (int i = 0; i < cascadeCount; ++i) {
+        float sliceFar = splitDistances[i];
+        staticRefreshScheduled[i] = false;
+
+        Candidate candidate;
+        candidate.cascade = i;
+        fitCascade(sliceNear, sliceFar, inverseView, tanHalfFovX, tanHalfFovY, direction, casters,
+                   candidate.matrix, candidate.texelSize, candidate.depthRange);
+
+        if (!cachingEnabled) {
+            matrices[i] = candidate.matrix;
+            texelSizes[i] = candidate.texelSize;
+            depthRanges[i] = candidate.depthRange;
+        } else if (!staticValid[i] || candidate.matrix != matrices[i]) {
+            // Contribution à l'écran : part de la profondeur NDC couverte par la tranche,
+            // multipliée par l'attente pour qu'aucune cascade ne soit oubliée
+            float coverage = (1.0f / sliceNear - 1.0f / sliceFar) / (1.0f / nearPlane - 1.0f / farPlane);
+            candidate.priority = coverage * static_cast<float>(1 + staleFrames[i]);
+            // Une couche jamais rendue passe avant tout le reste
+            if (!staticHasContent[i]) {
+                candidate.priority += 1000.0f;
+            }
+            candidates[candidateCount++] = candidate;
+        }
+
+        // La cascade suivante recouvre la bande de fondu de celle-ci
+        sliceNear = sliceFar - settings.blendBand * (sliceFar - sliceNear);
+    }
+
+    // Couches statiques servies par ordre de priorité, dans la limite du budget (0 = illimité)
+    std::sort(candidates, candidates + candidateCount,
+              [](const Candidate& a, const Candidate& b) { return a.priority > b.priority; });
+    int budget = settings.staticUpdateBudget > 0 ? settings.staticUpdateBudget : MAX_CASCADES;
+    for (int c = 0; c < candidateCount; ++c) {
+        int i = candidates[c].cascade;
+        if (c < budget || !staticHasContent[i]) {
+            matrices[i] = candidates[c].matrix;
+            texelSizes[i] = candidates[c].texelSize;
+            depthRanges[i] = candidates[c].depthRange;
+            staticRefreshScheduled[i] = true;
+            staleFrames[i] = 0;
+            liveValid[i] = false;
+        } else {
+            ++staleFrames[i];
+        }
+    }
+
+    staticRefreshCount = 0;
+    reusedCascadeCount = 0;
+}
+
+void CascadedShadowMap::fitCascade(float sliceNear, float sliceFar, const glm::mat4& inverseView,
+                                   float tanHalfFovX, float tanHalfFovY, const glm::vec3& direction,
+                                   const RenderList& casters, glm::mat4& matrix, float& texelSize,
+                                   float& depthRange) const {
+    // Coins de la tranche de frustum en espace monde
+    glm::vec3 corners[8];
+    glm::vec3 center(0.0f);
+    for (int c = 0; c < 8; ++c) {
+        float depth = (c & 4) ? sliceFar : sliceNear;
+        float x = ((c & 1) ? 1.0f : -1.0f) * tanHalfFovX * depth;
+        float y = ((c & 2) ? 1.0f : -1.0f) * tanHalfFovY * depth;
+        corners[c] = glm::vec3(inverseView * glm::vec4(x, y, -depth, 1.0f));
+        center += corners[c];
+    }
+    center /= 8.0f;
+
+    // Sphère englobante : taille indépendante de l'orientation de la caméra
+    float radius = 0.0f;
+    for (const glm::vec3& corner : corners) {
+        radius = std::max(radius, glm::length(corner - center));
+    }
+    radius = std::ceil(radius * 16.0f) / 16.0f;
+
+    glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::mat4 lightView = glm::lookAt(center - direction * radius, center, up);
+
+    // Casters entre la lumière et la tranche : le plan near est reculé pour les inclure.
+    // Le recul est arrondi par paliers pour que les casters dynamiques ne changent pas la
+    // projection à chaque frame (ce qui invaliderait la couche statique).
+    float casterNear = 0.0f;
+    for (const DrawItem& item : casters) {
+        glm::vec3 lightSpaceCenter = glm::vec3(lightView * glm::vec4(item.center, 1.0f));
+        if (std::abs(lightSpaceCenter.x) > radius + item.radius ||
+            std::abs(lightSpaceCenter.y) > radius + item.radius) {
+            continue;
+        }
+        casterNear = std::min(casterNear, -lightSpaceCenter.z - item.radius);
+    }
+    float nearStep = 0.5f * radius;
+    casterNear = std::floor(casterNear / nearStep) * nearStep;
+    float farDepth = 2.0f * radius;
+
+    glm::mat4 lightProjection = glm::ortho(-radius, radius, -radius, radius, casterNear, farDepth);
+
+    // Alignement sur la grille des texels : l'origine du monde tombe sur un texel entier
+    glm::vec4 origin = lightProjection * lightView * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    glm::vec2 originTexels = glm::vec2(origin) * (resolution * 0.5f);
+    glm::vec2 offset = (glm::round(originTexels) - originTexels) * (2.0f / resolution);
+    lightProjection[3][0] += offset.x;
+    lightProjection[3][1] += offset.y;
+
+    matrix = lightProjection * lightView;
+    texelSize = 2.0f * radius / resolution;
+    depthRange = farDepth - casterNear;
+}
+
+void CascadedShadowMap::beginStaticLayer(int cascade) {
+    GLState::bindFramebuffer(staticFramebuffers[cascade]);
+    GLState::setViewport(0, 0, resolution, resolution);
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    staticValid[cascade] = true;
+    staticHasContent[cascade] = true;
+    ++staticRefreshCount;
+}
+
+bool CascadedShadowMap::beginCascade(int cascade, bool hasDynamicCasters) {
+    if (!cachingEnabled) {
+        GLState::bindFramebuffer(framebuffers[cascade]);
+        GLState::setViewport(0, 0, resolution, resolution);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        momentsValid[cascade] = false;
+        return true;
+    }
+
+    // Ni la couche statique ni les casters dynamiques n'ont changé depuis la dernière composition
+    if (liveValid[cascade] && !hasDynamicCasters) {
+        ++reusedCascadeCount;
+        return false;
+    }
+
+    // Copie de la couche statique, les casters dynamiques sont dessinés par-dessus
+    GLState::bindFramebuffer(framebuffers[cascade]);
+    GLState::setViewport(0, 0, resolution, resolution);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, staticFramebuffers[cascade]);
+    glBlitFramebuffer(0, 0, resolution, resolution, 0, 0, resolution, resolution,
+                      GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[cascade]);
+
+    liveValid[cascade] = !hasDynamicCasters;
+    momentsValid[cascade] = false;
+    return true;
+}
+
+int CascadedShadowMap::prefilterMoments(Shader& blurShader, const ShadowSettings& settings) {
+    TRACE_SCOPE("CascadedShadowMap::prefilterMoments");
+
+    if (momentsTexture == 0) {
+        momentsTexture = createMomentsArray(resolution, MAX_CASCADES, momentsFramebuffers);
+        GLuint blurFramebuffers[1];
+        blurTexture = createMomentsArray(resolution, 1, blurFramebuffers);
+        blurFramebuffer = blurFramebuffers[0];
+        glGenVertexArrays(1, &fullscreenVertexArray);
+    }
+    if (settings.vsmBlurRadius != momentsBlurRadius) {
+        momentsBlurRadius = settings.vsmBlurRadius;
+        for (bool& valid : momentsValid) {
+            valid = false;
+        }
+    }
+
+    blurShader.use();
+    blurShader.setUniform("source", 0);
+    blurShader.setUniform("blurRadius", momentsBlurRadius);
+    GLState::bindVertexArray(fullscreenVertexArray);
+    GLState::setViewport(0, 0, resolution, resolution);
+    GLState::setDepthMask(false);
+
+    int filtered = 0;
+    for (int i = 0; i < cascadeCount; ++i) {
+        if (momentsValid[i]) continue;
+
+        // Horizontale : profondeur de la cascade -> moments floutés dans la texture intermédiaire
+        GLState::bindFramebuffer(blurFramebuffer);
+        GLState::bindTexture(0, GL_TEXTURE_2D_ARRAY, depthTexture);
+        blurShader.setUniform("sourceLayer", i);
+        blurShader.setUniform("sourceIsDepth", true);
+        blurShader.setUniform("blurDirection", glm::vec2(1.0f, 0.0f));
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+
+        // Verticale : texture intermédiaire -> couche de moments de la cascade
+        GLState::bindFramebuffer(momentsFramebuffers[i]);
+        GLState::bindTexture(0, GL_TEXTURE_2D_ARRAY, blurTexture);
+        blurShader.setUniform("sourceLayer", 0);
+        blurShader.setUniform("sourceIsDepth", false);
+        blurShader.setUniform("blurDirection", glm::vec2(0.0f, 1.0f));
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+
+        momentsValid[i] = true;
+        ++filtered;
+    }
+    GLState::setDepthMask(true);
+
+    // Les mips sont régénérées pour toutes les couches : une seule fois par frame
+    if (filtered > 0) {
+        GLState::bindTexture(0, GL_TEXTURE_2D_ARRAY, momentsTexture);
+        GLState::setActiveTexture(0);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    }
+    return filtered;
+}
+
+void CascadedShadowMap::applyUniforms(Shader& shader, int depthUnit, int filterUnit, const ShadowSettings& settings) const {
+    GLState::bindTexture(depthUnit, GL_TEXTURE_2D_ARRAY, depthTexture);
+    shader.setUniform("shadowMap", depthUnit);
+
+    switch (settings.filter) {
+        case ShadowFilter::HARDWARE_PCF:
+            GLState::bindTexture(filterUnit, GL_TEXTURE_2D_ARRAY, depthTexture);
+            GLState::bindSampler(filterUnit, compareSampler);
+            shader.setUniform("shadowMapCompare", filterUnit);
+            break;
+        case ShadowFilter::VSM:
+            GLState::bindTexture(filterUnit, GL_TEXTURE_2D_ARRAY, momentsTexture);
+            GLState::bindSampler(filterUnit, 0);
+            shader.setUniform("shadowMoments", filterUnit);
+            shader.setUniform("vsmBleedReduction", settings.vsmBleedReduction);
+            break;
+        default:
+            GLState::bindSampler(filterUnit, 0);
+            break;
+    }
+    shader.setUniform("cascadeCount", cascadeCount);
+    shader.setUniform("cascadeBlendBand", settings.blendBand);
+    shader.setUniform("showCascades", settings.showCascades);
+
+    for (int i = 0; i < cascadeCount; ++i) {
+        const CascadeUniformNames& names = uniformNames(i);
+        shader.setUniform(names.matrix.c_str(), matrices[i]);
+        shader.setUniform(names.params.c_str(), splitDistances[i], texelSizes[i], depthRanges[i], 0.0f);
+    }
+}
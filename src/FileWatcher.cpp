@@ -0,0 +1,103 @@
+#include "FileWatcher.hpp"
+#include "Trace.hpp"
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::FileWatcher() : inotifyFd(-1), stopping(false) {
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        std::cerr << "FileWatcher: inotify_init1 failed, hot reload disabled" << std::endl;
+    }
+#else
+    std::cerr << "FileWatcher: not supported on this platform, hot reload disabled" << std::endl;
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+    stopping = true;
+    if (thread.joinable()) {
+        thread.join();
+    }
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+    }
+#endif
+}
+
+bool FileWatcher::watchDirectory(const std::string& directory) {
+#ifdef __linux__
+    if (inotifyFd < 0) return false;
+
+    // Les éditeurs écrivent en place (CLOSE_WRITE) ou via un fichier temporaire renommé (MOVED_TO)
+    int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        std::cerr << "FileWatcher: cannot watch " << directory << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        watchedDirectories[wd] = directory;
+    }
+    if (!thread.joinable()) {
+        thread = std::thread(&FileWatcher::threadLoop, this);
+    }
+    return true;
+#else
+    (void)directory;
+    return false;
+#endif
+}
+
+std::vector<std::string> FileWatcher::takeChanges(std::chrono::milliseconds debounce) {
+    std::vector<std::string> ready;
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = changes.begin(); it != changes.end();) {
+        if (now - it->second >= debounce) {
+            ready.push_back(it->first);
+            it = changes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return ready;
+}
+
+void FileWatcher::threadLoop() {
+#ifdef __linux__
+    TRACE_THREAD_NAME("file_watcher");
+
+    alignas(inotify_event) char buffer[4096];
+    pollfd descriptor = {inotifyFd, POLLIN, 0};
+
+    while (!stopping) {
+        // Timeout court pour pouvoir s'arrêter sans signal supplémentaire
+        if (poll(&descriptor, 1, 100) <= 0) continue;
+
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) continue;
+
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex);
+        for (char* ptr = buffer; ptr < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+            auto directory = watchedDirectories.find(event->wd);
+            if (event->len > 0 && directory != watchedDirectories.end()) {
+                std::filesystem::path path = std::filesystem::path(directory->second) / event->name;
+                changes[std::filesystem::weakly_canonical(path).string()] = now;
+            }
+            ptr += sizeof(inotify_event) + event->len;
+        }
+    }
+#endif
+}
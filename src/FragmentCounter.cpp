@@ -0,0 +1,80 @@
+#include "FragmentCounter.hpp"
+
+FragmentCounter::FragmentCounter() : current(nullptr), active(false) {
+    // GL_SAMPLES_PASSED fait partie du cœur depuis OpenGL 1.5
+    for (auto& frame : frames) {
+        glGenQueries(FRAGMENT_PASS_COUNT, frame.queries.data());
+    }
+}
+
+FragmentCounter::~FragmentCounter() {
+    for (auto& frame : frames) {
+        glDeleteQueries(FRAGMENT_PASS_COUNT, frame.queries.data());
+    }
+}
+
+bool FragmentCounter::collect() {
+    // Frame en attente la plus ancienne
+    FrameQueries* oldest = nullptr;
+    for (auto& frame : frames) {
+        if (frame.pending && (!oldest || frame.frameIndex < oldest->frameIndex)) {
+            oldest = &frame;
+        }
+    }
+    return oldest && resolve(*oldest);
+}
+
+void FragmentCounter::beginFrame(int frameIndex) {
+    // Le slot de cette frame est réutilisé : s'il n'a toujours pas été relu, il est abandonné
+    current = &frames[frameIndex % FRAME_LATENCY];
+    current->measured.fill(false);
+    current->frameIndex = frameIndex;
+    current->pending = false;
+}
+
+void FragmentCounter::endFrame() {
+    if (!current) return;
+
+    if (active) {
+        end();
+    }
+    current->pending = true;
+    current = nullptr;
+}
+
+void FragmentCounter::begin(FragmentPass pass) {
+    if (!current || active) return;
+
+    int index = static_cast<int>(pass);
+    glBeginQuery(GL_SAMPLES_PASSED, current->queries[index]);
+    current->measured[index] = true;
+    active = true;
+}
+
+void FragmentCounter::end() {
+    if (!active) return;
+
+    glEndQuery(GL_SAMPLES_PASSED);
+    active = false;
+}
+
+bool FragmentCounter::resolve(FrameQueries& frame) {
+    for (int pass = 0; pass < FRAGMENT_PASS_COUNT; ++pass) {
+        if (!frame.measured[pass]) continue;
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[pass], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return false;
+    }
+
+    for (int pass = 0; pass < FRAGMENT_PASS_COUNT; ++pass) {
+        GLuint64 fragments = 0;
+        if (frame.measured[pass]) {
+            glGetQueryObjectui64v(frame.queries[pass], GL_QUERY_RESULT, &fragments);
+        }
+        resolvedFragments[pass] = fragments;
+        resolvedMeasured[pass] = frame.measured[pass];
+    }
+
+    frame.pending = false;
+    return true;
+}
@@ -0,0 +1,42 @@
+#include "FrameArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(std::size_t capacity)
+    : buffer(new std::byte[capacity]), capacity(capacity), offset(0), highWater(0), overflowBytes(0),
+      overflow(std::pmr::new_delete_resource()) {}
+
+void FrameArena::reset() {
+    if (overflowBytes > 0) {
+        // La frame n'a pas tenu dans le buffer : on l'agrandit une fois pour toutes
+        overflow.release();
+        capacity = std::max(capacity * 2, offset + overflowBytes);
+        buffer.reset(new std::byte[capacity]);
+        overflowBytes = 0;
+    }
+    offset = 0;
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.get());
+    std::uintptr_t current = base + offset;
+    std::uintptr_t aligned = (current + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    std::size_t newOffset = static_cast<std::size_t>(aligned - base) + bytes;
+
+    if (newOffset > capacity) {
+        overflowBytes += bytes + alignment;
+        return overflow.allocate(bytes, alignment);
+    }
+
+    offset = newOffset;
+    highWater = std::max(highWater, offset);
+    return reinterpret_cast<void*>(aligned);
+}
+
+void FrameArena::do_deallocate(void*, std::size_t, std::size_t) {
+    // Rien à faire : la mémoire est récupérée en bloc par reset()
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,38 @@
+#include "Frustum.hpp"
+
+Frustum::Frustum() {
+    for (auto& plane : planes) {
+        plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);  // Accepte tout
+    }
+}
+
+Frustum::Frustum(const glm::mat4& m) {
+    // Lignes de la matrice (GLM est column-major)
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    planes[0] = row3 + row0;  // left
+    planes[1] = row3 - row0;  // right
+    planes[2] = row3 + row1;  // bottom
+    planes[3] = row3 - row1;  // top
+    planes[4] = row3 + row2;  // near
+    planes[5] = row3 - row2;  // far
+
+    for (auto& plane : planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+    for (const auto& plane : planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
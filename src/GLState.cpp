@@ -0,0 +1,266 @@
+#include "GLState.hpp"
+
+namespace {
+    const GLuint UNKNOWN = ~0u;
+
+    // Cibles de texture suivies par unité
+    enum TextureTarget { TARGET_2D, TARGET_2D_ARRAY, TARGET_CUBE_MAP, TARGET_COUNT };
+
+    int textureTargetIndex(GLenum target) {
+        switch (target) {
+            case GL_TEXTURE_2D:       return TARGET_2D;
+            case GL_TEXTURE_2D_ARRAY: return TARGET_2D_ARRAY;
+            case GL_TEXTURE_CUBE_MAP: return TARGET_CUBE_MAP;
+            default:                  return -1;
+        }
+    }
+
+    // Capacités glEnable/glDisable suivies
+    enum Capability { CAP_DEPTH_TEST, CAP_CULL_FACE, CAP_BLEND, CAP_SCISSOR_TEST, CAP_COUNT };
+
+    int capabilityIndex(GLenum capability) {
+        switch (capability) {
+            case GL_DEPTH_TEST:   return CAP_DEPTH_TEST;
+            case GL_CULL_FACE:    return CAP_CULL_FACE;
+            case GL_BLEND:        return CAP_BLEND;
+            case GL_SCISSOR_TEST: return CAP_SCISSOR_TEST;
+            default:              return -1;
+        }
+    }
+
+    struct State {
+        GLuint program;
+        GLuint vertexArray;
+        GLuint framebuffer;
+        GLuint activeUnit;
+        GLuint textures[GLState::MAX_TEXTURE_UNITS][TARGET_COUNT];
+        GLuint samplers[GLState::MAX_TEXTURE_UNITS];
+        GLint viewport[4];
+        GLint scissor[4];
+        GLuint capabilities[CAP_COUNT];     // 0, 1 ou UNKNOWN
+        GLuint depthFunc;
+        GLuint depthMask;
+        GLuint colorMask;
+        GLuint cullFace;
+        GLuint polygonMode;
+    };
+
+    State state;
+    GLState::Counters counters;
+    bool initialized = false;
+
+    void ensureInitialized() {
+        if (!initialized) {
+            GLState::invalidate();
+        }
+    }
+
+    // Compare et met à jour une valeur suivie ; true si l'appel doit être transmis
+    bool changed(GLuint& current, GLuint value) {
+        ensureInitialized();
+        if (current == value) {
+            ++counters.filtered;
+            return false;
+        }
+        current = value;
+        ++counters.issued;
+        return true;
+    }
+}
+
+void GLState::useProgram(GLuint program) {
+    if (changed(state.program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void GLState::bindVertexArray(GLuint vao) {
+    if (changed(state.vertexArray, vao)) {
+        glBindVertexArray(vao);
+    }
+}
+
+void GLState::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+    int targetIndex = textureTargetIndex(target);
+    if (targetIndex < 0 || unit >= MAX_TEXTURE_UNITS) {
+        // Cible ou unité non suivie : appel direct, sans cache de la texture liée ; l'unité active
+        // reste connue (glActiveTexture vient d'être émis)
+        ensureInitialized();
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, texture);
+        state.activeUnit = unit;
+        counters.issued += 2;
+        return;
+    }
+
+    if (!changed(state.textures[unit][targetIndex], texture)) return;
+
+    if (state.activeUnit != unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        state.activeUnit = unit;
+        ++counters.issued;
+    }
+    glBindTexture(target, texture);
+}
+
+void GLState::bindSampler(GLuint unit, GLuint sampler) {
+    if (unit >= MAX_TEXTURE_UNITS) {
+        ensureInitialized();
+        glBindSampler(unit, sampler);
+        ++counters.issued;
+        return;
+    }
+    if (changed(state.samplers[unit], sampler)) {
+        glBindSampler(unit, sampler);
+    }
+}
+
+void GLState::setActiveTexture(GLuint unit) {
+    if (changed(state.activeUnit, unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+}
+
+void GLState::bindFramebuffer(GLuint framebuffer) {
+    if (changed(state.framebuffer, framebuffer)) {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    }
+}
+
+void GLState::setViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    ensureInitialized();
+    if (state.viewport[0] == x && state.viewport[1] == y &&
+        state.viewport[2] == width && state.viewport[3] == height) {
+        ++counters.filtered;
+        return;
+    }
+    state.viewport[0] = x;
+    state.viewport[1] = y;
+    state.viewport[2] = width;
+    state.viewport[3] = height;
+    ++counters.issued;
+    glViewport(x, y, width, height);
+}
+
+void GLState::setScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    ensureInitialized();
+    if (state.scissor[0] == x && state.scissor[1] == y &&
+        state.scissor[2] == width && state.scissor[3] == height) {
+        ++counters.filtered;
+        return;
+    }
+    state.scissor[0] = x;
+    state.scissor[1] = y;
+    state.scissor[2] = width;
+    state.scissor[3] = height;
+    ++counters.issued;
+    glScissor(x, y, width, height);
+}
+
+void GLState::setEnabled(GLenum capability, bool enabled) {
+    int index = capabilityIndex(capability);
+    if (index >= 0 && !changed(state.capabilities[index], enabled ? 1u : 0u)) return;
+    if (index < 0) ++counters.issued;
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+void GLState::setDepthFunc(GLenum func) {
+    if (changed(state.depthFunc, func)) {
+        glDepthFunc(func);
+    }
+}
+
+void GLState::setDepthMask(bool writeEnabled) {
+    if (changed(state.depthMask, writeEnabled ? 1u : 0u)) {
+        glDepthMask(writeEnabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+void GLState::setColorMask(bool writeEnabled) {
+    if (changed(state.colorMask, writeEnabled ? 1u : 0u)) {
+        GLboolean mask = writeEnabled ? GL_TRUE : GL_FALSE;
+        glColorMask(mask, mask, mask, mask);
+    }
+}
+
+void GLState::setCullFace(GLenum face) {
+    if (changed(state.cullFace, face)) {
+        glCullFace(face);
+    }
+}
+
+void GLState::setPolygonMode(GLenum mode) {
+    if (changed(state.polygonMode, mode)) {
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+    }
+}
+
+void GLState::forgetProgram(GLuint program) {
+    if (state.program == program) state.program = UNKNOWN;
+}
+
+void GLState::forgetVertexArray(GLuint vao) {
+    // Supprimer le VAO lié revient à lier 0
+    if (state.vertexArray == vao) state.vertexArray = 0;
+}
+
+void GLState::forgetTexture(GLuint texture) {
+    // Une texture supprimée est déliée de toutes les unités
+    for (auto& unit : state.textures) {
+        for (GLuint& bound : unit) {
+            if (bound == texture) bound = 0;
+        }
+    }
+}
+
+void GLState::forgetSampler(GLuint sampler) {
+    // Un sampler supprimé est délié de toutes les unités
+    for (GLuint& bound : state.samplers) {
+        if (bound == sampler) bound = 0;
+    }
+}
+
+void GLState::forgetFramebuffer(GLuint framebuffer) {
+    if (state.framebuffer == framebuffer) state.framebuffer = 0;
+}
+
+void GLState::invalidate() {
+    state.program = UNKNOWN;
+    state.vertexArray = UNKNOWN;
+    state.framebuffer = UNKNOWN;
+    state.activeUnit = UNKNOWN;
+    for (auto& unit : state.textures) {
+        for (GLuint& bound : unit) {
+            bound = UNKNOWN;
+        }
+    }
+    for (GLuint& sampler : state.samplers) {
+        sampler = UNKNOWN;
+    }
+    state.viewport[0] = state.viewport[1] = -1;
+    state.viewport[2] = state.viewport[3] = -1;
+    state.scissor[0] = state.scissor[1] = -1;
+    state.scissor[2] = state.scissor[3] = -1;
+    for (GLuint& capability : state.capabilities) {
+        capability = UNKNOWN;
+    }
+    state.depthFunc = UNKNOWN;
+    state.depthMask = UNKNOWN;
+    state.colorMask = UNKNOWN;
+    state.cullFace = UNKNOWN;
+    state.polygonMode = UNKNOWN;
+    initialized = true;
+}
+
+void GLState::resetCounters() {
+    counters = Counters();
+}
+
+const GLState::Counters& GLState::getCounters() {
+    return counters;
+}
@@ -1,11 +1,16 @@
 #include "GUI.hpp"
 #include "Light.hpp"
+#include "GLState.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
 #include <iostream>
+#include <iterator>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
-GUI::GUI(GLFWwindow* window) : m_showDemoWindow(false), m_showMainWindow(true) {
+GUI::GUI(GLFWwindow* window) : m_showDemoWindow(false), m_showMainWindow(true), m_showStatsWindow(true), m_showGpuProfilerWindow(true), m_showShadowWindow(true), m_showMemoryWindow(true), m_showStreamingWindow(true), m_showTerrainWindow(true), m_showStressSceneWindow(true) {
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -41,13 +46,17 @@ void GUI::render() {
     // Rendering
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+    // Le backend OpenGL d'ImGui modifie l'état GL sans passer par le cache
+    GLState::invalidate();
 }
 
 void GUI::showMainWindow(bool* shadowsEnabled,
                          LightManager* lightManager,
                          glm::vec3* cameraPos,
                          bool* wireframe,
-                         bool* showLightSources) {
+                         bool* showLightSources,
+                         bool* depthPrepass) {
 
     if (!m_showMainWindow) return;
 
@@ -141,6 +150,12 @@ void GUI::showMainWindow(bool* shadowsEnabled,
             ImGui::SetTooltip("Affiche les sources de lumière en wireframe");
         }
     }
+    if (depthPrepass) {
+        ImGui::Checkbox("Depth Pre-pass", depthPrepass);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Profondeur d'abord, puis éclairage en GL_EQUAL : un seul fragment éclairé par pixel");
+        }
+    }
 
     // Demo window toggle
     ImGui::Checkbox("Show ImGui Demo", &m_showDemoWindow);
@@ -153,10 +168,119 @@ void GUI::showMainWindow(bool* shadowsEnabled,
     }
 }
 
+void GUI::showStatsWindow(const RenderStats& stats) {
+    if (!m_showStatsWindow) return;
+
+    ImGui::Begin("Performance", &m_showStatsWindow);
+
+    ImGui::Text("Frame: %.3f ms (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    ImGui::Text("CPU: %.3f ms  GPU: %.3f ms", stats.cpuFrameMs, stats.gpuFrameMs);
+    ImGui::Text("Objects: %zu visible / %zu total", stats.objectsVisible, stats.objectsTotal);
+    ImGui::Text("Shadow casters: %zu", stats.shadowCasters);
+    ImGui::Text("Shadow layers: %d static redrawn, %d cascades reused", stats.shadowStaticRefreshes, stats.shadowCascadesReused);
+    ImGui::Text("Shadow atlas: %zu tiles, %.0f%% used", stats.shadowAtlasTiles, stats.shadowAtlasUsage * 100.0f);
+    ImGui::Text("Point shadows: %zu lights, %zu face draws", stats.pointShadowLights, stats.pointShadowFaceDraws);
+
+    ImGui::Separator();
+    ImGui::Text("Overdraw%s", stats.depthPrepass ? " (depth pre-pass)" : "");
+    double pixels = stats.screenPixels > 0 ? static_cast<double>(stats.screenPixels) : 1.0;
+    ImGui::Text("Lit fragments: %.2f / pixel", stats.litFragments / pixels);
+    if (stats.depthPrepass) {
+        ImGui::Text("Depth fragments: %.2f / pixel", stats.prepassFragments / pixels);
+    }
+    // Coût comparé : pré-passe + objets éclairés, dans chaque mode
+    ImGui::Text("GPU pre-pass + lit: off %.3f ms, on %.3f ms", stats.depthPrepassGpuMs[0], stats.depthPrepassGpuMs[1]);
+
+    ImGui::Separator();
+    ImGui::Text("Memory");
+    if (stats.heapAllocations == 0) {
+        ImGui::TextColored(ImVec4(0.5f, 0.9f, 0.5f, 1.0f), "Heap allocations/frame: 0");
+    } else {
+        ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.3f, 1.0f), "Heap allocations/frame: %zu (%zu bytes)",
+                           stats.heapAllocations, stats.heapBytes);
+    }
+    ImGui::Text("Frame arena: %zu / %zu KB", stats.arenaUsed / 1024, stats.arenaCapacity / 1024);
+
+    ImGui::Separator();
+    ImGui::Text("GL state calls: %zu issued, %zu filtered", stats.glCallsIssued, stats.glCallsFiltered);
+    ImGui::Text("Shader variants: %zu / %zu ready", stats.shaderVariantsReady, stats.shaderVariantsTotal);
+    if (stats.shaderCompilesPending > 0) {
+        ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.3f, 1.0f), "Compiling: %d (generic fallback in use)",
+                           stats.shaderCompilesPending);
+    }
+    if (stats.asyncLoadsPending > 0) {
+        ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.3f, 1.0f), "Loading: %d resource(s) in background",
+                           stats.asyncLoadsPending);
+    }
+
+    ImGui::End();
+}
+
+void GUI::showGpuProfilerWindow(const GpuProfiler& profiler) {
+    if (!m_showGpuProfilerWindow) return;
+
+    ImGui::Begin("GPU Profiler", &m_showGpuProfilerWindow);
+
+    if (!profiler.isSupported()) {
+        ImGui::TextDisabled("Timer queries not supported");
+        ImGui::End();
+        return;
+    }
+
+    // Graphe glissant du temps de frame GPU
+    char overlay[64];
+    std::snprintf(overlay, sizeof(overlay), "GPU %.3f ms (frame %d)",
+                  profiler.getResolvedFrameMs(), profiler.getResolvedFrameIndex());
+    const auto& history = profiler.getHistory();
+    ImGui::PlotLines("##gpu_history", history.data(), static_cast<int>(history.size()),
+                     profiler.getHistoryOffset(), overlay, 0.0f, FLT_MAX,
+                     ImVec2(ImGui::GetContentRegionAvail().x, 80.0f));
+
+    // Timeline : une ligne par niveau d'imbrication
+    const auto& scopes = profiler.getResolvedScopes();
+    const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+    const float width = ImGui::GetContentRegionAvail().x;
+    const double frameMs = profiler.getResolvedFrameMs() > 0.0 ? profiler.getResolvedFrameMs() : 1.0;
+
+    int maxDepth = 0;
+    for (const auto& scope : scopes) {
+        maxDepth = std::max(maxDepth, scope.depth);
+    }
+
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    int topLevelIndex = -1;
+    for (const auto& scope : scopes) {
+        if (scope.depth == 0) ++topLevelIndex;
+
+        float x0 = origin.x + static_cast<float>(scope.startMs / frameMs) * width;
+        float x1 = origin.x + static_cast<float>((scope.startMs + scope.durationMs) / frameMs) * width;
+        float y0 = origin.y + scope.depth * rowHeight;
+        x1 = std::max(x1, x0 + 1.0f);
+
+        ImU32 color = ImColor::HSV((topLevelIndex * 0.17f) - static_cast<int>(topLevelIndex * 0.17f),
+                                   0.6f - scope.depth * 0.15f, 0.8f);
+        drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y0 + rowHeight - 2.0f), color);
+        if (ImGui::CalcTextSize(scope.name).x < x1 - x0 - 4.0f) {
+            drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32(0, 0, 0, 255), scope.name);
+        }
+    }
+    ImGui::Dummy(ImVec2(width, (maxDepth + 1) * rowHeight));
+
+    // Détail par scope
+    ImGui::Separator();
+    for (const auto& scope : scopes) {
+        ImGui::Text("%*s%-16s %7.3f ms", scope.depth * 2, "", scope.name, scope.durationMs);
+    }
+
+    ImGui::End();
+}
+
 void GUI::showDirectionalLightControls(DirectionalLight* light, int index) {
-    std::string label = "Directional Light " + std::to_string(index);
+    char label[32];
+    std::snprintf(label, sizeof(label), "Directional Light %d", index);
 
-    if (ImGui::CollapsingHeader(label.c_str())) {
+    if (ImGui::CollapsingHeader(label)) {
         ImGui::Checkbox("Enabled", &light->enabled);
         ImGui::SliderFloat3("Position", &light->position.x, -10.0f, 10.0f);
         ImGui::SliderFloat3("Direction", &light->direction.x, -1.0f, 1.0f);
@@ -177,9 +301,10 @@ void GUI::showDirectionalLightControls(DirectionalLight* light, int index) {
 }
 
 void GUI::showPointLightControls(PointLight* light, int index) {
-    std::string label = "Point Light " + std::to_string(index);
+    char label[32];
+    std::snprintf(label, sizeof(label), "Point Light %d", index);
 
-    if (ImGui::CollapsingHeader(label.c_str())) {
+    if (ImGui::CollapsingHeader(label)) {
         ImGui::Checkbox("Enabled", &light->enabled);
         ImGui::SliderFloat3("Position", &light->position.x, -10.0f, 10.0f);
         ImGui::ColorEdit3("Color", &light->color.x);
@@ -195,9 +320,10 @@ void GUI::showPointLightControls(PointLight* light, int index) {
 }
 
 void GUI::showSpotLightControls(SpotLight* light, int index) {
-    std::string label = "Spot Light " + std::to_string(index);
+    char label[32];
+    std::snprintf(label, sizeof(label), "Spot Light %d", index);
 
-    if (ImGui::CollapsingHeader(label.c_str())) {
+    if (ImGui::CollapsingHeader(label)) {
         ImGui::Checkbox("Enabled", &light->enabled);
         ImGui::SliderFloat3("Position", &light->position.x, -10.0f, 10.0f);
         ImGui::SliderFloat3("Direction", &light->direction.x, -1.0f, 1.0f);
@@ -225,10 +351,195 @@ void GUI::showSpotLightControls(SpotLight* light, int index) {
     }
 }
 
+void GUI::showShadowWindow(ShadowSettings& settings, const RenderStats& stats) {
+    if (!m_showShadowWindow) return;
+
+    ImGui::Begin("Shadows", &m_showShadowWindow);
+
+    ImGui::SliderInt("Cascades", &settings.cascadeCount, 1, 4);
+    ImGui::SliderFloat("Split Lambda", &settings.splitLambda, 0.0f, 1.0f);
+    ImGui::SliderFloat("Max Distance", &settings.maxDistance, 5.0f, 100.0f);
+    ImGui::SliderFloat("Blend Band", &settings.blendBand, 0.0f, 0.5f);
+    ImGui::Checkbox("Show Cascades", &settings.showCascades);
+
+    ImGui::Checkbox("Cache Static Casters", &settings.cacheStaticShadows);
+    if (settings.cacheStaticShadows) {
+        ImGui::SliderInt("Static Updates / Frame", &settings.staticUpdateBudget, 0, 4, settings.staticUpdateBudget == 0 ? "unlimited" : "%d");
+    }
+
+    ImGui::Separator();
+    ImGui::Checkbox("Spot Shadows (atlas)", &settings.spotShadows);
+    static const int tileSizes[] = { 256, 512, 1024 };
+    static const char* tileLabels[] = { "256", "512", "1024" };
+    int tileIndex = static_cast<int>(std::find(std::begin(tileSizes), std::end(tileSizes), settings.atlasMaxTileSize) - std::begin(tileSizes));
+    if (ImGui::Combo("Max Tile Size", &tileIndex, tileLabels, IM_ARRAYSIZE(tileLabels))) {
+        settings.atlasMaxTileSize = tileSizes[tileIndex];
+    }
+
+    ImGui::Separator();
+    ImGui::Checkbox("Point Shadows", &settings.pointShadows);
+    static const char* passLabels[] = { "Single pass (geometry shader)", "Six passes" };
+    int passIndex = settings.pointShadowsSinglePass ? 0 : 1;
+    if (ImGui::Combo("Cube Faces", &passIndex, passLabels, IM_ARRAYSIZE(passLabels))) {
+        settings.pointShadowsSinglePass = passIndex == 0;
+    }
+
+    ImGui::Separator();
+    // Taille du noyau PCF : chaque valeur est une variante de shader
+    static const int pcfSizes[] = { 1, 3, 5 };
+    static const char* pcfLabels[] = { "1x1", "3x3", "5x5" };
+    int pcfIndex = static_cast<int>(std::find(std::begin(pcfSizes), std::end(pcfSizes), settings.pcfTaps) - std::begin(pcfSizes));
+    if (ImGui::Combo("PCF Kernel", &pcfIndex, pcfLabels, IM_ARRAYSIZE(pcfLabels))) {
+        settings.pcfTaps = pcfSizes[pcfIndex];
+    }
+
+    // Filtre des cascades : une variante de shader par mode
+    static const char* filterLabels[] = { "PCF", "Hardware PCF", "Poisson disk", "Variance (VSM)" };
+    int filterIndex = static_cast<int>(settings.filter);
+    if (ImGui::Combo("Filter", &filterIndex, filterLabels, IM_ARRAYSIZE(filterLabels))) {
+        settings.filter = static_cast<ShadowFilter>(filterIndex);
+    }
+    if (settings.filter == ShadowFilter::VSM) {
+        ImGui::SliderInt("Blur Radius", &settings.vsmBlurRadius, 0, 8);
+        ImGui::SliderFloat("Bleed Reduction", &settings.vsmBleedReduction, 0.0f, 0.9f);
+    }
+
+    // Coût mesuré : objets éclairés + préfiltrage VSM, moyenne glissante par mode
+    ImGui::Text("GPU cost (lit objects + prefilter):");
+    for (int filter = 0; filter < IM_ARRAYSIZE(filterLabels); ++filter) {
+        if (stats.shadowFilterGpuMs[filter] > 0.0) {
+            ImGui::BulletText("%s: %.3f ms", filterLabels[filter], stats.shadowFilterGpuMs[filter]);
+        } else {
+            ImGui::BulletText("%s: not measured", filterLabels[filter]);
+        }
+    }
+
+    ImGui::End();
+}
+
 bool GUI::wantCaptureMouse() const {
     return ImGui::GetIO().WantCaptureMouse;
 }
 
 bool GUI::wantCaptureKeyboard() const {
     return ImGui::GetIO().WantCaptureKeyboard;
-}
\ No newline at end of file
+}
+
+bool GUI::showMemoryWindow(const ResourceManager::Stats& stats, int* budgetMegabytes) {
+    if (!m_showMemoryWindow) return false;
+
+    ImGui::Begin("GPU Memory", &m_showMemoryWindow);
+
+    const double megabyte = 1024.0 * 1024.0;
+    for (int i = 0; i < static_cast<int>(ResourceCategory::COUNT); ++i) {
+        const ResourceManager::CategoryStats& category = stats.categories[i];
+        ImGui::Text("%-15s %8.2f MB (%d)", getResourceCategoryName(static_cast<ResourceCategory>(i)),
+                    category.bytes / megabyte, category.count);
+    }
+    ImGui::Separator();
+
+    // Budget 0 : illimité, aucune éviction
+    char overlay[64];
+    if (stats.budgetBytes > 0) {
+        std::snprintf(overlay, sizeof(overlay), "%.1f / %.0f MB", stats.totalBytes / megabyte, stats.budgetBytes / megabyte);
+        ImGui::ProgressBar(static_cast<float>(static_cast<double>(stats.totalBytes) / stats.budgetBytes),
+                           ImVec2(-1.0f, 0.0f), overlay);
+    } else {
+        std::snprintf(overlay, sizeof(overlay), "%.1f MB (no budget)", stats.totalBytes / megabyte);
+        ImGui::ProgressBar(0.0f, ImVec2(-1.0f, 0.0f), overlay);
+    }
+    bool changed = ImGui::SliderInt("Budget (MB)", budgetMegabytes, 0, 2048, *budgetMegabytes == 0 ? "unlimited" : "%d");
+
+    ImGui::Text("Geometries: %d (%d/%d streamable resident, %d loading)", stats.geometries, stats.resident,
+                stats.streamable, stats.loading);
+    ImGui::Text("Evictions: %d  Reloads: %d", stats.evictions, stats.reloads);
+
+    ImGui::End();
+    return changed;
+}
+
+void GUI::showTerrainWindow(Terrain::Settings& settings, const Terrain::Stats& stats) {
+    if (!m_showTerrainWindow) return;
+
+    ImGui::Begin("Terrain", &m_showTerrainWindow);
+
+    ImGui::SliderFloat("LOD Distance", &settings.lodDistance, 0.5f, 6.0f, "%.1f x chunk size");
+    ImGui::SliderInt("Uploads / Frame", &settings.uploadsPerFrame, 0, 32, settings.uploadsPerFrame == 0 ? "unlimited" : "%d");
+    ImGui::SliderInt("Generations In Flight", &settings.maxGenerationsInFlight, 1, 32);
+
+    ImGui::Separator();
+    ImGui::Text("Chunks: %d drawn (deepest level %d), %d resident, %d generating", stats.chunksSelected,
+                stats.deepestLevel, stats.chunksResident, stats.chunksGenerating);
+    ImGui::Text("Triangles: %zu", stats.trianglesSelected);
+    ImGui::Text("Memory: %.2f MB", stats.residentBytes / (1024.0 * 1024.0));
+    ImGui::Text("Generation: %.2f ms avg, %.2f ms max (%d chunks)",
+                stats.generated > 0 ? stats.generationMs / stats.generated : 0.0, stats.maxGenerationMs, stats.generated);
+    ImGui::Text("Quadtree selection: %.3f ms, %d evicted", stats.selectMs, stats.evicted);
+
+    ImGui::End();
+}
+
+bool GUI::showStressSceneWindow(StressSceneSettings& settings, std::size_t objectCount) {
+    if (!m_showStressSceneWindow) return false;
+
+    ImGui::Begin("Stress Scene", &m_showStressSceneWindow);
+
+    // Activer / désactiver applique immédiatement ; les autres réglages au clic sur Generate
+    bool regenerate = ImGui::Checkbox("Enabled", &settings.enabled);
+
+    ImGui::SliderInt("Objects", &settings.objectCount, 1, 20000, "%d", ImGuiSliderFlags_Logarithmic);
+    ImGui::SliderInt("Directional Lights", &settings.directionalLights, 0, LightManager::MAX_LIGHTS);
+    ImGui::SliderInt("Point Lights", &settings.pointLights, 0, LightManager::MAX_LIGHTS);
+    ImGui::SliderInt("Spot Lights", &settings.spotLights, 0, LightManager::MAX_LIGHTS);
+    int seed = static_cast<int>(settings.seed);
+    if (ImGui::InputInt("Seed", &seed)) {
+        settings.seed = static_cast<unsigned int>(std::max(seed, 0));
+    }
+    ImGui::Checkbox("Animate", &settings.animate);
+
+    int lightCount = settings.directionalLights + settings.pointLights + settings.spotLights;
+    if (lightCount > LightManager::MAX_LIGHTS) {
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "%d lights requested, %d at most", lightCount,
+                           LightManager::MAX_LIGHTS);
+    }
+
+    if (ImGui::Button("Generate")) {
+        settings.enabled = true;
+        regenerate = true;
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Generated objects: %zu", objectCount);
+
+    ImGui::End();
+    return regenerate;
+}
+
+void GUI::showStreamingWindow(WorldStreamer::Settings& settings, const WorldStreamer::Stats& stats) {
+    if (!m_showStreamingWindow) return;
+
+    ImGui::Begin("World Streaming", &m_showStreamingWindow);
+
+    ImGui::SliderFloat("Load Radius", &settings.loadRadius, 10.0f, 100.0f, "%.0f m");
+    // Hystérésis : les cellules ne sont déchargées qu'au-delà de ce rayon
+    float hysteresis = settings.unloadRadius - settings.loadRadius;
+    if (ImGui::SliderFloat("Hysteresis", &hysteresis, 0.0f, 50.0f, "%.0f m")) {
+        settings.unloadRadius = settings.loadRadius + hysteresis;
+    } else {
+        settings.unloadRadius = std::max(settings.unloadRadius, settings.loadRadius);
+    }
+    ImGui::SliderInt("Upload Budget", &settings.uploadBudgetKB, 0, 4096, settings.uploadBudgetKB == 0 ? "unlimited" : "%d KB/frame");
+    ImGui::SliderInt("Loads In Flight", &settings.maxLoadsInFlight, 1, 16);
+
+    ImGui::Separator();
+    ImGui::Text("Cells: %d / %d resident", stats.cellsResident, stats.cellsTotal);
+    ImGui::Text("Queued %d, loading %d, ready %d", stats.cellsQueued, stats.cellsLoading, stats.cellsReady);
+    ImGui::Text("Resident: %.2f MB (peak %.2f MB)", stats.residentBytes / (1024.0 * 1024.0),
+                stats.peakResidentBytes / (1024.0 * 1024.0));
+    ImGui::Text("Latency: %.1f ms avg, %.1f ms max", stats.loads > 0 ? stats.latencyMs / stats.loads : 0.0,
+                stats.maxLatencyMs);
+    ImGui::Text("Upload: %.3f ms this frame, %.3f ms max", stats.uploadMs, stats.maxUploadMs);
+    ImGui::Text("Loads %d, unloads %d, cancelled %d", stats.loads, stats.unloads, stats.cancelled);
+
+    ImGui::End();
+}
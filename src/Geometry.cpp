@@ -1,10 +1,15 @@
 #include "Geometry.hpp"
+#include "Trace.hpp"
+#include "GLState.hpp"
+#include "MeshCache.hpp"
+#include "ResourceManager.hpp"
 #include <cmath>
 #include <iostream>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-Geometry::Geometry() : VAO(0), VBO(0), EBO(0), initialized(false) {}
+Geometry::Geometry() : VAO(0), VBO(0), EBO(0), drawVertexCount(0), drawIndexCount(0), gpuBytes(0), initialized(false),
+                       boundsCenter(0.0f), boundsRadius(0.0f) {}
 
 Geometry::~Geometry() {
     cleanup();
@@ -511,6 +516,46 @@ void Geometry::generateWireCylinder(float radius, float height, int sectorCount)
 void Geometry::setupMesh() {
     if (vertices.empty()) return;
 
+    computeBounds();
+    uploadBuffers(vertices.data(), vertices.size(), indices.data(), indices.size());
+}
+
+void Geometry::setupMesh(const Vertex* vertexData, std::size_t vertexCount, const unsigned int* indexData,
+                         std::size_t indexCount, const glm::vec3& center, float radius) {
+    if (vertexCount == 0) return;
+
+    // Pas de copie CPU : les données peuvent être une vue sur un fichier projeté
+    vertices.clear();
+    indices.clear();
+    boundsCenter = center;
+    boundsRadius = radius;
+    uploadBuffers(vertexData, vertexCount, indexData, indexCount);
+}
+
+void Geometry::setupMesh(const Vertex* vertexData, std::size_t vertexCount, GLuint sharedIndexBuffer,
+                         std::size_t indexCount, const glm::vec3& center, float radius) {
+    if (vertexCount == 0) return;
+
+    vertices.clear();
+    indices.clear();
+    boundsCenter = center;
+    boundsRadius = radius;
+    uploadBuffers(vertexData, vertexCount, nullptr, indexCount, sharedIndexBuffer);
+}
+
+bool Geometry::loadMesh(const std::string& path) {
+    TRACE_SCOPE("Geometry::loadMesh");
+    MeshCache::CompiledMesh mesh;
+    if (!MeshCache::load(path, mesh)) return false;
+
+    setupMesh(mesh.vertices, mesh.vertexCount, mesh.indices, mesh.indexCount, mesh.boundsCenter, mesh.boundsRadius);
+    return true;
+}
+
+void Geometry::uploadBuffers(const Vertex* vertexData, std::size_t vertexCount, const unsigned int* indexData,
+                             std::size_t indexCount, GLuint sharedIndexBuffer) {
+    TRACE_SCOPE("Geometry::setupMesh");
+
     // Nettoyer les anciens buffers s'ils existent
     cleanup();
 
@@ -518,17 +563,19 @@ void Geometry::setupMesh() {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
 
-    glBindVertexArray(VAO);
+    GLState::bindVertexArray(VAO);
 
     // Buffer des vertices
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), vertexData, GL_STATIC_DRAW);
 
-    // Buffer des indices (si présent)
-    if (!indices.empty()) {
+    // Buffer des indices (si présent) : partagé, ou propre à la géométrie
+    if (indexCount > 0 && sharedIndexBuffer != 0) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sharedIndexBuffer);
+    } else if (indexCount > 0) {
         glGenBuffers(1, &EBO);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), indexData, GL_STATIC_DRAW);
     }
 
     // Attribut 0: Position (x, y, z)
@@ -543,45 +590,71 @@ void Geometry::setupMesh() {
     glEnableVertexAttribArray(2);
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
 
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 
+    drawVertexCount = static_cast<GLsizei>(vertexCount);
+    drawIndexCount = static_cast<GLsizei>(indexCount);
+    gpuBytes = vertexCount * sizeof(Vertex) + (EBO != 0 ? indexCount * sizeof(unsigned int) : 0);
+    ResourceManager::trackMemory(ResourceCategory::GEOMETRY, static_cast<std::int64_t>(gpuBytes));
     initialized = true;
 }
 
+void computeBoundingSphere(const Vertex* vertices, std::size_t vertexCount, glm::vec3& center, float& radius) {
+    center = glm::vec3(0.0f);
+    radius = 0.0f;
+    if (vertexCount == 0) return;
+
+    glm::vec3 minBounds(vertices[0].x, vertices[0].y, vertices[0].z);
+    glm::vec3 maxBounds = minBounds;
+    for (std::size_t i = 0; i < vertexCount; ++i) {
+        const Vertex& v = vertices[i];
+        minBounds = glm::min(minBounds, glm::vec3(v.x, v.y, v.z));
+        maxBounds = glm::max(maxBounds, glm::vec3(v.x, v.y, v.z));
+    }
+
+    center = (minBounds + maxBounds) * 0.5f;
+    for (std::size_t i = 0; i < vertexCount; ++i) {
+        const Vertex& v = vertices[i];
+        radius = glm::max(radius, glm::length(glm::vec3(v.x, v.y, v.z) - center));
+    }
+}
+
+void Geometry::computeBounds() {
+    computeBoundingSphere(vertices.data(), vertices.size(), boundsCenter, boundsRadius);
+}
+
 void Geometry::render() const {
     if (!initialized) return;
 
-    glBindVertexArray(VAO);
+    // Le VAO reste lié : le prochain rendu de la même géométrie ne le relie pas
+    GLState::bindVertexArray(VAO);
 
-    if (!indices.empty()) {
+    if (drawIndexCount > 0) {
         // Rendu avec indices
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, drawIndexCount, GL_UNSIGNED_INT, 0);
     } else {
         // Rendu sans indices
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+        glDrawArrays(GL_TRIANGLES, 0, drawVertexCount);
     }
-
-    glBindVertexArray(0);
 }
 
 void Geometry::renderWireframe() const {
     if (!initialized) return;
 
-    glBindVertexArray(VAO);
+    GLState::bindVertexArray(VAO);
 
-    if (!indices.empty()) {
+    if (drawIndexCount > 0) {
         // Rendu avec indices en lignes
-        glDrawElements(GL_LINES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_LINES, drawIndexCount, GL_UNSIGNED_INT, 0);
     } else {
         // Rendu sans indices en lignes
-        glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertices.size()));
+        glDrawArrays(GL_LINES, 0, drawVertexCount);
     }
-
-    glBindVertexArray(0);
 }
 
 void Geometry::cleanup() {
     if (VAO != 0) {
+        GLState::forgetVertexArray(VAO);
         glDeleteVertexArrays(1, &VAO);
         VAO = 0;
     }
@@ -593,5 +666,9 @@ void Geometry::cleanup() {
         glDeleteBuffers(1, &EBO);
         EBO = 0;
     }
+    if (initialized) {
+        ResourceManager::trackMemory(ResourceCategory::GEOMETRY, -static_cast<std::int64_t>(gpuBytes));
+        gpuBytes = 0;
+    }
     initialized = false;
 }
\ No newline at end of file
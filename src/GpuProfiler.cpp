@@ -0,0 +1,118 @@
+#include "GpuProfiler.hpp"
+
+GpuProfiler::GpuProfiler()
+    : current(nullptr), stackDepth(0),
+      resolvedFrameIndex(-1), resolvedFrameMs(0.0), historyOffset(0) {
+
+    // GL_ARB_timer_query fait partie du cœur depuis OpenGL 3.3
+    supported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+    if (!supported) return;
+
+    for (auto& frame : frames) {
+        glGenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+    }
+    resolvedScopes.reserve(MAX_SCOPES);
+}
+
+GpuProfiler::~GpuProfiler() {
+    if (!supported) return;
+
+    for (auto& frame : frames) {
+        glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+    }
+}
+
+bool GpuProfiler::collect() {
+    if (!supported) return false;
+
+    // Frame en attente la plus ancienne
+    FrameQueries* oldest = nullptr;
+    for (auto& frame : frames) {
+        if (frame.pending && (!oldest || frame.frameIndex < oldest->frameIndex)) {
+            oldest = &frame;
+        }
+    }
+    return oldest && resolve(*oldest);
+}
+
+void GpuProfiler::beginFrame(int frameIndex) {
+    if (!supported) return;
+
+    // Le slot de cette frame est réutilisé : s'il n'a toujours pas été relu, il est abandonné
+    current = &frames[frameIndex % FRAME_LATENCY];
+    current->pending = false;
+    current->scopeCount = 0;
+    current->frameIndex = frameIndex;
+    stackDepth = 0;
+
+    glQueryCounter(current->queries[0], GL_TIMESTAMP);
+}
+
+void GpuProfiler::endFrame() {
+    if (!supported || !current) return;
+
+    // Fermer les scopes restés ouverts
+    while (stackDepth > 0) {
+        endScope();
+    }
+
+    glQueryCounter(current->queries[1], GL_TIMESTAMP);
+    current->pending = true;
+    current = nullptr;
+}
+
+void GpuProfiler::beginScope(const char* name) {
+    if (!supported || !current || stackDepth >= MAX_SCOPES) return;
+
+    // Au-delà de MAX_SCOPES, le scope est ignoré mais reste sur la pile pour l'appariement
+    int index = -1;
+    if (current->scopeCount < MAX_SCOPES) {
+        index = current->scopeCount++;
+        current->scopes[index] = {name, stackDepth};
+        glQueryCounter(current->queries[2 + 2 * index], GL_TIMESTAMP);
+    }
+    scopeStack[stackDepth++] = index;
+}
+
+void GpuProfiler::endScope() {
+    if (!supported || !current || stackDepth == 0) return;
+
+    int index = scopeStack[--stackDepth];
+    if (index >= 0) {
+        glQueryCounter(current->queries[2 + 2 * index + 1], GL_TIMESTAMP);
+    }
+}
+
+bool GpuProfiler::resolve(FrameQueries& frame) {
+    // Le timestamp de fin de frame est émis en dernier : s'il est prêt, tous le sont
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+
+    GLuint64 frameStart = 0, frameEnd = 0;
+    glGetQueryObjectui64v(frame.queries[0], GL_QUERY_RESULT, &frameStart);
+    glGetQueryObjectui64v(frame.queries[1], GL_QUERY_RESULT, &frameEnd);
+
+    resolvedScopes.clear();
+    for (int i = 0; i < frame.scopeCount; ++i) {
+        GLuint64 start = 0, end = 0;
+        glGetQueryObjectui64v(frame.queries[2 + 2 * i], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(frame.queries[2 + 2 * i + 1], GL_QUERY_RESULT, &end);
+
+        ScopeResult result;
+        result.name = frame.scopes[i].name;
+        result.depth = frame.scopes[i].depth;
+        result.startMs = static_cast<double>(start - frameStart) / 1.0e6;
+        result.durationMs = static_cast<double>(end - start) / 1.0e6;
+        resolvedScopes.push_back(result);
+    }
+
+    resolvedFrameIndex = frame.frameIndex;
+    resolvedFrameMs = static_cast<double>(frameEnd - frameStart) / 1.0e6;
+
+    history[historyOffset] = static_cast<float>(resolvedFrameMs);
+    historyOffset = (historyOffset + 1) % HISTORY_SIZE;
+
+    frame.pending = false;
+    return true;
+}
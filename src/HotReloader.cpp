@@ -0,0 +1,83 @@
+#include "HotReloader.hpp"
+#include "ShaderCompiler.hpp"
+#include "ShaderVariants.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+HotReloader::HotReloader(ShaderCompiler* compiler) : compiler(compiler), reloadCount(0) {}
+
+bool HotReloader::watchDirectory(const std::string& directory) {
+    return watcher.watchDirectory(directory);
+}
+
+void HotReloader::addShader(Shader* shader) {
+    shaders.push_back(shader);
+}
+
+void HotReloader::addShaderVariants(ShaderVariants* variants) {
+    variantSets.push_back(variants);
+}
+
+void HotReloader::addFile(const std::string& path, std::function<void()> onChanged) {
+    fileListeners[std::filesystem::weakly_canonical(path).string()].push_back(std::move(onChanged));
+}
+
+bool HotReloader::isPending(const Shader& shader) const {
+    return std::any_of(pending.begin(), pending.end(),
+                       [&shader](const PendingReload& reload) { return reload.target == &shader; });
+}
+
+void HotReloader::scheduleShaderReload(Shader& shader, const std::string& changedPath) {
+    // Un programme encore en compilation ou déjà en cours de rechargement est ignoré
+    if (!shader.dependsOn(changedPath) || !shader.isReady() || isPending(shader)) return;
+
+    std::unique_ptr<Shader> replacement = shader.createReloaded();
+    if (compiler) {
+        compiler->submit(replacement.get());
+    } else {
+        replacement->beginBuild();
+        replacement->finishBuild();
+    }
+    pending.push_back({&shader, std::move(replacement)});
+}
+
+void HotReloader::update() {
+    TRACE_SCOPE("HotReloader::update");
+
+    for (const std::string& path : watcher.takeChanges()) {
+        std::cout << "Hot reload: " << path << std::endl;
+
+        for (Shader* shader : shaders) {
+            scheduleShaderReload(*shader, path);
+        }
+        for (ShaderVariants* variants : variantSets) {
+            variants->forEachShader([&](Shader& shader) { scheduleShaderReload(shader, path); });
+        }
+
+        auto listeners = fileListeners.find(path);
+        if (listeners != fileListeners.end()) {
+            for (auto& onChanged : listeners->second) {
+                onChanged();
+            }
+        }
+    }
+
+    // Remplacement des programmes terminés
+    auto done = std::remove_if(pending.begin(), pending.end(), [this](PendingReload& reload) {
+        switch (reload.replacement->getStatus()) {
+            case Shader::Status::PENDING:
+                return false;
+            case Shader::Status::READY:
+                reload.target->swapProgram(*reload.replacement);
+                ++reloadCount;
+                return true;
+            case Shader::Status::FAILED:
+                std::cerr << "Hot reload failed, keeping the previous program" << std::endl;
+                return true;
+        }
+        return true;
+    });
+    pending.erase(done, pending.end());
+}
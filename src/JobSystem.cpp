@@ -0,0 +1,141 @@
+#include "JobSystem.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::vector<std::thread> workers;
+    std::thread::id mainThreadId;
+
+    std::mutex workerMutex;
+    std::condition_variable workerCondition;
+    std::deque<JobSystem::Job> workerQueue;
+    bool stopping = false;
+
+    std::mutex mainThreadMutex;
+    std::deque<JobSystem::Job> mainThreadQueue;
+
+    std::atomic<int> pendingCount(0);
+
+    void workerLoop() {
+        TRACE_THREAD_NAME("job_worker");
+
+        while (true) {
+            JobSystem::Job job;
+            {
+                std::unique_lock<std::mutex> lock(workerMutex);
+                workerCondition.wait(lock, [] { return stopping || !workerQueue.empty(); });
+                // Arrêt : la file est vidée d'abord, les coroutines en cours vont au bout de leur étape
+                if (workerQueue.empty()) break;
+                job = std::move(workerQueue.front());
+                workerQueue.pop_front();
+            }
+
+            TRACE_SCOPE("JobSystem::job");
+            job();
+            pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+}
+
+void JobSystem::initialize(int threadCount) {
+    if (!workers.empty()) return;
+
+    mainThreadId = std::this_thread::get_id();
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    stopping = false;
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(workerLoop);
+    }
+}
+
+void JobSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        stopping = true;
+    }
+    workerCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(mainThreadMutex);
+    pendingCount.fetch_sub(static_cast<int>(mainThreadQueue.size()), std::memory_order_acq_rel);
+    mainThreadQueue.clear();
+}
+
+void JobSystem::submit(Job job) {
+    if (workers.empty()) {
+        job();
+        return;
+    }
+
+    pendingCount.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        workerQueue.push_back(std::move(job));
+    }
+    workerCondition.notify_one();
+}
+
+void JobSystem::submitToMainThread(Job job) {
+    pendingCount.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> lock(mainThreadMutex);
+    mainThreadQueue.push_back(std::move(job));
+}
+
+int JobSystem::runMainThreadJobs(double budgetMs) {
+    TRACE_SCOPE("JobSystem::runMainThreadJobs");
+
+    auto start = std::chrono::steady_clock::now();
+    int executed = 0;
+    while (true) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            if (mainThreadQueue.empty()) break;
+            job = std::move(mainThreadQueue.front());
+            mainThreadQueue.pop_front();
+        }
+
+        job();
+        pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+        ++executed;
+
+        // Les travaux ajoutés pendant la boucle attendront la frame suivante si le budget est épuisé
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (budgetMs > 0.0 && elapsed.count() >= budgetMs) break;
+    }
+    return executed;
+}
+
+void JobSystem::waitOnMainThread(const std::function<bool()>& done) {
+    TRACE_SCOPE("JobSystem::waitOnMainThread");
+
+    while (!done()) {
+        if (runMainThreadJobs() == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
+
+bool JobSystem::isMainThread() {
+    return workers.empty() || std::this_thread::get_id() == mainThreadId;
+}
+
+int JobSystem::getWorkerCount() {
+    return static_cast<int>(workers.size());
+}
+
+int JobSystem::getPendingCount() {
+    return pendingCount.load(std::memory_order_acquire);
+}
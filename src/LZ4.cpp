@@ -0,0 +1,146 @@
+#include "LZ4.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+    const std::size_t MIN_MATCH = 4;
+    const std::size_t LAST_LITERALS = 5;        // Les 5 derniers octets sont toujours des littéraux
+    const std::size_t MATCH_SAFE_DISTANCE = 12; // Pas de copie commençant dans les 12 derniers octets
+    const std::size_t MAX_OFFSET = 65535;
+    const int HASH_BITS = 16;
+
+    std::uint32_t read32(const unsigned char* p) {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    std::uint32_t hash4(std::uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // Longueur au-delà de 15 : octets de 255 puis le reste
+    unsigned char* writeLength(unsigned char* out, std::size_t length) {
+        while (length >= 255) {
+            *out++ = 255;
+            length -= 255;
+        }
+        *out++ = static_cast<unsigned char>(length);
+        return out;
+    }
+
+    unsigned char* writeSequence(unsigned char* out, const unsigned char* literals, std::size_t literalLength,
+                                 std::size_t offset, std::size_t matchLength) {
+        unsigned char* token = out++;
+        std::size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+        *token = static_cast<unsigned char>(((literalLength >= 15 ? 15 : literalLength) << 4) |
+                                            (matchCode >= 15 ? 15 : matchCode));
+        if (literalLength >= 15) out = writeLength(out, literalLength - 15);
+        std::memcpy(out, literals, literalLength);
+        out += literalLength;
+
+        if (matchLength >= MIN_MATCH) {
+            *out++ = static_cast<unsigned char>(offset & 0xFF);
+            *out++ = static_cast<unsigned char>(offset >> 8);
+            if (matchCode >= 15) out = writeLength(out, matchCode - 15);
+        }
+        return out;
+    }
+}
+
+namespace LZ4 {
+    std::size_t compressBound(std::size_t size) {
+        return size + size / 255 + 16;
+    }
+
+    std::size_t compress(const unsigned char* input, std::size_t size, unsigned char* output) {
+        unsigned char* out = output;
+        std::size_t anchor = 0;
+
+        if (size > MATCH_SAFE_DISTANCE) {
+            std::vector<std::uint32_t> table(std::size_t(1) << HASH_BITS, 0);
+            std::size_t matchLimit = size - LAST_LITERALS;
+            std::size_t position = 0;
+
+            while (position + MATCH_SAFE_DISTANCE < size) {
+                std::uint32_t sequence = read32(input + position);
+                std::uint32_t& slot = table[hash4(sequence)];
+                std::size_t candidate = slot;
+                slot = static_cast<std::uint32_t>(position);
+
+                if (candidate >= position || position - candidate > MAX_OFFSET ||
+                    read32(input + candidate) != sequence) {
+                    ++position;
+                    continue;
+                }
+
+                std::size_t length = MIN_MATCH;
+                while (position + length < matchLimit && input[candidate + length] == input[position + length]) {
+                    ++length;
+                }
+
+                out = writeSequence(out, input + anchor, position - anchor, position - candidate, length);
+                position += length;
+                anchor = position;
+            }
+        }
+
+        // Dernière séquence : littéraux seuls
+        return static_cast<std::size_t>(writeSequence(out, input + anchor, size - anchor, 0, 0) - output);
+    }
+
+    bool decompress(const unsigned char* input, std::size_t inputSize, unsigned char* output, std::size_t outputSize) {
+        const unsigned char* in = input;
+        const unsigned char* inEnd = input + inputSize;
+        std::size_t written = 0;
+
+        while (in < inEnd) {
+            unsigned char token = *in++;
+
+            std::size_t literalLength = token >> 4;
+            if (literalLength == 15) {
+                unsigned char extra;
+                do {
+                    if (in >= inEnd) return false;
+                    extra = *in++;
+                    literalLength += extra;
+                } while (extra == 255);
+            }
+            if (literalLength > static_cast<std::size_t>(inEnd - in) || literalLength > outputSize - written) {
+                return false;
+            }
+            std::memcpy(output + written, in, literalLength);
+            in += literalLength;
+            written += literalLength;
+
+            // Fin du bloc : la dernière séquence n'a pas de copie
+            if (in == inEnd) break;
+
+            if (inEnd - in < 2) return false;
+            std::size_t offset = in[0] | (in[1] << 8);
+            in += 2;
+            if (offset == 0 || offset > written) return false;
+
+            std::size_t matchLength = token & 15;
+            if (matchLength == 15) {
+                unsigned char extra;
+                do {
+                    if (in >= inEnd) return false;
+                    extra = *in++;
+                    matchLength += extra;
+                } while (extra == 255);
+            }
+            matchLength += MIN_MATCH;
+            if (matchLength > outputSize - written) return false;
+
+            // Copie octet par octet : la source peut chevaucher la destination (répétitions)
+            const unsigned char* match = output + written - offset;
+            for (std::size_t i = 0; i < matchLength; ++i) {
+                output[written + i] = match[i];
+            }
+            written += matchLength;
+        }
+        return written == outputSize;
+    }
+}
@@ -1,55 +1,104 @@
 #include "Light.hpp"
+#include "Trace.hpp"
 #include <string>
 #include <memory>
 #include <cmath>
+#include <algorithm>
+#include <array>
+
+namespace {
+    // Noms des uniformes "lights[i].xxx", construits une seule fois au premier appel
+    // pour éviter les concaténations de std::string à chaque frame
+    struct LightUniformNames {
+        std::string type, color, intensity;
+        std::string direction, position;
+        std::string constant, linear, quadratic;
+        std::string cutOff, outerCutOff;
+        std::string shadowMatrix, shadowRect, shadowParams;
+    };
+
+    const LightUniformNames& uniformNames(int index) {
+        static const std::array<LightUniformNames, LightManager::MAX_LIGHTS> names = [] {
+            std::array<LightUniformNames, LightManager::MAX_LIGHTS> table;
+            for (int i = 0; i < LightManager::MAX_LIGHTS; ++i) {
+                std::string base = "lights[" + std::to_string(i) + "]";
+                table[i] = {base + ".type", base + ".color", base + ".intensity",
+                            base + ".direction", base + ".position",
+                            base + ".constant", base + ".linear", base + ".quadratic",
+                            base + ".cutOff", base + ".outerCutOff",
+                            base + ".shadowMatrix", base + ".shadowRect", base + ".shadowParams"};
+            }
+            return table;
+        }();
+        return names[index];
+    }
+}
+
+float Light::getRange() const {
+    // Racine de quadratic * d² + linear * d + constant = 256 * intensity
+    float threshold = 256.0f * intensity;
+    if (quadratic > 0.0f) {
+        float discriminant = linear * linear - 4.0f * quadratic * (constant - threshold);
+        return (-linear + std::sqrt(std::max(discriminant, 0.0f))) / (2.0f * quadratic);
+    }
+    if (linear > 0.0f) {
+        return std::max(threshold - constant, 0.0f) / linear;
+    }
+    return 100.0f;
+}
 
 // Implémentation DirectionalLight
 void DirectionalLight::sendToShader(Shader& shader, int index) const {
-    std::string base = "lights[" + std::to_string(index) + "]";
-
-    shader.setUniform(base + ".type", static_cast<int>(type));
-    shader.setUniform(base + ".direction", direction);
-    shader.setUniform(base + ".position", position);  // Pour les nouveaux shaders si nécessaire
-    shader.setUniform(base + ".color", color);
-    shader.setUniform(base + ".intensity", intensity);
-    shader.setUniform(base + ".enabled", enabled);
+    const LightUniformNames& names = uniformNames(index);
+
+    shader.setUniform(names.type.c_str(), static_cast<int>(type));
+    shader.setUniform(names.direction.c_str(), direction);
+    shader.setUniform(names.position.c_str(), position);  // Pour les nouveaux shaders si nécessaire
+    shader.setUniform(names.color.c_str(), color);
+    shader.setUniform(names.intensity.c_str(), intensity);
 }
 
 // Implémentation PointLight
 void PointLight::sendToShader(Shader& shader, int index) const {
-    std::string base = "lights[" + std::to_string(index) + "]";
+    const LightUniformNames& names = uniformNames(index);
 
-    shader.setUniform(base + ".type", static_cast<int>(type));
-    shader.setUniform(base + ".position", position);
-    shader.setUniform(base + ".color", color);
-    shader.setUniform(base + ".intensity", intensity);
-    shader.setUniform(base + ".enabled", enabled);
+    shader.setUniform(names.type.c_str(), static_cast<int>(type));
+    shader.setUniform(names.position.c_str(), position);
+    shader.setUniform(names.color.c_str(), color);
+    shader.setUniform(names.intensity.c_str(), intensity);
 
     // Paramètres d'atténuation
-    shader.setUniform(base + ".constant", constant);
-    shader.setUniform(base + ".linear", linear);
-    shader.setUniform(base + ".quadratic", quadratic);
+    shader.setUniform(names.constant.c_str(), constant);
+    shader.setUniform(names.linear.c_str(), linear);
+    shader.setUniform(names.quadratic.c_str(), quadratic);
+
+    // Couches de la shadow map cubique
+    shader.setUniform(names.shadowParams.c_str(), shadowParams);
 }
 
 // Implémentation SpotLight
 void SpotLight::sendToShader(Shader& shader, int index) const {
-    std::string base = "lights[" + std::to_string(index) + "]";
+    const LightUniformNames& names = uniformNames(index);
 
-    shader.setUniform(base + ".type", static_cast<int>(type));
-    shader.setUniform(base + ".position", position);
-    shader.setUniform(base + ".direction", direction);
-    shader.setUniform(base + ".color", color);
-    shader.setUniform(base + ".intensity", intensity);
-    shader.setUniform(base + ".enabled", enabled);
+    shader.setUniform(names.type.c_str(), static_cast<int>(type));
+    shader.setUniform(names.position.c_str(), position);
+    shader.setUniform(names.direction.c_str(), direction);
+    shader.setUniform(names.color.c_str(), color);
+    shader.setUniform(names.intensity.c_str(), intensity);
 
     // Paramètres d'atténuation
-    shader.setUniform(base + ".constant", constant);
-    shader.setUniform(base + ".linear", linear);
-    shader.setUniform(base + ".quadratic", quadratic);
+    shader.setUniform(names.constant.c_str(), constant);
+    shader.setUniform(names.linear.c_str(), linear);
+    shader.setUniform(names.quadratic.c_str(), quadratic);
 
     // Paramètres du spot
-    shader.setUniform(base + ".cutOff", glm::cos(glm::radians(cutOff)));
-    shader.setUniform(base + ".outerCutOff", glm::cos(glm::radians(outerCutOff)));
+    shader.setUniform(names.cutOff.c_str(), glm::cos(glm::radians(cutOff)));
+    shader.setUniform(names.outerCutOff.c_str(), glm::cos(glm::radians(outerCutOff)));
+
+    // Tuile de la shadow atlas
+    shader.setUniform(names.shadowMatrix.c_str(), shadowMatrix);
+    shader.setUniform(names.shadowRect.c_str(), shadowRect);
+    shader.setUniform(names.shadowParams.c_str(), shadowParams);
 }
 
 // Implémentation LightManager
@@ -72,17 +121,41 @@ void LightManager::addSpotLight(const SpotLight& light) {
 }
 
 void LightManager::sendLightsToShader(Shader& shader) const {
-    // Envoyer le nombre de lumières
-    shader.setUniform("numLights", static_cast<int>(lights.size()));
+    TRACE_SCOPE("LightManager::sendLightsToShader");
+
+    // Seules les lumières actives sont envoyées, triées par type (directionnelles, ponctuelles,
+    // spots) : c'est l'ordre attendu par les variantes spécialisées du shader
+    int index = 0;
+    for (LightType type : {LightType::DIRECTIONAL, LightType::POINT, LightType::SPOT}) {
+        for (const auto& light : lights) {
+            if (light->enabled && light->type == type) {
+                light->sendToShader(shader, index++);
+            }
+        }
+    }
 
-    // Envoyer chaque lumière
-    for (size_t i = 0; i < lights.size(); ++i) {
-        lights[i]->sendToShader(shader, static_cast<int>(i));
+    // Envoyer le nombre de lumières (variante générique)
+    shader.setUniform("numLights", index);
+}
+
+LightManager::LightCounts LightManager::countEnabledLights() const {
+    LightCounts counts;
+    for (const auto& light : lights) {
+        if (!light->enabled) continue;
+        switch (light->type) {
+            case LightType::DIRECTIONAL: ++counts.directional; break;
+            case LightType::POINT:       ++counts.point; break;
+            case LightType::SPOT:        ++counts.spot; break;
+        }
     }
+    return counts;
+}
 
-    // Désactiver les lumières inutilisées
-    for (size_t i = lights.size(); i < MAX_LIGHTS; ++i) {
-        std::string base = "lights[" + std::to_string(i) + "]";
-        shader.setUniform(base + ".enabled", false);
+const DirectionalLight* LightManager::getShadowCaster() const {
+    for (const auto& light : lights) {
+        if (light->enabled && light->type == LightType::DIRECTIONAL) {
+            return static_cast<const DirectionalLight*>(light.get());
+        }
     }
-}
\ No newline at end of file
+    return nullptr;
+}
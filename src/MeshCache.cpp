@@ -0,0 +1,228 @@
+#include "MeshCache.hpp"
+#include "AssetPack.hpp"
+#include "CacheFile.hpp"
+#include "Hash.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+namespace {
+    std::string cacheDirectory = "mesh_cache";
+    bool cacheEnabled = true;
+    MeshCache::Stats cacheStats;
+    std::mutex statsMutex;
+
+    // À incrémenter quand l'import, la soudure ou les optimisations changent : invalide tout le cache
+    const std::uint32_t IMPORTER_VERSION = 1;
+
+    // Les entrées d'une archive sont construites avec elle : pas de clé de source
+    const std::uint64_t PACK_KEY = 0;
+
+    const std::size_t ENTRY_ALIGNMENT = 64;
+
+    struct EntryHeader {
+        char magic[8];
+        std::uint64_t key;
+        std::uint32_t vertexCount;
+        std::uint32_t indexCount;
+        float boundsCenter[3];
+        float boundsRadius;
+        std::uint32_t vertexStride;     // sizeof(Vertex) : un changement de format invalide l'entrée
+        std::uint32_t reserved;
+        std::uint64_t vertexOffset;
+        std::uint64_t indexOffset;
+    };
+    static_assert(sizeof(EntryHeader) == ENTRY_ALIGNMENT, "Mesh entry header must fill one 64-byte line");
+
+    const char ENTRY_MAGIC[8] = {'M', 'E', 'S', 'H', 'B', 'I', 'N', '1'};
+
+    std::size_t alignUp(std::size_t offset) {
+        return (offset + ENTRY_ALIGNMENT - 1) / ENTRY_ALIGNMENT * ENTRY_ALIGNMENT;
+    }
+
+    void recordLoad(bool cacheHit, double milliseconds, std::size_t bytes, bool fromPack = false) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        if (fromPack) ++cacheStats.packHits;
+        if (cacheHit) {
+            ++cacheStats.hits;
+            cacheStats.hitMs += milliseconds;
+        } else {
+            ++cacheStats.misses;
+            cacheStats.missMs += milliseconds;
+        }
+        cacheStats.bytes += bytes;
+    }
+
+    // Clé : chemin, taille et date de la source, version de l'importeur
+    bool computeKey(const std::string& sourcePath, std::uint64_t& key) {
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(sourcePath, error);
+        if (error) return false;
+        auto modified = std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+        if (error) return false;
+
+        key = hashString(sourcePath);
+        key = hashBytes(&size, sizeof(size), key);
+        key = hashBytes(&modified, sizeof(modified), key);
+        key = hashBytes(&IMPORTER_VERSION, sizeof(IMPORTER_VERSION), key);
+        return true;
+    }
+
+    void encodeEntry(const MeshImporter::MeshData& mesh, std::uint64_t key, std::vector<unsigned char>& bytes) {
+        EntryHeader header = {};
+        std::memcpy(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+        header.key = key;
+        header.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+        header.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+        glm::vec3 center;
+        computeBoundingSphere(mesh.vertices.data(), mesh.vertices.size(), center, header.boundsRadius);
+        std::memcpy(header.boundsCenter, &center, sizeof(header.boundsCenter));
+        header.vertexStride = sizeof(Vertex);
+        header.vertexOffset = sizeof(EntryHeader);
+        header.indexOffset = alignUp(header.vertexOffset + mesh.vertices.size() * sizeof(Vertex));
+
+        bytes.assign(header.indexOffset + mesh.indices.size() * sizeof(unsigned int), 0);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + header.vertexOffset, mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+        std::memcpy(bytes.data() + header.indexOffset, mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+    }
+
+    // Valide l'en-tête et pointe les vues de 'mesh' dans 'bytes' (qui doit lui survivre)
+    bool parseEntry(const unsigned char* bytes, std::size_t size, std::uint64_t key, MeshCache::CompiledMesh& mesh) {
+        if (size < sizeof(EntryHeader)) return false;
+        EntryHeader header;
+        std::memcpy(&header, bytes, sizeof(header));
+        if (std::memcmp(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) != 0 || header.key != key ||
+            header.vertexStride != sizeof(Vertex) || header.vertexCount == 0 ||
+            header.vertexOffset % alignof(Vertex) != 0 || header.indexOffset % alignof(unsigned int) != 0 ||
+            header.vertexOffset + static_cast<std::uint64_t>(header.vertexCount) * sizeof(Vertex) > size ||
+            header.indexOffset + static_cast<std::uint64_t>(header.indexCount) * sizeof(unsigned int) > size) {
+            return false;
+        }
+
+        mesh.vertices = reinterpret_cast<const Vertex*>(bytes + header.vertexOffset);
+        mesh.vertexCount = header.vertexCount;
+        mesh.indices = reinterpret_cast<const unsigned int*>(bytes + header.indexOffset);
+        mesh.indexCount = header.indexCount;
+        mesh.boundsCenter = glm::vec3(header.boundsCenter[0], header.boundsCenter[1], header.boundsCenter[2]);
+        mesh.boundsRadius = header.boundsRadius;
+        return true;
+    }
+
+    // Une seule lecture de l'entrée entière
+    bool readEntry(const std::string& path, std::uint64_t key, MeshCache::CompiledMesh& mesh) {
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(path, error);
+        if (error) return false;
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+
+        mesh.storage.resize(static_cast<std::size_t>(size));
+        if (!file.read(reinterpret_cast<char*>(mesh.storage.data()), static_cast<std::streamsize>(size))) return false;
+        return parseEntry(mesh.storage.data(), mesh.storage.size(), key, mesh);
+    }
+
+    void writeEntry(const std::string& path, const std::vector<unsigned char>& bytes) {
+        // Fichier temporaire puis renommage : jamais d'entrée à moitié écrite
+        writeCacheFile(path, [&bytes](std::ostream& file) {
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        });
+    }
+}
+
+void MeshCache::setDirectory(const std::string& directory) {
+    cacheDirectory = directory;
+}
+
+const std::string& MeshCache::getDirectory() {
+    return cacheDirectory;
+}
+
+void MeshCache::setEnabled(bool enabled) {
+    cacheEnabled = enabled;
+}
+
+bool MeshCache::isEnabled() {
+    return cacheEnabled;
+}
+
+std::string MeshCache::getEntryPath(std::uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.mesh", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(cacheDirectory) / name).string();
+}
+
+bool MeshCache::load(const std::string& sourcePath, CompiledMesh& mesh, MeshImporter::Stats* importStats) {
+    TRACE_SCOPE("MeshCache::load");
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&start] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    mesh = CompiledMesh();
+
+    // Entrée compilée de l'archive d'assets : vues directement dans la projection
+    if (const AssetPack* pack = AssetPack::getMounted()) {
+        std::string_view bytes = pack->view(AssetPack::normalizePath(sourcePath) + getPackSuffix());
+        if (!bytes.empty() && parseEntry(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), PACK_KEY, mesh)) {
+            recordLoad(true, elapsedMs(), mesh.getByteSize(), true);
+            return true;
+        }
+    }
+
+    std::uint64_t key = 0;
+    bool cached = isEnabled() && computeKey(sourcePath, key);
+    if (cached) {
+        std::string path = getEntryPath(key);
+        if (readEntry(path, key, mesh)) {
+            recordLoad(true, elapsedMs(), mesh.getByteSize());
+            return true;
+        }
+        // Absente ou corrompue : reconstruite ci-dessous
+        mesh = CompiledMesh();
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+
+    MeshImporter::MeshData imported;
+    if (!MeshImporter::importFile(sourcePath, imported, importStats)) {
+        return false;
+    }
+
+    // Même représentation qu'une entrée lue : une seule forme de CompiledMesh
+    encodeEntry(imported, key, mesh.storage);
+    if (cached) {
+        writeEntry(getEntryPath(key), mesh.storage);
+    }
+    parseEntry(mesh.storage.data(), mesh.storage.size(), key, mesh);
+    recordLoad(false, elapsedMs(), mesh.getByteSize());
+    return true;
+}
+
+void MeshCache::serialize(const MeshImporter::MeshData& mesh, std::string& bytes) {
+    std::vector<unsigned char> encoded;
+    encodeEntry(mesh, PACK_KEY, encoded);
+    bytes.assign(encoded.begin(), encoded.end());
+}
+
+MeshCache::Stats MeshCache::getStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return cacheStats;
+}
+
+void MeshCache::printReport() {
+    Stats cacheStats = getStats();
+    if (cacheStats.hits + cacheStats.misses == 0) return;
+
+    double megabytes = static_cast<double>(cacheStats.bytes) / (1024.0 * 1024.0);
+    const char* state = cacheStats.misses == 0 ? "warm" : (cacheStats.hits == 0 ? "cold" : "partial");
+    std::cout << "Mesh cache (" << state << "): " << cacheStats.hits << " loaded in " << cacheStats.hitMs
+              << " ms (" << cacheStats.packHits << " from asset pack), " << cacheStats.misses << " imported in "
+              << cacheStats.missMs << " ms, " << megabytes << " MB" << std::endl;
+}
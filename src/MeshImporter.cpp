@@ -0,0 +1,989 @@
+#include "MeshImporter.hpp"
+#include "AssetPack.hpp"
+#include "Trace.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    std::string getExtension(const std::string& path) {
+        std::string extension = std::filesystem::path(path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        return extension;
+    }
+
+    // ------------------------------------------------------------------------
+    // OBJ : blocs de lignes analysés en parallèle
+    // ------------------------------------------------------------------------
+
+    const int MISSING_INDEX = INT_MIN;
+    const std::size_t MIN_CHUNK_BYTES = 1 << 20;
+
+    // Indice d'un coin de face. Absolu (base 0) ou relatif au début du bloc : un indice négatif
+    // de l'OBJ dépend du nombre d'éléments lus avant lui, connu seulement après tous les blocs
+    struct ObjCorner {
+        int index[3];               // Position, uv, normale (MISSING_INDEX si absent)
+        unsigned char relative;     // Bit i : index[i] relatif au bloc
+    };
+
+    struct ObjChunk {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> texCoords;
+        std::vector<glm::vec3> normals;
+        std::vector<ObjCorner> corners;     // 3 par triangle
+        int errorLine = -1;                 // Première ligne invalide (dans le bloc)
+    };
+
+    const char* skipSpaces(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        return p;
+    }
+
+    bool parseFloats(const char* p, const char* end, float* values, int count) {
+        for (int i = 0; i < count; ++i) {
+            p = skipSpaces(p, end);
+            auto [next, error] = std::from_chars(p, end, values[i]);
+            if (error != std::errc()) return false;
+            p = next;
+        }
+        return true;
+    }
+
+    // "a", "a/b", "a//c" ou "a/b/c" ; les indices négatifs sont relatifs à la fin des listes
+    bool parseCorner(const char*& p, const char* end, const std::size_t counts[3], ObjCorner& corner) {
+        corner.relative = 0;
+        for (int component = 0; component < 3; ++component) {
+            corner.index[component] = MISSING_INDEX;
+            if (component > 0) {
+                if (p >= end || *p != '/') continue;
+                ++p;
+            }
+            if (p < end && *p == '/') continue;     // "a//c" : uv absente
+
+            int value = 0;
+            auto [next, error] = std::from_chars(p, end, value);
+            if (error != std::errc() || value == 0) return false;
+            p = next;
+            if (value > 0) {
+                corner.index[component] = value - 1;
+            } else {
+                corner.index[component] = static_cast<int>(counts[component]) + value;
+                corner.relative |= 1 << component;
+            }
+        }
+        return true;
+    }
+
+    void parseObjChunk(const char* begin, const char* end, ObjChunk& chunk) {
+        TRACE_SCOPE("MeshImporter::parseObjChunk");
+        std::vector<ObjCorner> polygon;
+        int line = 0;
+
+        for (const char* p = begin; p < end; ++line) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!lineEnd) lineEnd = end;
+            const char* q = skipSpaces(p, lineEnd);
+            bool valid = true;
+
+            if (lineEnd - q > 2 && q[0] == 'v' && (q[1] == ' ' || q[1] == '\t')) {
+                glm::vec3 position;
+                valid = parseFloats(q + 2, lineEnd, glm::value_ptr(position), 3);
+                chunk.positions.push_back(position);
+            } else if (lineEnd - q > 3 && q[0] == 'v' && q[1] == 't' && (q[2] == ' ' || q[2] == '\t')) {
+                glm::vec2 texCoord;
+                valid = parseFloats(q + 3, lineEnd, glm::value_ptr(texCoord), 2);
+                chunk.texCoords.push_back(texCoord);
+            } else if (lineEnd - q > 3 && q[0] == 'v' && q[1] == 'n' && (q[2] == ' ' || q[2] == '\t')) {
+                glm::vec3 normal;
+                valid = parseFloats(q + 3, lineEnd, glm::value_ptr(normal), 3);
+                chunk.normals.push_back(normal);
+            } else if (lineEnd - q > 2 && q[0] == 'f' && (q[1] == ' ' || q[1] == '\t')) {
+                const std::size_t counts[3] = {chunk.positions.size(), chunk.texCoords.size(), chunk.normals.size()};
+                polygon.clear();
+                const char* c = skipSpaces(q + 2, lineEnd);
+                while (valid && c < lineEnd) {
+                    ObjCorner corner;
+                    valid = parseCorner(c, lineEnd, counts, corner);
+                    polygon.push_back(corner);
+                    c = skipSpaces(c, lineEnd);
+                }
+                valid = valid && polygon.size() >= 3;
+                // Polygone convexe supposé : triangulation en éventail
+                for (std::size_t i = 1; valid && i + 1 < polygon.size(); ++i) {
+                    chunk.corners.push_back(polygon[0]);
+                    chunk.corners.push_back(polygon[i]);
+                    chunk.corners.push_back(polygon[i + 1]);
+                }
+            }
+            // Autres lignes (o, g, s, usemtl, mtllib, commentaires) ignorées
+
+            if (!valid && chunk.errorLine < 0) chunk.errorLine = line;
+            p = lineEnd + 1;
+        }
+    }
+
+    bool importObj(const std::string& path, const std::string& source, int threadCount, std::vector<Vertex>& corners,
+                   double& parseMs) {
+        auto start = Clock::now();
+
+        // Découpage aux fins de ligne
+        std::size_t chunkCount = std::clamp<std::size_t>(source.size() / MIN_CHUNK_BYTES, 1, threadCount);
+        std::vector<const char*> bounds = {source.data()};
+        for (std::size_t i = 1; i < chunkCount; ++i) {
+            const char* split = source.data() + source.size() * i / chunkCount;
+            split = std::max(split, bounds.back());
+            const char* newline = static_cast<const char*>(std::memchr(split, '\n', source.data() + source.size() - split));
+            bounds.push_back(newline ? newline + 1 : source.data() + source.size());
+        }
+        bounds.push_back(source.data() + source.size());
+
+        std::vector<ObjChunk> chunks(chunkCount);
+        {
+            std::vector<std::future<void>> tasks;
+            for (std::size_t i = 0; i < chunkCount; ++i) {
+                tasks.push_back(std::async(std::launch::async, parseObjChunk, bounds[i], bounds[i + 1], std::ref(chunks[i])));
+            }
+            for (std::future<void>& task : tasks) task.get();
+        }
+
+        // Décalage de chaque bloc dans les listes globales, puis vérification des erreurs
+        std::vector<std::size_t> offsets[3];
+        std::size_t totals[3] = {0, 0, 0};
+        std::vector<std::size_t> cornerOffsets;
+        std::size_t cornerTotal = 0;
+        for (std::size_t i = 0; i < chunkCount; ++i) {
+            const ObjChunk& chunk = chunks[i];
+            if (chunk.errorLine >= 0) {
+                std::size_t line = std::count(bounds[0], bounds[i], '\n') + chunk.errorLine + 1;
+                std::cerr << "Invalid OBJ line " << line << " in " << path << std::endl;
+                return false;
+            }
+            const std::size_t counts[3] = {chunk.positions.size(), chunk.texCoords.size(), chunk.normals.size()};
+            for (int component = 0; component < 3; ++component) {
+                offsets[component].push_back(totals[component]);
+                totals[component] += counts[component];
+            }
+            cornerOffsets.push_back(cornerTotal);
+            cornerTotal += chunk.corners.size();
+        }
+
+        // Sommets de chaque coin, en parallèle par bloc ; un attribut absent vaut zéro
+        // (normale recalculée après la soudure)
+        corners.resize(cornerTotal);
+        std::vector<std::future<bool>> tasks;
+        for (std::size_t i = 0; i < chunkCount; ++i) {
+            tasks.push_back(std::async(std::launch::async, [&, i] {
+                // Élément désigné par un coin : bloc qui le contient et position dans ce bloc.
+                // Retourne false si l'indice est hors limites
+                auto locate = [&](const ObjCorner& corner, int component, std::size_t& block, std::size_t& local) {
+                    long long value = corner.index[component];
+                    if (corner.relative & (1 << component)) value += static_cast<long long>(offsets[component][i]);
+                    if (value < 0 || static_cast<std::size_t>(value) >= totals[component]) return false;
+                    std::size_t index = static_cast<std::size_t>(value);
+                    block = std::upper_bound(offsets[component].begin(), offsets[component].end(), index)
+                          - offsets[component].begin() - 1;
+                    local = index - offsets[component][block];
+                    return true;
+                };
+
+                Vertex* out = corners.data() + cornerOffsets[i];
+                for (const ObjCorner& corner : chunks[i].corners) {
+                    Vertex vertex = {};
+                    std::size_t block, local;
+                    if (corner.index[0] == MISSING_INDEX || !locate(corner, 0, block, local)) return false;
+                    const glm::vec3& position = chunks[block].positions[local];
+                    vertex.x = position.x; vertex.y = position.y; vertex.z = position.z;
+                    if (corner.index[1] != MISSING_INDEX) {
+                        if (!locate(corner, 1, block, local)) return false;
+                        const glm::vec2& texCoord = chunks[block].texCoords[local];
+                        vertex.u = texCoord.x; vertex.v = texCoord.y;
+                    }
+                    if (corner.index[2] != MISSING_INDEX) {
+                        if (!locate(corner, 2, block, local)) return false;
+                        const glm::vec3& normal = chunks[block].normals[local];
+                        vertex.nx = normal.x; vertex.ny = normal.y; vertex.nz = normal.z;
+                    }
+                    *out++ = vertex;
+                }
+                return true;
+            }));
+        }
+        bool valid = true;
+        for (std::future<bool>& task : tasks) valid = task.get() && valid;
+        if (!valid) {
+            std::cerr << "Invalid OBJ face index in " << path << std::endl;
+            return false;
+        }
+
+        parseMs = elapsedMs(start);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    // JSON minimal (glTF)
+    // ------------------------------------------------------------------------
+
+    struct JsonValue {
+        enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+        Type type = Type::NUL;
+        bool boolean = false;
+        double number = 0.0;
+        std::string string;
+        std::vector<JsonValue> array;
+        std::vector<std::pair<std::string, JsonValue>> members;
+
+        const JsonValue* get(std::string_view key) const {
+            for (const auto& [name, value] : members) {
+                if (name == key) return &value;
+            }
+            return nullptr;
+        }
+
+        double getNumber(std::string_view key, double fallback) const {
+            const JsonValue* value = get(key);
+            return value && value->type == Type::NUMBER ? value->number : fallback;
+        }
+
+        std::size_t size() const { return array.size(); }
+    };
+
+    class JsonParser {
+    public:
+        JsonParser(const char* begin, const char* end) : p(begin), end(end) {}
+
+        bool parse(JsonValue& value) {
+            return parseValue(value, 0) && (skipWhitespace(), p == end);
+        }
+
+    private:
+        const char* p;
+        const char* end;
+
+        static const int MAX_DEPTH = 128;
+
+        void skipWhitespace() {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+        }
+
+        bool consume(const char* literal) {
+            std::size_t length = std::strlen(literal);
+            if (static_cast<std::size_t>(end - p) < length || std::memcmp(p, literal, length) != 0) return false;
+            p += length;
+            return true;
+        }
+
+        bool parseValue(JsonValue& value, int depth) {
+            skipWhitespace();
+            if (p >= end || depth > MAX_DEPTH) return false;
+            switch (*p) {
+                case '{': return parseObject(value, depth);
+                case '[': return parseArray(value, depth);
+                case '"': value.type = JsonValue::Type::STRING; return parseString(value.string);
+                case 't': value.type = JsonValue::Type::BOOLEAN; value.boolean = true; return consume("true");
+                case 'f': value.type = JsonValue::Type::BOOLEAN; value.boolean = false; return consume("false");
+                case 'n': value.type = JsonValue::Type::NUL; return consume("null");
+                default: {
+                    value.type = JsonValue::Type::NUMBER;
+                    auto [next, error] = std::from_chars(p, end, value.number);
+                    if (error != std::errc()) return false;
+                    p = next;
+                    return true;
+                }
+            }
+        }
+
+        bool parseObject(JsonValue& value, int depth) {
+            value.type = JsonValue::Type::OBJECT;
+            ++p;
+            skipWhitespace();
+            if (p < end && *p == '}') { ++p; return true; }
+            while (true) {
+                skipWhitespace();
+                std::string key;
+                if (p >= end || *p != '"' || !parseString(key)) return false;
+                skipWhitespace();
+                if (p >= end || *p++ != ':') return false;
+                value.members.emplace_back(std::move(key), JsonValue());
+                if (!parseValue(value.members.back().second, depth + 1)) return false;
+                skipWhitespace();
+                if (p >= end) return false;
+                if (*p == ',') { ++p; continue; }
+                return *p++ == '}';
+            }
+        }
+
+        bool parseArray(JsonValue& value, int depth) {
+            value.type = JsonValue::Type::ARRAY;
+            ++p;
+            skipWhitespace();
+            if (p < end && *p == ']') { ++p; return true; }
+            while (true) {
+                value.array.emplace_back();
+                if (!parseValue(value.array.back(), depth + 1)) return false;
+                skipWhitespace();
+                if (p >= end) return false;
+                if (*p == ',') { ++p; continue; }
+                return *p++ == ']';
+            }
+        }
+
+        void appendUtf8(std::string& out, unsigned int codePoint) {
+            if (codePoint < 0x80) {
+                out += static_cast<char>(codePoint);
+            } else if (codePoint < 0x800) {
+                out += static_cast<char>(0xC0 | (codePoint >> 6));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            } else {
+                out += static_cast<char>(0xE0 | (codePoint >> 12));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+        bool parseString(std::string& out) {
+            ++p;
+            while (p < end && *p != '"') {
+                if (*p != '\\') {
+                    out += *p++;
+                    continue;
+                }
+                if (++p >= end) return false;
+                char escape = *p++;
+                switch (escape) {
+                    case '"': case '\\': case '/': out += escape; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u': {
+                        unsigned int codePoint = 0;
+                        if (end - p < 4) return false;
+                        auto [next, error] = std::from_chars(p, p + 4, codePoint, 16);
+                        if (error != std::errc() || next != p + 4) return false;
+                        p += 4;
+                        appendUtf8(out, codePoint);
+                        break;
+                    }
+                    default: return false;
+                }
+            }
+            if (p >= end) return false;
+            ++p;
+            return true;
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // glTF 2.0 (.gltf + .bin / data URI, .glb)
+    // ------------------------------------------------------------------------
+
+    const std::uint32_t GLB_MAGIC = 0x46546C67;        // "glTF"
+    const std::uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+    const std::uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+    const int GLTF_BYTE = 5120, GLTF_UNSIGNED_BYTE = 5121, GLTF_SHORT = 5122, GLTF_UNSIGNED_SHORT = 5123;
+    const int GLTF_UNSIGNED_INT = 5125, GLTF_FLOAT = 5126;
+    const int GLTF_TRIANGLES = 4;
+
+    bool decodeBase64(std::string_view text, std::string& out) {
+        auto decodeChar = [](char c) -> int {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+') return 62;
+            if (c == '/') return 63;
+            return -1;
+        };
+        out.clear();
+        out.reserve(text.size() * 3 / 4);
+        unsigned int buffer = 0;
+        int bits = 0;
+        for (char c : text) {
+            if (c == '=') break;
+            int value = decodeChar(c);
+            if (value < 0) return false;
+            buffer = (buffer << 6) | static_cast<unsigned int>(value);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out += static_cast<char>((buffer >> bits) & 0xFF);
+            }
+        }
+        return true;
+    }
+
+    struct GltfDocument {
+        JsonValue json;
+        std::vector<std::string> buffers;
+
+        const JsonValue* getArray(std::string_view key) const {
+            const JsonValue* value = json.get(key);
+            return value && value->type == JsonValue::Type::ARRAY ? value : nullptr;
+        }
+
+        const JsonValue* getElement(std::string_view key, double index) const {
+            const JsonValue* array = getArray(key);
+            if (!array || index < 0 || index >= static_cast<double>(array->size())) return nullptr;
+            return &array->array[static_cast<std::size_t>(index)];
+        }
+    };
+
+    int getComponentCount(const std::string& type) {
+        if (type == "SCALAR") return 1;
+        if (type == "VEC2") return 2;
+        if (type == "VEC3") return 3;
+        if (type == "VEC4") return 4;
+        return 0;
+    }
+
+    int getComponentSize(int componentType) {
+        switch (componentType) {
+            case GLTF_BYTE: case GLTF_UNSIGNED_BYTE: return 1;
+            case GLTF_SHORT: case GLTF_UNSIGNED_SHORT: return 2;
+            case GLTF_UNSIGNED_INT: case GLTF_FLOAT: return 4;
+            default: return 0;
+        }
+    }
+
+    // Accesseur lu composante par composante (flottants, entiers normalisés ou indices)
+    bool readAccessor(const GltfDocument& document, double accessorIndex, int expectedComponents,
+                      std::vector<double>& values, std::size_t& count) {
+        const JsonValue* accessor = document.getElement("accessors", accessorIndex);
+        if (!accessor || accessor->get("sparse")) return false;
+        const JsonValue* type = accessor->get("type");
+        int components = type ? getComponentCount(type->string) : 0;
+        int componentType = static_cast<int>(accessor->getNumber("componentType", 0));
+        int componentSize = getComponentSize(componentType);
+        count = static_cast<std::size_t>(accessor->getNumber("count", 0));
+        if (components != expectedComponents || componentSize == 0) return false;
+
+        const JsonValue* view = document.getElement("bufferViews", accessor->getNumber("bufferView", -1));
+        if (!view) return false;
+        double bufferIndex = view->getNumber("buffer", -1);
+        if (bufferIndex < 0 || bufferIndex >= static_cast<double>(document.buffers.size())) return false;
+        const std::string& buffer = document.buffers[static_cast<std::size_t>(bufferIndex)];
+
+        std::size_t elementSize = static_cast<std::size_t>(components) * componentSize;
+        std::size_t stride = static_cast<std::size_t>(view->getNumber("byteStride", 0));
+        if (stride == 0) stride = elementSize;
+        std::size_t offset = static_cast<std::size_t>(view->getNumber("byteOffset", 0) + accessor->getNumber("byteOffset", 0));
+        std::size_t viewEnd = static_cast<std::size_t>(view->getNumber("byteOffset", 0) + view->getNumber("byteLength", 0));
+        if (count > 0 && (viewEnd > buffer.size() || offset + (count - 1) * stride + elementSize > viewEnd)) return false;
+
+        const JsonValue* normalizedValue = accessor->get("normalized");
+        bool normalized = normalizedValue && normalizedValue->boolean;
+        values.resize(count * components);
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* element = buffer.data() + offset + i * stride;
+            for (int c = 0; c < components; ++c) {
+                const char* source = element + c * componentSize;
+                double value = 0.0;
+                switch (componentType) {
+                    case GLTF_FLOAT: { float f; std::memcpy(&f, source, 4); value = f; break; }
+                    case GLTF_UNSIGNED_INT: { std::uint32_t u; std::memcpy(&u, source, 4); value = u; break; }
+                    case GLTF_UNSIGNED_SHORT: {
+                        std::uint16_t u; std::memcpy(&u, source, 2);
+                        value = normalized ? u / 65535.0 : u;
+                        break;
+                    }
+                    case GLTF_SHORT: {
+                        std::int16_t s; std::memcpy(&s, source, 2);
+                        value = normalized ? std::max(s / 32767.0, -1.0) : s;
+                        break;
+                    }
+                    case GLTF_UNSIGNED_BYTE: {
+                        std::uint8_t u = static_cast<std::uint8_t>(*source);
+                        value = normalized ? u / 255.0 : u;
+                        break;
+                    }
+                    case GLTF_BYTE: {
+                        std::int8_t s = static_cast<std::int8_t>(*source);
+                        value = normalized ? std::max(s / 127.0, -1.0) : s;
+                        break;
+                    }
+                }
+                values[i * components + c] = value;
+            }
+        }
+        return true;
+    }
+
+    glm::mat4 getNodeTransform(const JsonValue& node) {
+        const JsonValue* matrix = node.get("matrix");
+        if (matrix && matrix->size() == 16) {
+            glm::mat4 result;
+            for (int i = 0; i < 16; ++i) {
+                glm::value_ptr(result)[i] = static_cast<float>(matrix->array[i].number);  // Colonne par colonne
+            }
+            return result;
+        }
+
+        glm::mat4 result(1.0f);
+        if (const JsonValue* translation = node.get("translation"); translation && translation->size() == 3) {
+            result = glm::translate(result, glm::vec3(translation->array[0].number, translation->array[1].number,
+                                                      translation->array[2].number));
+        }
+        if (const JsonValue* rotation = node.get("rotation"); rotation && rotation->size() == 4) {
+            // glTF : (x, y, z, w) ; glm::quat : (w, x, y, z)
+            glm::quat q(static_cast<float>(rotation->array[3].number), static_cast<float>(rotation->array[0].number),
+                        static_cast<float>(rotation->array[1].number), static_cast<float>(rotation->array[2].number));
+            result *= glm::mat4_cast(q);
+        }
+        if (const JsonValue* scale = node.get("scale"); scale && scale->size() == 3) {
+            result = glm::scale(result, glm::vec3(scale->array[0].number, scale->array[1].number, scale->array[2].number));
+        }
+        return result;
+    }
+
+    struct GltfPrimitive {
+        const JsonValue* primitive;
+        glm::mat4 transform;
+    };
+
+    void collectPrimitives(const GltfDocument& document, double nodeIndex, const glm::mat4& parent, int depth,
+                           std::vector<GltfPrimitive>& primitives) {
+        const JsonValue* node = document.getElement("nodes", nodeIndex);
+        if (!node || depth > 64) return;
+        glm::mat4 transform = parent * getNodeTransform(*node);
+
+        if (const JsonValue* mesh = document.getElement("meshes", node->getNumber("mesh", -1))) {
+            if (const JsonValue* meshPrimitives = mesh->get("primitives")) {
+                for (const JsonValue& primitive : meshPrimitives->array) {
+                    primitives.push_back({&primitive, transform});
+                }
+            }
+        }
+        if (const JsonValue* children = node->get("children")) {
+            for (const JsonValue& child : children->array) {
+                collectPrimitives(document, child.number, transform, depth + 1, primitives);
+            }
+        }
+    }
+
+    // Triangles de la primitive développés en coins (soudés ensuite avec le reste du maillage)
+    bool decodePrimitive(const GltfDocument& document, const GltfPrimitive& instance, std::vector<Vertex>& corners) {
+        TRACE_SCOPE("MeshImporter::decodePrimitive");
+        const JsonValue& primitive = *instance.primitive;
+        if (static_cast<int>(primitive.getNumber("mode", GLTF_TRIANGLES)) != GLTF_TRIANGLES) return true;
+        const JsonValue* attributes = primitive.get("attributes");
+        if (!attributes || !attributes->get("POSITION")) return false;
+
+        std::vector<double> positions, normals, texCoords, indexValues;
+        std::size_t vertexCount = 0, count = 0;
+        if (!readAccessor(document, attributes->getNumber("POSITION", -1), 3, positions, vertexCount)) return false;
+        bool hasNormals = attributes->get("NORMAL") &&
+                          readAccessor(document, attributes->getNumber("NORMAL", -1), 3, normals, count) && count == vertexCount;
+        bool hasTexCoords = attributes->get("TEXCOORD_0") &&
+                            readAccessor(document, attributes->getNumber("TEXCOORD_0", -1), 2, texCoords, count) &&
+                            count == vertexCount;
+
+        std::vector<unsigned int> indices;
+        if (primitive.get("indices")) {
+            if (!readAccessor(document, primitive.getNumber("indices", -1), 1, indexValues, count)) return false;
+            indices.reserve(count);
+            for (double value : indexValues) {
+                if (value >= static_cast<double>(vertexCount)) return false;
+                indices.push_back(static_cast<unsigned int>(value));
+            }
+        } else {
+            for (std::size_t i = 0; i < vertexCount; ++i) indices.push_back(static_cast<unsigned int>(i));
+        }
+
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.transform)));
+        std::size_t first = corners.size();
+        std::size_t cornerCount = indices.size() / 3 * 3;
+        corners.resize(first + cornerCount);
+        for (std::size_t i = 0; i < cornerCount; ++i) {
+            unsigned int index = indices[i];
+            glm::vec3 position = glm::vec3(instance.transform * glm::vec4(positions[index * 3], positions[index * 3 + 1],
+                                                                          positions[index * 3 + 2], 1.0));
+            Vertex& vertex = corners[first + i];
+            vertex = {};
+            vertex.x = position.x; vertex.y = position.y; vertex.z = position.z;
+            if (hasNormals) {
+                glm::vec3 normal = normalMatrix * glm::vec3(normals[index * 3], normals[index * 3 + 1], normals[index * 3 + 2]);
+                float length = glm::length(normal);
+                if (length > 0.0f) normal /= length;
+                vertex.nx = normal.x; vertex.ny = normal.y; vertex.nz = normal.z;
+            }
+            if (hasTexCoords) {
+                // Origine en haut à gauche en glTF, en bas à gauche en OpenGL
+                vertex.u = static_cast<float>(texCoords[index * 2]);
+                vertex.v = 1.0f - static_cast<float>(texCoords[index * 2 + 1]);
+            }
+        }
+
+        // Sans normales, la spécification glTF demande des normales plates (par triangle)
+        for (std::size_t i = first; !hasNormals && i < corners.size(); i += 3) {
+            Vertex* triangle = &corners[i];
+            glm::vec3 normal = glm::cross(
+                glm::vec3(triangle[1].x - triangle[0].x, triangle[1].y - triangle[0].y, triangle[1].z - triangle[0].z),
+                glm::vec3(triangle[2].x - triangle[0].x, triangle[2].y - triangle[0].y, triangle[2].z - triangle[0].z));
+            float length = glm::length(normal);
+            if (length == 0.0f) continue;
+            normal /= length;
+            for (int k = 0; k < 3; ++k) {
+                triangle[k].nx = normal.x; triangle[k].ny = normal.y; triangle[k].nz = normal.z;
+            }
+        }
+        return true;
+    }
+
+    bool importGltf(const std::string& path, const std::string& source, int threadCount, std::vector<Vertex>& corners,
+                    double& parseMs) {
+        auto start = Clock::now();
+        GltfDocument document;
+        std::string_view json(source);
+        std::string binaryChunk;
+        bool hasBinaryChunk = false;
+
+        // .glb : en-tête de 12 octets puis blocs (JSON, BIN optionnel)
+        std::uint32_t magic = 0;
+        if (source.size() >= 12) std::memcpy(&magic, source.data(), 4);
+        if (magic == GLB_MAGIC) {
+            json = std::string_view();
+            std::size_t offset = 12;
+            while (offset + 8 <= source.size()) {
+                std::uint32_t chunkLength, chunkType;
+                std::memcpy(&chunkLength, source.data() + offset, 4);
+                std::memcpy(&chunkType, source.data() + offset + 4, 4);
+                if (offset + 8 + chunkLength > source.size()) break;
+                if (chunkType == GLB_CHUNK_JSON && json.empty()) {
+                    json = std::string_view(source.data() + offset + 8, chunkLength);
+                } else if (chunkType == GLB_CHUNK_BIN && !hasBinaryChunk) {
+                    binaryChunk.assign(source.data() + offset + 8, chunkLength);
+                    hasBinaryChunk = true;
+                }
+                offset += 8 + ((chunkLength + 3) & ~3u);
+            }
+        }
+
+        if (!JsonParser(json.data(), json.data() + json.size()).parse(document.json) ||
+            document.json.type != JsonValue::Type::OBJECT) {
+            std::cerr << "Invalid glTF JSON in " << path << std::endl;
+            return false;
+        }
+
+        // Buffers : bloc BIN du .glb, URI data:...;base64 ou fichier relatif au .gltf
+        if (const JsonValue* buffers = document.getArray("buffers")) {
+            std::filesystem::path directory = std::filesystem::path(path).parent_path();
+            for (const JsonValue& buffer : buffers->array) {
+                std::string data;
+                const JsonValue* uri = buffer.get("uri");
+                bool loaded = false;
+                if (!uri) {
+                    loaded = hasBinaryChunk;
+                    data = binaryChunk;
+                } else if (uri->string.compare(0, 5, "data:") == 0) {
+                    std::size_t comma = uri->string.find(";base64,");
+                    loaded = comma != std::string::npos &&
+                             decodeBase64(std::string_view(uri->string).substr(comma + 8), data);
+                } else {
+                    loaded = AssetPack::readAsset((directory / uri->string).string(), data);
+                }
+                if (!loaded) {
+                    std::cerr << "glTF buffer failed to load in " << path << std::endl;
+                    return false;
+                }
+                document.buffers.push_back(std::move(data));
+            }
+        }
+
+        // Nœuds de la scène par défaut ; sans scène, chaque maillage tel quel
+        std::vector<GltfPrimitive> primitives;
+        const JsonValue* scene = document.getElement("scenes", document.json.getNumber("scene", 0));
+        if (scene && scene->get("nodes")) {
+            for (const JsonValue& node : scene->get("nodes")->array) {
+                collectPrimitives(document, node.number, glm::mat4(1.0f), 0, primitives);
+            }
+        } else if (const JsonValue* meshes = document.getArray("meshes")) {
+            for (const JsonValue& mesh : meshes->array) {
+                if (const JsonValue* meshPrimitives = mesh.get("primitives")) {
+                    for (const JsonValue& primitive : meshPrimitives->array) {
+                        primitives.push_back({&primitive, glm::mat4(1.0f)});
+                    }
+                }
+            }
+        }
+
+        // Primitives décodées en parallèle, par lots de 'threadCount'
+        std::vector<std::vector<Vertex>> decoded(primitives.size());
+        std::vector<char> valid(primitives.size(), 0);
+        for (std::size_t batch = 0; batch < primitives.size(); batch += threadCount) {
+            std::vector<std::future<void>> tasks;
+            for (std::size_t i = batch; i < std::min(primitives.size(), batch + threadCount); ++i) {
+                tasks.push_back(std::async(std::launch::async, [&, i] {
+                    valid[i] = decodePrimitive(document, primitives[i], decoded[i]);
+                }));
+            }
+            for (std::future<void>& task : tasks) task.get();
+        }
+
+        for (std::size_t i = 0; i < primitives.size(); ++i) {
+            if (!valid[i]) {
+                std::cerr << "Unsupported or invalid glTF primitive " << i << " in " << path << std::endl;
+                return false;
+            }
+            corners.insert(corners.end(), decoded[i].begin(), decoded[i].end());
+        }
+        parseMs = elapsedMs(start);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    // Soudure et normales
+    // ------------------------------------------------------------------------
+
+    std::uint64_t hashVertex(const Vertex& vertex) {
+        std::uint32_t words[sizeof(Vertex) / 4];
+        std::memcpy(words, &vertex, sizeof(words));
+        std::uint64_t hash = 0x9E3779B97F4A7C15ull;
+        for (std::uint32_t word : words) {
+            hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 32;
+        }
+        return hash;
+    }
+
+    // Table à adressage ouvert (sonde linéaire) : une case par puissance de deux >= 2 coins
+    void weldVertices(const std::vector<Vertex>& corners, MeshImporter::MeshData& mesh) {
+        TRACE_SCOPE("MeshImporter::weldVertices");
+        std::size_t capacity = 1;
+        while (capacity < corners.size() * 2) capacity <<= 1;
+        std::vector<std::uint32_t> table(capacity, 0);    // Indice de sommet + 1 (0 : vide)
+
+        mesh.vertices.clear();
+        mesh.indices.resize(corners.size());
+        for (std::size_t i = 0; i < corners.size(); ++i) {
+            const Vertex& corner = corners[i];
+            std::size_t slot = hashVertex(corner) & (capacity - 1);
+            while (true) {
+                std::uint32_t entry = table[slot];
+                if (entry == 0) {
+                    mesh.vertices.push_back(corner);
+                    table[slot] = static_cast<std::uint32_t>(mesh.vertices.size());
+                    mesh.indices[i] = static_cast<unsigned int>(mesh.vertices.size() - 1);
+                    break;
+                }
+                if (std::memcmp(&mesh.vertices[entry - 1], &corner, sizeof(Vertex)) == 0) {
+                    mesh.indices[i] = entry - 1;
+                    break;
+                }
+                slot = (slot + 1) & (capacity - 1);
+            }
+        }
+    }
+
+    // Normales lissées (pondérées par l'aire) pour les sommets sans normale
+    void computeMissingNormals(MeshImporter::MeshData& mesh) {
+        std::vector<glm::vec3> accumulated(mesh.vertices.size(), glm::vec3(0.0f));
+        std::vector<char> missing(mesh.vertices.size(), 0);
+        bool anyMissing = false;
+        for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+            const Vertex& v = mesh.vertices[i];
+            missing[i] = v.nx == 0.0f && v.ny == 0.0f && v.nz == 0.0f;
+            anyMissing = anyMissing || missing[i];
+        }
+        if (!anyMissing) return;
+
+        for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            const Vertex& a = mesh.vertices[mesh.indices[i]];
+            const Vertex& b = mesh.vertices[mesh.indices[i + 1]];
+            const Vertex& c = mesh.vertices[mesh.indices[i + 2]];
+            glm::vec3 faceNormal = glm::cross(glm::vec3(b.x - a.x, b.y - a.y, b.z - a.z),
+                                              glm::vec3(c.x - a.x, c.y - a.y, c.z - a.z));
+            for (int k = 0; k < 3; ++k) accumulated[mesh.indices[i + k]] += faceNormal;
+        }
+        for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+            if (!missing[i]) continue;
+            float length = glm::length(accumulated[i]);
+            glm::vec3 normal = length > 0.0f ? accumulated[i] / length : glm::vec3(0.0f, 1.0f, 0.0f);
+            mesh.vertices[i].nx = normal.x;
+            mesh.vertices[i].ny = normal.y;
+            mesh.vertices[i].nz = normal.z;
+        }
+    }
+}
+
+bool MeshImporter::isSupported(const std::string& path) {
+    std::string extension = getExtension(path);
+    return extension == ".obj" || extension == ".gltf" || extension == ".glb";
+}
+
+bool MeshImporter::importFile(const std::string& path, MeshData& mesh, Stats* stats, int threadCount) {
+    TRACE_SCOPE("MeshImporter::importFile");
+    Stats localStats;
+    Stats& importStats = stats ? *stats : localStats;
+    importStats = Stats();
+    importStats.threads = threadCount > 0 ? threadCount : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    auto start = Clock::now();
+    std::string source;
+    if (!isSupported(path) || !AssetPack::readAsset(path, source)) {
+        std::cerr << "Mesh failed to load at path: " << path << std::endl;
+        return false;
+    }
+    importStats.sourceBytes = source.size();
+    importStats.readMs = elapsedMs(start);
+
+    std::vector<Vertex> corners;
+    bool parsed = getExtension(path) == ".obj"
+                ? importObj(path, source, importStats.threads, corners, importStats.parseMs)
+                : importGltf(path, source, importStats.threads, corners, importStats.parseMs);
+    if (!parsed) return false;
+    if (corners.empty()) {
+        std::cerr << "Mesh has no triangles: " << path << std::endl;
+        return false;
+    }
+    importStats.corners = corners.size();
+    source.clear();
+    source.shrink_to_fit();
+
+    start = Clock::now();
+    weldVertices(corners, mesh);
+    corners.clear();
+    corners.shrink_to_fit();
+    computeMissingNormals(mesh);
+    importStats.weldMs = elapsedMs(start);
+
+    start = Clock::now();
+    importStats.acmrBefore = computeACMR(mesh.indices, mesh.vertices.size());
+    optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    optimizeVertexFetch(mesh);
+    importStats.acmrAfter = computeACMR(mesh.indices, mesh.vertices.size());
+    importStats.optimizeMs = elapsedMs(start);
+    return true;
+}
+
+void MeshImporter::optimizeVertexCache(std::vector<unsigned int>& indices, std::size_t vertexCount, int cacheSize) {
+    TRACE_SCOPE("MeshImporter::optimizeVertexCache");
+    std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) return;
+
+    // Triangles adjacents à chaque sommet (CSR)
+    std::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (unsigned int index : indices) ++adjacencyOffsets[index + 1];
+    for (std::size_t v = 0; v < vertexCount; ++v) adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    std::vector<std::uint32_t> adjacency(indices.size());
+    {
+        std::vector<std::uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+            adjacency[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<int> liveTriangles(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) liveTriangles[v] = adjacencyOffsets[v + 1] - adjacencyOffsets[v];
+    std::vector<long long> cacheTime(vertexCount, 0);
+    std::vector<char> emitted(triangleCount, 0);
+    std::vector<unsigned int> deadEnd;
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned int> output;
+    output.reserve(triangleCount * 3);
+
+    long long timestamp = cacheSize + 1;
+    std::size_t cursor = 1;
+    long long fanning = 0;
+    while (fanning >= 0) {
+        candidates.clear();
+        unsigned int vertex = static_cast<unsigned int>(fanning);
+        for (std::uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; ++a) {
+            std::uint32_t triangle = adjacency[a];
+            if (emitted[triangle]) continue;
+            for (int k = 0; k < 3; ++k) {
+                unsigned int v = indices[triangle * 3 + k];
+                output.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --liveTriangles[v];
+                if (timestamp - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = timestamp++;
+                }
+            }
+            emitted[triangle] = 1;
+        }
+
+        // Prochain sommet : encore dans le cache après l'émission de ses triangles restants
+        long long best = -1;
+        long long bestPriority = -1;
+        for (unsigned int v : candidates) {
+            if (liveTriangles[v] <= 0) continue;
+            long long priority = 0;
+            if (timestamp - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize) {
+                priority = timestamp - cacheTime[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                best = v;
+            }
+        }
+
+        // Impasse : dernier sommet émis encore actif, sinon le prochain dans l'ordre
+        if (best < 0) {
+            while (!deadEnd.empty()) {
+                unsigned int v = deadEnd.back();
+                deadEnd.pop_back();
+                if (liveTriangles[v] > 0) {
+                    best = v;
+                    break;
+                }
+            }
+            while (best < 0 && cursor < vertexCount) {
+                if (liveTriangles[cursor] > 0) best = static_cast<long long>(cursor);
+                ++cursor;
+            }
+        }
+        fanning = best;
+    }
+    indices.swap(output);
+}
+
+void MeshImporter::optimizeVertexFetch(MeshData& mesh) {
+    TRACE_SCOPE("MeshImporter::optimizeVertexFetch");
+    const unsigned int UNUSED = ~0u;
+    std::vector<unsigned int> remap(mesh.vertices.size(), UNUSED);
+    std::vector<Vertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+    for (unsigned int& index : mesh.indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+    mesh.vertices.swap(vertices);
+}
+
+float MeshImporter::computeACMR(const std::vector<unsigned int>& indices, std::size_t vertexCount, int cacheSize) {
+    if (indices.size() < 3) return 0.0f;
+
+    // Cache FIFO : un sommet y est encore si moins de 'cacheSize' défauts ont suivi son entrée
+    const std::size_t NEVER = ~std::size_t(0);
+    std::vector<std::size_t> insertedAt(vertexCount, NEVER);
+    std::size_t misses = 0;
+    for (unsigned int index : indices) {
+        if (insertedAt[index] == NEVER || misses - insertedAt[index] >= static_cast<std::size_t>(cacheSize)) {
+            insertedAt[index] = misses++;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
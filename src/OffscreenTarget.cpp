@@ -0,0 +1,73 @@
+#include "OffscreenTarget.hpp"
+#include "GLState.hpp"
+#include "ResourceManager.hpp"
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+OffscreenTarget::OffscreenTarget(int width, int height)
+    : framebuffer(0), colorBuffer(0), depthBuffer(0), width(width), height(height), complete(false) {
+
+    glGenFramebuffers(1, &framebuffer);
+    GLState::bindFramebuffer(framebuffer);
+
+    // Couleur
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+
+    // Profondeur
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+    // RGBA8 + DEPTH24 (stockée sur 32 bits)
+    ResourceManager::trackMemory(ResourceCategory::RENDER_TARGET, getByteSize());
+
+    complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!complete) {
+        std::cerr << "ERROR::OFFSCREEN_TARGET: framebuffer incomplete" << std::endl;
+    }
+
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    GLState::bindFramebuffer(0);
+}
+
+OffscreenTarget::~OffscreenTarget() {
+    glDeleteRenderbuffers(1, &depthBuffer);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    GLState::forgetFramebuffer(framebuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    ResourceManager::trackMemory(ResourceCategory::RENDER_TARGET, -getByteSize());
+}
+
+void OffscreenTarget::bind() const {
+    GLState::bindFramebuffer(framebuffer);
+}
+
+bool OffscreenTarget::saveToPPM(const std::string& path) const {
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3);
+
+    GLState::bindFramebuffer(framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open output image: " << path << std::endl;
+        return false;
+    }
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+
+    // OpenGL lit de bas en haut, le PPM s'écrit de haut en bas
+    const size_t rowSize = static_cast<size_t>(width) * 3;
+    for (int y = height - 1; y >= 0; --y) {
+        file.write(reinterpret_cast<const char*>(pixels.data() + y * rowSize), rowSize);
+    }
+
+    return static_cast<bool>(file);
+}
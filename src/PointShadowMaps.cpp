@@ -0,0 +1,164 @@
+#include "PointShadowMaps.hpp"
+#include "GLState.hpp"
+#include "ResourceManager.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    // Orientation des faces : mêmes tables que pointShadow() dans point_shadows.glsl
+    const glm::vec3 FACE_DIRECTIONS[6] = {
+        glm::vec3( 1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+        glm::vec3( 0.0f, 1.0f, 0.0f), glm::vec3( 0.0f,-1.0f, 0.0f),
+        glm::vec3( 0.0f, 0.0f, 1.0f), glm::vec3( 0.0f, 0.0f,-1.0f)
+    };
+    const glm::vec3 FACE_UPS[6] = {
+        glm::vec3(0.0f,-1.0f, 0.0f), glm::vec3(0.0f,-1.0f, 0.0f),
+        glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f,-1.0f),
+        glm::vec3(0.0f,-1.0f, 0.0f), glm::vec3(0.0f,-1.0f, 0.0f)
+    };
+
+    const char* shadowMatrixName(int face) {
+        static const std::array<std::string, 6> names = [] {
+            std::array<std::string, 6> table;
+            for (int i = 0; i < 6; ++i) {
+                table[i] = "shadowMatrices[" + std::to_string(i) + "]";
+            }
+            return table;
+        }();
+        return names[face].c_str();
+    }
+}
+
+PointShadowMaps::PointShadowMaps(int resolution)
+    : resolution(resolution), depthTexture(0), layeredFramebuffer(0), faceFramebuffers{} {
+
+    glGenTextures(1, &depthTexture);
+    GLState::bindTexture(0, GL_TEXTURE_2D_ARRAY, depthTexture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, resolution, resolution, MAX_LIGHTS * 6,
+                 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, getTextureBytes());
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // Attachement en couches : gl_Layer choisit la face dans le geometry shader
+    glGenFramebuffers(1, &layeredFramebuffer);
+    GLState::bindFramebuffer(layeredFramebuffer);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::POINT_SHADOW_MAPS: layered framebuffer incomplete" << std::endl;
+    }
+
+    // Un framebuffer par couche pour le rendu face par face
+    glGenFramebuffers(MAX_LIGHTS * 6, faceFramebuffers);
+    for (int layer = 0; layer < MAX_LIGHTS * 6; ++layer) {
+        GLState::bindFramebuffer(faceFramebuffers[layer]);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture, 0, layer);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+    }
+    GLState::bindFramebuffer(0);
+}
+
+PointShadowMaps::~PointShadowMaps() {
+    GLState::forgetFramebuffer(layeredFramebuffer);
+    for (GLuint framebuffer : faceFramebuffers) {
+        GLState::forgetFramebuffer(framebuffer);
+    }
+    GLState::forgetTexture(depthTexture);
+    glDeleteFramebuffers(1, &layeredFramebuffer);
+    glDeleteFramebuffers(MAX_LIGHTS * 6, faceFramebuffers);
+    glDeleteTextures(1, &depthTexture);
+    ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, -getTextureBytes());
+}
+
+void PointShadowMaps::update(LightManager& lightManager, const glm::vec3& cameraPosition,
+                             const glm::mat4& viewProjection, float tanHalfFov, const ShadowSettings& settings) {
+    TRACE_SCOPE("PointShadowMaps::update");
+
+    lights.clear();
+    candidates.clear();
+    Frustum viewFrustum(viewProjection);
+
+    for (auto& light : lightManager.getLights()) {
+        if (light->type != LightType::POINT) continue;
+        PointLight* point = static_cast<PointLight*>(light.get());
+        point->shadowParams = glm::vec4(0.0f);
+        if (!point->enabled || !settings.pointShadows) continue;
+
+        float range = std::min(point->getRange(), settings.maxDistance);
+        if (!viewFrustum.intersectsSphere(point->position, range)) continue;
+
+        // Même heuristique que la shadow atlas : intensité x taille projetée de la zone d'influence
+        float distance = std::max(glm::length(point->position - cameraPosition), range);
+        float projectedSize = std::min(range / (distance * tanHalfFov), 1.0f);
+        candidates.emplace_back(projectedSize * point->intensity, point);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+    if (candidates.size() > MAX_LIGHTS) {
+        candidates.resize(MAX_LIGHTS);
+    }
+
+    for (const auto& [importance, point] : candidates) {
+        ShadowedLight shadowed;
+        shadowed.light = point;
+        shadowed.firstLayer = static_cast<int>(lights.size()) * 6;
+        shadowed.farPlane = std::min(point->getRange(), settings.maxDistance);
+
+        glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, shadowed.farPlane);
+        for (int face = 0; face < 6; ++face) {
+            glm::mat4 view = glm::lookAt(point->position, point->position + FACE_DIRECTIONS[face], FACE_UPS[face]);
+            shadowed.faceMatrices[face] = projection * view;
+            shadowed.faceFrustums[face] = Frustum(shadowed.faceMatrices[face]);
+        }
+
+        point->shadowParams = glm::vec4(static_cast<float>(shadowed.firstLayer), shadowed.farPlane, 0.0f, 1.0f);
+        lights.push_back(shadowed);
+    }
+}
+
+int PointShadowMaps::computeFaceMask(const ShadowedLight& shadowed, const DrawItem& item) const {
+    // Hors de la zone d'influence : aucune face
+    float reach = shadowed.farPlane + item.radius;
+    glm::vec3 offset = item.center - shadowed.light->position;
+    if (glm::dot(offset, offset) > reach * reach) return 0;
+
+    int mask = 0;
+    for (int face = 0; face < 6; ++face) {
+        if (shadowed.faceFrustums[face].intersectsSphere(item.center, item.radius)) {
+            mask |= 1 << face;
+        }
+    }
+    return mask;
+}
+
+void PointShadowMaps::beginSinglePass() const {
+    GLState::bindFramebuffer(layeredFramebuffer);
+    GLState::setViewport(0, 0, resolution, resolution);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void PointShadowMaps::applySinglePassUniforms(Shader& shader, const ShadowedLight& shadowed) const {
+    for (int face = 0; face < 6; ++face) {
+        shader.setUniform(shadowMatrixName(face), shadowed.faceMatrices[face]);
+    }
+    shader.setUniform("firstLayer", shadowed.firstLayer);
+    shader.setUniform("lightPos", shadowed.light->position);
+    shader.setUniform("farPlane", shadowed.farPlane);
+}
+
+void PointShadowMaps::beginFace(const ShadowedLight& shadowed, int face) const {
+    GLState::bindFramebuffer(faceFramebuffers[shadowed.firstLayer + face]);
+    GLState::setViewport(0, 0, resolution, resolution);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
@@ -0,0 +1,170 @@
+#include "ProgramCache.hpp"
+#include "CacheFile.hpp"
+#include "Hash.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace {
+    std::string cacheDirectory = "shader_cache";
+    bool cacheEnabled = true;
+    ProgramCache::Stats cacheStats;
+    std::mutex statsMutex;  // Les programmes peuvent être compilés par le thread du ShaderCompiler
+
+    // En-tête d'une entrée du cache
+    struct EntryHeader {
+        char magic[8];
+        std::uint64_t key;
+        std::uint32_t format;
+        std::uint32_t length;
+    };
+
+    const char ENTRY_MAGIC[8] = {'G', 'L', 'P', 'R', 'O', 'G', '0', '1'};
+
+    // Hash des chaînes du driver, calculé une fois (nécessite un contexte courant)
+    std::uint64_t driverHash() {
+        static const std::uint64_t hash = [] {
+            std::uint64_t h = FNV_OFFSET_BASIS;
+            for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+                const char* value = reinterpret_cast<const char*>(glGetString(name));
+                h = hashString(value ? value : "", h);
+            }
+            return h;
+        }();
+        return hash;
+    }
+}
+
+void ProgramCache::setDirectory(const std::string& directory) {
+    cacheDirectory = directory;
+}
+
+const std::string& ProgramCache::getDirectory() {
+    return cacheDirectory;
+}
+
+void ProgramCache::setEnabled(bool enabled) {
+    cacheEnabled = enabled;
+}
+
+bool ProgramCache::isEnabled() {
+    return cacheEnabled && isSupported();
+}
+
+bool ProgramCache::isSupported() {
+    static const bool supported = [] {
+        if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary) return false;
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        return formats > 0;
+    }();
+    return supported;
+}
+
+std::uint64_t ProgramCache::computeKey(std::initializer_list<std::string_view> sources) {
+    std::uint64_t key = driverHash();
+    for (std::string_view source : sources) {
+        key = hashString(source, key);
+    }
+    return key;
+}
+
+std::string ProgramCache::getEntryPath(std::uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(cacheDirectory) / name).string();
+}
+
+bool ProgramCache::load(GLuint program, std::uint64_t key) {
+    if (!isEnabled()) return false;
+
+    std::string path = getEntryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    EntryHeader header;
+    std::vector<char> binary;
+    bool valid = false;
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+        std::memcmp(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) == 0 &&
+        header.key == key) {
+        binary.resize(header.length);
+        valid = static_cast<bool>(file.read(binary.data(), header.length));
+    }
+    file.close();
+
+    if (valid) {
+        glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked) return true;
+    }
+
+    // Entrée corrompue ou refusée par le driver (mise à jour...) : invalidation
+    std::cerr << "Program cache: discarding stale entry " << path << std::endl;
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    return false;
+}
+
+void ProgramCache::prepare(GLuint program) {
+    if (!isEnabled()) return;
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void ProgramCache::store(GLuint program, std::uint64_t key) {
+    if (!isEnabled()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, NULL, &format, binary.data());
+
+    // Fichier temporaire puis renommage : jamais d'entrée à moitié écrite
+    writeCacheFile(getEntryPath(key), [&](std::ostream& file) {
+        EntryHeader header;
+        std::memcpy(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+        header.key = key;
+        header.format = format;
+        header.length = static_cast<std::uint32_t>(length);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), length);
+    });
+}
+
+void ProgramCache::recordBuild(bool cacheHit, double milliseconds) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    if (cacheHit) {
+        ++cacheStats.hits;
+        cacheStats.hitMs += milliseconds;
+    } else {
+        ++cacheStats.misses;
+        cacheStats.missMs += milliseconds;
+    }
+}
+
+ProgramCache::Stats ProgramCache::getStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return cacheStats;
+}
+
+void ProgramCache::printReport() {
+    Stats cacheStats = getStats();
+    if (!isEnabled()) {
+        std::cout << "Program cache: disabled (" << cacheStats.misses << " programs compiled in "
+                  << cacheStats.missMs << " ms)" << std::endl;
+        return;
+    }
+
+    const char* state = cacheStats.misses == 0 ? "warm" : (cacheStats.hits == 0 ? "cold" : "partial");
+    std::cout << "Program cache (" << state << "): " << cacheStats.hits << " loaded in " << cacheStats.hitMs
+              << " ms, " << cacheStats.misses << " compiled in " << cacheStats.missMs << " ms" << std::endl;
+}
@@ -0,0 +1,64 @@
+#include "RenderList.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+
+glm::mat4 SceneObject::getModelMatrix(float time) const {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+    if (rotationSpeed != 0.0f) {
+        model = glm::rotate(model, time * rotationSpeed, rotationAxis);
+    }
+    return glm::scale(model, scale);
+}
+
+void buildRenderList(const std::vector<SceneObject>& objects, float time, RenderList& out) {
+    out.clear();
+    appendRenderList(objects, time, out);
+}
+
+void appendRenderList(const std::vector<SceneObject>& objects, float time, RenderList& out) {
+    TRACE_SCOPE("buildRenderList");
+    out.reserve(out.size() + objects.size());
+
+    for (const auto& object : objects) {
+        const Geometry* geometry = ResourceManager::getGeometry(object.geometry);
+        if (!geometry || !geometry->isInitialized()) continue;
+
+        DrawItem item;
+        item.geometry = geometry;
+        item.handle = object.geometry;
+        item.material = &object.material;
+        item.model = object.getModelMatrix(time);
+        item.center = glm::vec3(item.model * glm::vec4(geometry->getBoundsCenter(), 1.0f));
+
+        // Rayon mis à l'échelle par le plus grand facteur de la matrice modèle
+        float maxScale = std::max({glm::length(glm::vec3(item.model[0])),
+                                   glm::length(glm::vec3(item.model[1])),
+                                   glm::length(glm::vec3(item.model[2]))});
+        item.radius = geometry->getBoundsRadius() * maxScale;
+        item.isStatic = object.isStatic();
+
+        out.push_back(item);
+    }
+}
+
+void cullRenderList(const RenderList& items, const Frustum& frustum, CullResult& out) {
+    TRACE_SCOPE("cullRenderList");
+    out.clear();
+    out.reserve(items.size());
+
+    for (const auto& item : items) {
+        if (frustum.intersectsSphere(item.center, item.radius)) {
+            out.push_back(&item);
+        }
+    }
+}
+
+void sortFrontToBack(CullResult& items, const glm::vec3& viewPosition) {
+    TRACE_SCOPE("sortFrontToBack");
+    std::sort(items.begin(), items.end(), [&viewPosition](const DrawItem* a, const DrawItem* b) {
+        glm::vec3 toA = a->center - viewPosition;
+        glm::vec3 toB = b->center - viewPosition;
+        return glm::dot(toA, toA) < glm::dot(toB, toB);
+    });
+}
@@ -0,0 +1,260 @@
+#include "ResourceManager.hpp"
+#include "AsyncLoader.hpp"
+#include "Frustum.hpp"
+#include "Geometry.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace {
+    enum class SlotState {
+        FREE,
+        RESIDENT,
+        EVICTED,        // Buffers libérés, rechargeable depuis sourcePath
+        LOADING
+    };
+
+    struct GeometrySlot {
+        std::unique_ptr<Geometry> geometry;
+        std::string name;
+        std::string sourcePath;         // Vide : non streamable
+        std::uint32_t generation = 1;
+        std::uint32_t sourceVersion = 0;    // Incrémentée à chaque modification de la source
+        SlotState state = SlotState::FREE;
+        std::uint64_t lastVisibleFrame = 0;
+        glm::vec3 worldCenter = glm::vec3(0.0f);
+        float worldRadius = -1.0f;      // < 0 : jamais dessinée
+    };
+
+    std::vector<GeometrySlot> slots;
+    std::vector<std::uint32_t> freeSlots;
+    std::uint64_t currentFrame = 1;
+
+    ResourceManager::CategoryStats categoryStats[static_cast<int>(ResourceCategory::COUNT)];
+    std::size_t budgetBytes = 0;
+    int evictionCount = 0;
+    int reloadCount = 0;
+
+    GeometrySlot* findSlot(GeometryHandle handle) {
+        if (!handle.isValid() || handle.index >= slots.size()) return nullptr;
+        GeometrySlot& slot = slots[handle.index];
+        if (slot.generation != handle.generation || slot.state == SlotState::FREE) return nullptr;
+        return &slot;
+    }
+
+    std::size_t getTotalBytes() {
+        std::size_t total = 0;
+        for (const ResourceManager::CategoryStats& category : categoryStats) {
+            total += category.bytes;
+        }
+        return total;
+    }
+
+    // La géométrie rechargée remplace l'évincée si la poignée est toujours la même
+    Task<bool> reloadGeometry(GeometryHandle handle, std::string sourcePath) {
+        std::unique_ptr<Geometry> geometry = std::make_unique<Geometry>();
+        bool loaded = co_await AsyncLoader::loadMesh(sourcePath, geometry.get());
+
+        GeometrySlot* slot = findSlot(handle);
+        if (!slot || slot->state != SlotState::LOADING) co_return loaded;
+        if (loaded) {
+            slot->geometry = std::move(geometry);
+            slot->state = SlotState::RESIDENT;
+            slot->lastVisibleFrame = currentFrame;
+            ++reloadCount;
+        } else {
+            // Source devenue illisible : la géométrie reste évincée, sans nouvelle tentative
+            slot->sourcePath.clear();
+            slot->state = SlotState::EVICTED;
+        }
+        co_return loaded;
+    }
+
+    // Source modifiée : la géométrie en place reste dessinée jusqu'à ce que la nouvelle version
+    // soit chargée. Une modification plus récente ou une éviction entre-temps l'emporte.
+    Task<bool> refreshGeometry(GeometryHandle handle, std::string sourcePath, std::uint32_t sourceVersion) {
+        std::unique_ptr<Geometry> geometry = std::make_unique<Geometry>();
+        bool loaded = co_await AsyncLoader::loadMesh(sourcePath, geometry.get());
+
+        GeometrySlot* slot = findSlot(handle);
+        if (!slot || slot->sourceVersion != sourceVersion || slot->state == SlotState::EVICTED) co_return loaded;
+        if (loaded) {
+            // Remplace aussi un rechargement après éviction encore en cours, qui lisait l'ancienne source
+            slot->geometry = std::move(geometry);
+            slot->state = SlotState::RESIDENT;
+            slot->lastVisibleFrame = currentFrame;
+        } else {
+            std::cerr << "ResourceManager: cannot reload " << slot->name << " from " << sourcePath
+                      << ", keeping the previous version" << std::endl;
+        }
+        co_return loaded;
+    }
+}
+
+const char* getResourceCategoryName(ResourceCategory category) {
+    switch (category) {
+        case ResourceCategory::GEOMETRY:      return "Geometry";
+        case ResourceCategory::TEXTURE:       return "Textures";
+        case ResourceCategory::SHADOW_MAP:    return "Shadow maps";
+        case ResourceCategory::RENDER_TARGET: return "Render targets";
+        default:                              return "Unknown";
+    }
+}
+
+GeometryHandle ResourceManager::addGeometry(std::unique_ptr<Geometry> geometry, const std::string& name,
+                                            const std::string& sourcePath) {
+    std::uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    GeometrySlot& slot = slots[index];
+    slot.geometry = std::move(geometry);
+    slot.name = name;
+    slot.sourcePath = sourcePath;
+    slot.state = SlotState::RESIDENT;
+    slot.lastVisibleFrame = currentFrame;
+    slot.worldRadius = -1.0f;
+    return GeometryHandle{index, slot.generation};
+}
+
+Geometry* ResourceManager::getGeometry(GeometryHandle handle) {
+    GeometrySlot* slot = findSlot(handle);
+    return slot ? slot->geometry.get() : nullptr;
+}
+
+void ResourceManager::release(GeometryHandle handle) {
+    GeometrySlot* slot = findSlot(handle);
+    if (!slot) return;
+
+    // Un rechargement en cours trouvera une poignée périmée et abandonnera son résultat
+    slot->geometry.reset();
+    slot->name.clear();
+    slot->sourcePath.clear();
+    slot->state = SlotState::FREE;
+    if (++slot->generation == 0) slot->generation = 1;
+    freeSlots.push_back(handle.index);
+}
+
+void ResourceManager::reloadSource(GeometryHandle handle) {
+    GeometrySlot* slot = findSlot(handle);
+    if (!slot || slot->sourcePath.empty()) return;
+
+    // Évincée : le prochain rechargement lira déjà la nouvelle source
+    ++slot->sourceVersion;
+    if (slot->state == SlotState::EVICTED) return;
+    refreshGeometry(handle, slot->sourcePath, slot->sourceVersion);
+}
+
+void ResourceManager::markVisible(GeometryHandle handle, const glm::vec3& center, float radius) {
+    if (!handle.isValid() || handle.index >= slots.size()) return;
+    GeometrySlot& slot = slots[handle.index];
+    if (slot.generation != handle.generation) return;
+    slot.lastVisibleFrame = currentFrame;
+    slot.worldCenter = center;
+    slot.worldRadius = radius;
+}
+
+void ResourceManager::update(const Frustum& viewFrustum) {
+    TRACE_SCOPE("ResourceManager::update");
+
+    // Géométries évincées dont la dernière position connue est de nouveau dans le champ
+    std::vector<std::uint32_t> evictable;
+    for (std::uint32_t index = 0; index < slots.size(); ++index) {
+        GeometrySlot& slot = slots[index];
+        if (slot.sourcePath.empty()) continue;
+
+        if (slot.state == SlotState::EVICTED && slot.worldRadius >= 0.0f &&
+            viewFrustum.intersectsSphere(slot.worldCenter, slot.worldRadius)) {
+            slot.state = SlotState::LOADING;
+            reloadGeometry(GeometryHandle{index, slot.generation}, slot.sourcePath);
+        } else if (slot.state == SlotState::RESIDENT && slot.worldRadius >= 0.0f &&
+                   slot.lastVisibleFrame + 1 < currentFrame) {
+            // Ni visible cette frame ni la précédente. Une géométrie jamais dessinée n'a pas
+            // de position connue pour déclencher son rechargement : elle reste résidente.
+            evictable.push_back(index);
+        }
+    }
+
+    if (budgetBytes > 0 && getTotalBytes() > budgetBytes && !evictable.empty()) {
+        std::sort(evictable.begin(), evictable.end(), [](std::uint32_t a, std::uint32_t b) {
+            return slots[a].lastVisibleFrame < slots[b].lastVisibleFrame;
+        });
+        for (std::uint32_t index : evictable) {
+            if (getTotalBytes() <= budgetBytes) break;
+            // Buffers GL libérés ; l'objet garde sa sphère englobante
+            slots[index].geometry->cleanup();
+            slots[index].state = SlotState::EVICTED;
+            ++evictionCount;
+        }
+    }
+
+    ++currentFrame;
+}
+
+void ResourceManager::trackMemory(ResourceCategory category, std::int64_t bytes) {
+    CategoryStats& stats = categoryStats[static_cast<int>(category)];
+    if (bytes >= 0) {
+        stats.bytes += static_cast<std::size_t>(bytes);
+        ++stats.count;
+    } else {
+        stats.bytes -= std::min(stats.bytes, static_cast<std::size_t>(-bytes));
+        --stats.count;
+    }
+}
+
+void ResourceManager::setBudget(std::size_t bytes) {
+    budgetBytes = bytes;
+}
+
+std::size_t ResourceManager::getBudget() {
+    return budgetBytes;
+}
+
+ResourceManager::Stats ResourceManager::getStats() {
+    Stats stats;
+    for (int i = 0; i < static_cast<int>(ResourceCategory::COUNT); ++i) {
+        stats.categories[i] = categoryStats[i];
+    }
+    stats.totalBytes = getTotalBytes();
+    stats.budgetBytes = budgetBytes;
+    for (const GeometrySlot& slot : slots) {
+        if (slot.state == SlotState::FREE) continue;
+        ++stats.geometries;
+        // Une géométrie dont le rechargement a échoué reste comptée comme évincée
+        bool streamable = !slot.sourcePath.empty() || slot.state != SlotState::RESIDENT;
+        if (!streamable) continue;
+        ++stats.streamable;
+        if (slot.state == SlotState::RESIDENT) ++stats.resident;
+        if (slot.state == SlotState::LOADING) ++stats.loading;
+    }
+    stats.evictions = evictionCount;
+    stats.reloads = reloadCount;
+    return stats;
+}
+
+void ResourceManager::printReport() {
+    Stats stats = getStats();
+    std::cout << "GPU memory: " << static_cast<double>(stats.totalBytes) / (1024.0 * 1024.0) << " MB";
+    if (stats.budgetBytes > 0) {
+        std::cout << " / " << static_cast<double>(stats.budgetBytes) / (1024.0 * 1024.0) << " MB budget";
+    }
+    std::cout << " (";
+    for (int i = 0; i < static_cast<int>(ResourceCategory::COUNT); ++i) {
+        std::cout << (i > 0 ? ", " : "") << getResourceCategoryName(static_cast<ResourceCategory>(i)) << " "
+                  << static_cast<double>(stats.categories[i].bytes) / (1024.0 * 1024.0) << " MB";
+    }
+    std::cout << "); " << stats.geometries << " geometries, " << stats.resident << "/" << stats.streamable
+              << " streamable resident, " << stats.evictions << " evictions, " << stats.reloads << " reloads"
+              << std::endl;
+}
+
+void ResourceManager::clear() {
+    slots.clear();
+    freeSlots.clear();
+}
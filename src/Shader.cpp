@@ -1,130 +1,267 @@
 #include "Shader.hpp"
-#include <fstream>
+#include "AssetPack.hpp"
+#include "Trace.hpp"
+#include "ProgramCache.hpp"
+#include "GLState.hpp"
+#include <chrono>
+#include <filesystem>
 #include <sstream>
 #include <iostream>
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
-    // 1. Retrieve vertex/fragment source code from file paths
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
-
-    // Ensure ifstream objects can throw exceptions
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-    try {
-        // Open files
-        vShaderFile.open(vertexPath);
-        fShaderFile.open(fragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-
-        // Read file's buffer contents into streams
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
-
-        // Close file handlers
-        vShaderFile.close();
-        fShaderFile.close();
-
-        // Convert stream into string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, const ShaderDefines& defines)
+        : Shader(vertexPath, fragmentPath, defines, Deferred{}) {
+    // Synchronous build: compile, link and check immediately
+    beginBuild();
+    finishBuild();
+}
+
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, const ShaderDefines& defines, Deferred)
+        : Shader(vertexPath, std::string(), fragmentPath, defines, Deferred{}) {
+}
+
+Shader::Shader(const std::string& vertexPath, const std::string& geometryPath, const std::string& fragmentPath,
+               const ShaderDefines& defines)
+        : Shader(vertexPath, geometryPath, fragmentPath, defines, Deferred{}) {
+    beginBuild();
+    finishBuild();
+}
+
+Shader::Shader(const std::string& vertexPath, const std::string& geometryPath, const std::string& fragmentPath,
+               const ShaderDefines& defines, Deferred)
+        : programID(0), vertexShaderID(0), geometryShaderID(0), fragmentShaderID(0),
+          vertexPath(vertexPath), geometryPath(geometryPath), fragmentPath(fragmentPath), defines(defines),
+          cacheKey(0), cacheHit(false), status(Status::PENDING) {
+    TRACE_SCOPE("Shader::Shader");
+
+    // 1. Retrieve the stage sources, resolve #include and inject the defines
+    vertexCode = preprocess(vertexPath, defines, sourceFiles);
+    if (!geometryPath.empty()) {
+        geometryCode = preprocess(geometryPath, defines, sourceFiles);
+    }
+    fragmentCode = preprocess(fragmentPath, defines, sourceFiles);
+}
+
+std::unique_ptr<Shader> Shader::createReloaded() const {
+    return std::make_unique<Shader>(vertexPath, geometryPath, fragmentPath, defines, Deferred{});
+}
+
+bool Shader::dependsOn(const std::string& canonicalPath) const {
+    return sourceFiles.count(canonicalPath) > 0;
+}
+
+void Shader::swapProgram(Shader& other) {
+    std::swap(programID, other.programID);
+    std::swap(sourceFiles, other.sourceFiles);
+}
+
+bool Shader::readFile(const std::string& path, std::string& content) {
+    // Archive d'assets montée en priorité, fichier sur disque sinon
+    if (!AssetPack::readAsset(path, content)) {
+        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
+        std::cerr << "Path: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Shader::expandIncludes(const std::string& path, std::set<std::string>& included, std::string& output) {
+    // Chaque fichier n'est inclus qu'une fois (comme #pragma once)
+    std::string canonicalPath = std::filesystem::weakly_canonical(path).string();
+    if (!included.insert(canonicalPath).second) return;
+
+    std::string source;
+    if (!readFile(path, source)) return;
+
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    std::istringstream lines(source);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::size_t start = line.find_first_not_of(" \t");
+        if (start != std::string::npos && line.compare(start, 8, "#include") == 0) {
+            // #include "chemin" relatif au fichier courant
+            std::size_t open = line.find('"', start + 8);
+            std::size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+            if (close == std::string::npos) {
+                std::cerr << "ERROR::SHADER::INVALID_INCLUDE in " << path << ": " << line << std::endl;
+                continue;
+            }
+            expandIncludes((directory / line.substr(open + 1, close - open - 1)).string(), included, output);
+            continue;
+        }
+        output += line;
+        output += '\n';
+    }
+}
+
+std::string Shader::preprocess(const std::string& path, const ShaderDefines& defines, std::set<std::string>& included) {
+    std::string expanded;
+    expandIncludes(path, included, expanded);
+
+    // Les defines doivent suivre la directive #version
+    std::string defineBlock;
+    for (const auto& [name, value] : defines) {
+        defineBlock += "#define " + name + " " + value + "\n";
     }
-    catch (std::ifstream::failure& e) {
-        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: " << e.what() << std::endl;
-        std::cerr << "Vertex path: " << vertexPath << std::endl;
-        std::cerr << "Fragment path: " << fragmentPath << std::endl;
+    if (defineBlock.empty()) return expanded;
+
+    std::size_t insertAt = 0;
+    std::size_t version = expanded.find("#version");
+    if (version != std::string::npos) {
+        std::size_t endOfLine = expanded.find('\n', version);
+        insertAt = endOfLine == std::string::npos ? expanded.size() : endOfLine + 1;
     }
+    expanded.insert(insertAt, defineBlock);
+    return expanded;
+}
+
+void Shader::beginBuild() {
+    buildStart = std::chrono::steady_clock::now();
+
+    // 2. Try the on-disk program binary cache first
+    cacheKey = geometryCode.empty() ? ProgramCache::computeKey({vertexCode, fragmentCode})
+                                    : ProgramCache::computeKey({vertexCode, geometryCode, fragmentCode});
+    programID = glCreateProgram();
+    cacheHit = ProgramCache::load(programID, cacheKey);
+    if (cacheHit) return;
 
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
-    // 2. Compile shaders
-    GLuint vertex, fragment;
+    // 3. Submit compilation and link; errors are only queried in finishBuild() so
+    // that a driver with GL_KHR_parallel_shader_compile can work in the background
+    vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShaderID, 1, &vShaderCode, NULL);
+    glCompileShader(vertexShaderID);
 
-    // Vertex shader
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, NULL);
-    glCompileShader(vertex);
-    checkCompileErrors(vertex, "VERTEX");
+    if (!geometryCode.empty()) {
+        const char* gShaderCode = geometryCode.c_str();
+        geometryShaderID = glCreateShader(GL_GEOMETRY_SHADER);
+        glShaderSource(geometryShaderID, 1, &gShaderCode, NULL);
+        glCompileShader(geometryShaderID);
+    }
 
-    // Fragment shader
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, NULL);
-    glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT");
+    fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShaderID, 1, &fShaderCode, NULL);
+    glCompileShader(fragmentShaderID);
 
-    // 3. Create shader program
-    programID = glCreateProgram();
-    glAttachShader(programID, vertex);
-    glAttachShader(programID, fragment);
+    glAttachShader(programID, vertexShaderID);
+    if (geometryShaderID) {
+        glAttachShader(programID, geometryShaderID);
+    }
+    glAttachShader(programID, fragmentShaderID);
+    ProgramCache::prepare(programID);
     glLinkProgram(programID);
-    checkCompileErrors(programID, "PROGRAM");
+}
+
+bool Shader::isBuildComplete() const {
+    if (cacheHit || !GLEW_KHR_parallel_shader_compile) return true;
+
+    GLint complete = GL_TRUE;
+    glGetProgramiv(programID, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+void Shader::finishBuild() {
+    bool linked = true;
+    if (!cacheHit) {
+        checkCompileErrors(vertexShaderID, "VERTEX");
+        if (geometryShaderID) {
+            checkCompileErrors(geometryShaderID, "GEOMETRY");
+        }
+        checkCompileErrors(fragmentShaderID, "FRAGMENT");
+        linked = checkCompileErrors(programID, "PROGRAM");
+        if (linked) {
+            ProgramCache::store(programID, cacheKey);
+        }
+
+        // 4. Delete shaders as they're now linked and no longer needed
+        glDetachShader(programID, vertexShaderID);
+        glDetachShader(programID, fragmentShaderID);
+        glDeleteShader(vertexShaderID);
+        glDeleteShader(fragmentShaderID);
+        if (geometryShaderID) {
+            glDetachShader(programID, geometryShaderID);
+            glDeleteShader(geometryShaderID);
+        }
+        vertexShaderID = geometryShaderID = fragmentShaderID = 0;
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - buildStart;
+    ProgramCache::recordBuild(cacheHit, elapsed.count());
+
+    // Sources no longer needed once the program exists
+    vertexCode.clear();
+    vertexCode.shrink_to_fit();
+    geometryCode.clear();
+    geometryCode.shrink_to_fit();
+    fragmentCode.clear();
+    fragmentCode.shrink_to_fit();
 
-    // 4. Delete shaders as they're now linked and no longer needed
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    status.store(linked ? Status::READY : Status::FAILED, std::memory_order_release);
 }
 
 Shader::~Shader() {
+    // Compilation abandonnée en cours de route
+    if (vertexShaderID) glDeleteShader(vertexShaderID);
+    if (geometryShaderID) glDeleteShader(geometryShaderID);
+    if (fragmentShaderID) glDeleteShader(fragmentShaderID);
+    GLState::forgetProgram(programID);
     glDeleteProgram(programID);
 }
 
 void Shader::use() {
-    glUseProgram(programID);
+    GLState::useProgram(programID);
 }
 
-void Shader::setUniform(const std::string& name, bool value) {
-    glUniform1i(glGetUniformLocation(programID, name.c_str()), (int)value);
+void Shader::setUniform(const char* name, bool value) {
+    glUniform1i(glGetUniformLocation(programID, name), (int)value);
 }
 
-void Shader::setUniform(const std::string& name, int value) {
-    glUniform1i(glGetUniformLocation(programID, name.c_str()), value);
+void Shader::setUniform(const char* name, int value) {
+    glUniform1i(glGetUniformLocation(programID, name), value);
 }
 
-void Shader::setUniform(const std::string& name, float value) {
-    glUniform1f(glGetUniformLocation(programID, name.c_str()), value);
+void Shader::setUniform(const char* name, float value) {
+    glUniform1f(glGetUniformLocation(programID, name), value);
 }
 
-void Shader::setUniform(const std::string& name, const glm::vec2& value) {
-    glUniform2fv(glGetUniformLocation(programID, name.c_str()), 1, &value[0]);
+void Shader::setUniform(const char* name, const glm::vec2& value) {
+    glUniform2fv(glGetUniformLocation(programID, name), 1, &value[0]);
 }
 
-void Shader::setUniform(const std::string& name, float x, float y) {
-    glUniform2f(glGetUniformLocation(programID, name.c_str()), x, y);
+void Shader::setUniform(const char* name, float x, float y) {
+    glUniform2f(glGetUniformLocation(programID, name), x, y);
 }
 
-void Shader::setUniform(const std::string& name, const glm::vec3& value) {
-    glUniform3fv(glGetUniformLocation(programID, name.c_str()), 1, &value[0]);
+void Shader::setUniform(const char* name, const glm::vec3& value) {
+    glUniform3fv(glGetUniformLocation(programID, name), 1, &value[0]);
 }
 
-void Shader::setUniform(const std::string& name, float x, float y, float z) {
-    glUniform3f(glGetUniformLocation(programID, name.c_str()), x, y, z);
+void Shader::setUniform(const char* name, float x, float y, float z) {
+    glUniform3f(glGetUniformLocation(programID, name), x, y, z);
 }
 
-void Shader::setUniform(const std::string& name, const glm::vec4& value) {
-    glUniform4fv(glGetUniformLocation(programID, name.c_str()), 1, &value[0]);
+void Shader::setUniform(const char* name, const glm::vec4& value) {
+    glUniform4fv(glGetUniformLocation(programID, name), 1, &value[0]);
 }
 
-void Shader::setUniform(const std::string& name, float x, float y, float z, float w) {
-    glUniform4f(glGetUniformLocation(programID, name.c_str()), x, y, z, w);
+void Shader::setUniform(const char* name, float x, float y, float z, float w) {
+    glUniform4f(glGetUniformLocation(programID, name), x, y, z, w);
 }
 
-void Shader::setUniform(const std::string& name, const glm::mat2& mat) {
-    glUniformMatrix2fv(glGetUniformLocation(programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setUniform(const char* name, const glm::mat2& mat) {
+    glUniformMatrix2fv(glGetUniformLocation(programID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setUniform(const std::string& name, const glm::mat3& mat) {
-    glUniformMatrix3fv(glGetUniformLocation(programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setUniform(const char* name, const glm::mat3& mat) {
+    glUniformMatrix3fv(glGetUniformLocation(programID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setUniform(const std::string& name, const glm::mat4& mat) {
-    glUniformMatrix4fv(glGetUniformLocation(programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setUniform(const char* name, const glm::mat4& mat) {
+    glUniformMatrix4fv(glGetUniformLocation(programID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::checkCompileErrors(GLuint shader, std::string type) {
+bool Shader::checkCompileErrors(GLuint shader, std::string type) {
     GLint success;
     GLchar infoLog[1024];
 
@@ -145,6 +282,7 @@ void Shader::checkCompileErrors(GLuint shader, std::string type) {
                       << std::endl;
         }
     }
+    return success == GL_TRUE;
 }
 
 GLuint Shader::getID() const {
@@ -0,0 +1,126 @@
+#include "ShaderCompiler.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+ShaderCompiler::ShaderCompiler(GLFWwindow* mainWindow)
+        : mode(Mode::SYNCHRONOUS), workerWindow(nullptr), pendingCount(0), stopping(false) {
+    if (GLEW_KHR_parallel_shader_compile) {
+        // Laisser le driver choisir le nombre de threads de compilation
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        mode = Mode::PARALLEL_EXTENSION;
+    } else if (mainWindow) {
+        // Contexte partagé : les programmes créés par le thread sont visibles du contexte principal.
+        // Les hints de contexte (version, profil) sont ceux de la fenêtre principale.
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        workerWindow = glfwCreateWindow(1, 1, "Shader compiler", NULL, mainWindow);
+        glfwMakeContextCurrent(mainWindow);
+        if (workerWindow) {
+            mode = Mode::WORKER_THREAD;
+            worker = std::thread(&ShaderCompiler::workerLoop, this);
+        } else {
+            std::cerr << "ShaderCompiler: failed to create a shared context, compiling on the render thread" << std::endl;
+        }
+    }
+
+    std::cout << "Shader compilation: " << getModeName(mode) << std::endl;
+}
+
+ShaderCompiler::~ShaderCompiler() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueCondition.notify_one();
+        worker.join();
+    }
+    if (workerWindow) {
+        glfwDestroyWindow(workerWindow);
+    }
+}
+
+const char* ShaderCompiler::getModeName(Mode mode) {
+    switch (mode) {
+        case Mode::PARALLEL_EXTENSION: return "GL_KHR_parallel_shader_compile";
+        case Mode::WORKER_THREAD:      return "shared-context worker thread";
+        case Mode::SYNCHRONOUS:        return "synchronous";
+    }
+    return "unknown";
+}
+
+void ShaderCompiler::submit(Shader* shader) {
+    pendingCount.fetch_add(1, std::memory_order_acq_rel);
+
+    if (mode == Mode::PARALLEL_EXTENSION) {
+        // Retour immédiat : la compilation se poursuit dans les threads du driver
+        shader->beginBuild();
+        inFlight.push_back(shader);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(shader);
+    }
+    queueCondition.notify_one();
+}
+
+void ShaderCompiler::poll() {
+    TRACE_SCOPE("ShaderCompiler::poll");
+
+    if (mode == Mode::PARALLEL_EXTENSION) {
+        // Ne finaliser que les programmes terminés : aucune attente sur le driver
+        auto done = std::remove_if(inFlight.begin(), inFlight.end(), [this](Shader* shader) {
+            if (!shader->isBuildComplete()) return false;
+            shader->finishBuild();
+            pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        });
+        inFlight.erase(done, inFlight.end());
+    } else if (mode == Mode::SYNCHRONOUS && !queue.empty()) {
+        Shader* shader = queue.front();
+        queue.pop_front();
+        shader->beginBuild();
+        shader->finishBuild();
+        pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    // WORKER_THREAD : le thread marque lui-même les shaders READY
+}
+
+void ShaderCompiler::waitIdle() {
+    TRACE_SCOPE("ShaderCompiler::waitIdle");
+
+    while (getPendingCount() > 0) {
+        poll();
+        if (mode != Mode::SYNCHRONOUS) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void ShaderCompiler::workerLoop() {
+    TRACE_THREAD_NAME("shader_compiler");
+    glfwMakeContextCurrent(workerWindow);
+
+    while (true) {
+        Shader* shader = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) break;
+            shader = queue.front();
+            queue.pop_front();
+        }
+
+        TRACE_SCOPE("ShaderCompiler::compile");
+        shader->beginBuild();
+        // Le programme doit être complètement lié avant d'être utilisé par le contexte principal
+        glFinish();
+        shader->finishBuild();
+        pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    glfwMakeContextCurrent(NULL);
+}
@@ -0,0 +1,81 @@
+#include "ShaderVariants.hpp"
+#include "ShaderCompiler.hpp"
+#include "Trace.hpp"
+
+std::uint32_t ShaderVariantKey::pack() const {
+    return (shadows ? 1u : 0u)
+         | (static_cast<std::uint32_t>(numDirLights & 0xF) << 1)
+         | (static_cast<std::uint32_t>(numPointLights & 0xF) << 5)
+         | (static_cast<std::uint32_t>(numSpotLights & 0xF) << 9)
+         | (static_cast<std::uint32_t>(pcfTaps & 0xF) << 13)
+         | (static_cast<std::uint32_t>(shadowFilter & 0x3) << 17);
+}
+
+ShaderDefines ShaderVariantKey::toDefines() const {
+    return {
+        {"LIGHT_PERMUTATION", "1"},
+        {"SHADOWS", shadows ? "1" : "0"},
+        {"NUM_DIR_LIGHTS", std::to_string(numDirLights)},
+        {"NUM_POINT_LIGHTS", std::to_string(numPointLights)},
+        {"NUM_SPOT_LIGHTS", std::to_string(numSpotLights)},
+        {"PCF_TAPS", std::to_string(pcfTaps)},
+        {"SHADOW_FILTER", std::to_string(shadowFilter)}
+    };
+}
+
+ShaderVariants::ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath, ShaderCompiler* compiler)
+        : vertexPath(vertexPath), fragmentPath(fragmentPath), compiler(compiler) {}
+
+Shader& ShaderVariants::request(const ShaderVariantKey& key) {
+    std::unique_ptr<Shader>& variant = variants[key.pack()];
+    if (!variant) {
+        if (compiler) {
+            variant = std::make_unique<Shader>(vertexPath, fragmentPath, key.toDefines(), Shader::Deferred{});
+            compiler->submit(variant.get());
+        } else {
+            TRACE_SCOPE("ShaderVariants::compile");
+            variant = std::make_unique<Shader>(vertexPath, fragmentPath, key.toDefines());
+        }
+    }
+    return *variant;
+}
+
+Shader& ShaderVariants::get(const ShaderVariantKey& key) {
+    Shader& variant = request(key);
+    return variant.isReady() ? variant : getGeneric();
+}
+
+Shader& ShaderVariants::getGeneric() {
+    if (!generic) {
+        generic = std::make_unique<Shader>(vertexPath, fragmentPath);
+    } else if (!generic->isReady() && generic->getStatus() == Shader::Status::PENDING && compiler) {
+        // Le repli doit être utilisable : attendre la fin du warm-up
+        compiler->waitIdle();
+    }
+    return *generic;
+}
+
+void ShaderVariants::warmUp(const std::vector<ShaderVariantKey>& keys) {
+    if (!generic && compiler) {
+        generic = std::make_unique<Shader>(vertexPath, fragmentPath, ShaderDefines{}, Shader::Deferred{});
+        compiler->submit(generic.get());
+    }
+    for (const ShaderVariantKey& key : keys) {
+        request(key);
+    }
+}
+
+void ShaderVariants::forEachShader(const std::function<void(Shader&)>& visit) {
+    if (generic) visit(*generic);
+    for (auto& [packedKey, variant] : variants) {
+        visit(*variant);
+    }
+}
+
+size_t ShaderVariants::getReadyCount() const {
+    size_t ready = 0;
+    for (const auto& [packedKey, variant] : variants) {
+        if (variant->isReady()) ++ready;
+    }
+    return ready;
+}
@@ -0,0 +1,175 @@
+#include "ShadowAtlas.hpp"
+#include "Frustum.hpp"
+#include "GLState.hpp"
+#include "ResourceManager.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <glm/gtc/matrix_transform.hpp>
+
+ShadowAtlas::ShadowAtlas(int size) : size(size), depthTexture(0), framebuffer(0) {
+    glGenTextures(1, &depthTexture);
+    GLState::bindTexture(0, GL_TEXTURE_2D, depthTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, getTextureBytes());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &framebuffer);
+    GLState::bindFramebuffer(framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::SHADOW_ATLAS: framebuffer incomplete" << std::endl;
+    }
+    GLState::bindFramebuffer(0);
+
+    int levels = 1;
+    while ((size >> levels) >= MIN_TILE_SIZE) {
+        ++levels;
+    }
+    freeBlocks.resize(levels);
+}
+
+ShadowAtlas::~ShadowAtlas() {
+    GLState::forgetFramebuffer(framebuffer);
+    GLState::forgetTexture(depthTexture);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &depthTexture);
+    ResourceManager::trackMemory(ResourceCategory::SHADOW_MAP, -getTextureBytes());
+}
+
+void ShadowAtlas::update(LightManager& lightManager, const glm::vec3& cameraPosition, const glm::mat4& viewProjection,
+                         float tanHalfFov, const ShadowSettings& settings) {
+    TRACE_SCOPE("ShadowAtlas::update");
+
+    tiles.clear();
+    candidates.clear();
+    Frustum viewFrustum(viewProjection);
+
+    for (auto& light : lightManager.getLights()) {
+        if (light->type != LightType::SPOT) continue;
+        SpotLight* spot = static_cast<SpotLight*>(light.get());
+        spot->shadowRect = glm::vec4(0.0f);
+        if (!spot->enabled || !settings.spotShadows) continue;
+
+        // Zone d'influence hors champ : pas d'ombre visible
+        float range = std::min(spot->getRange(), settings.maxDistance);
+        if (!viewFrustum.intersectsSphere(spot->position, range)) continue;
+
+        // Taille projetée de la zone d'influence (1 = tout l'écran), pondérée par l'intensité
+        float distance = std::max(glm::length(spot->position - cameraPosition), range);
+        float projectedSize = std::min(range / (distance * tanHalfFov), 1.0f);
+
+        Tile candidate;
+        candidate.light = spot;
+        candidate.importance = projectedSize * spot->intensity;
+        candidates.push_back(candidate);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Tile& a, const Tile& b) { return a.importance > b.importance; });
+
+    resetAllocator();
+    float maxImportance = candidates.empty() ? 1.0f : candidates.front().importance;
+    int maxTile = std::clamp(settings.atlasMaxTileSize, MIN_TILE_SIZE, size / 2);
+
+    for (Tile& candidate : candidates) {
+        // Taille proportionnelle à l'importance relative, arrondie à la puissance de deux inférieure
+        float wanted = maxTile * candidate.importance / maxImportance;
+        int tileSize = MIN_TILE_SIZE;
+        while (tileSize * 2 <= wanted && tileSize * 2 <= maxTile) {
+            tileSize *= 2;
+        }
+
+        glm::ivec2 origin(-1);
+        while (tileSize >= MIN_TILE_SIZE && (origin = allocate(tileSize)).x < 0) {
+            tileSize /= 2;
+        }
+        if (origin.x < 0) break;    // Atlas plein : les spots suivants n'ont pas d'ombre
+
+        SpotLight* spot = candidate.light;
+        float fov = std::min(2.0f * spot->outerCutOff + 5.0f, 170.0f);
+        float nearPlane = 0.1f;
+        float farPlane = std::min(spot->getRange(), settings.maxDistance);
+        glm::vec3 up = std::abs(spot->direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::mat4 lightView = glm::lookAt(spot->position, spot->position + spot->direction, up);
+        glm::mat4 lightProjection = glm::perspective(glm::radians(fov), 1.0f, nearPlane, farPlane);
+
+        candidate.rect = glm::ivec4(origin, tileSize, tileSize);
+        candidate.matrix = lightProjection * lightView;
+        tiles.push_back(candidate);
+
+        float invSize = 1.0f / size;
+        spot->shadowMatrix = candidate.matrix;
+        spot->shadowRect = glm::vec4(origin.x * invSize, origin.y * invSize, tileSize * invSize, tileSize * invSize);
+        spot->shadowParams = glm::vec4(2.0f * std::tan(glm::radians(fov) * 0.5f) / tileSize, nearPlane, farPlane, 0.0f);
+    }
+}
+
+void ShadowAtlas::begin() const {
+    GLState::bindFramebuffer(framebuffer);
+    GLState::setEnabled(GL_SCISSOR_TEST, false);
+    GLState::setViewport(0, 0, size, size);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    GLState::setEnabled(GL_SCISSOR_TEST, true);
+}
+
+void ShadowAtlas::beginTile(int tile) const {
+    const glm::ivec4& rect = tiles[tile].rect;
+    GLState::setViewport(rect.x, rect.y, rect.z, rect.w);
+    GLState::setScissor(rect.x, rect.y, rect.z, rect.w);
+}
+
+void ShadowAtlas::end() const {
+    GLState::setEnabled(GL_SCISSOR_TEST, false);
+}
+
+float ShadowAtlas::getUsage() const {
+    float used = 0.0f;
+    for (const Tile& tile : tiles) {
+        used += static_cast<float>(tile.rect.z) * tile.rect.w;
+    }
+    return used / (static_cast<float>(size) * size);
+}
+
+void ShadowAtlas::resetAllocator() {
+    for (auto& blocks : freeBlocks) {
+        blocks.clear();
+    }
+    freeBlocks[0].push_back(glm::ivec2(0, 0));
+}
+
+glm::ivec2 ShadowAtlas::allocate(int tileSize) {
+    int level = 0;
+    while ((size >> level) > tileSize) {
+        ++level;
+    }
+    if (level >= static_cast<int>(freeBlocks.size()) || (size >> level) != tileSize) {
+        return glm::ivec2(-1);
+    }
+
+    // Plus petit bloc libre assez grand, découpé en quatre jusqu'à la taille voulue
+    int source = level;
+    while (source >= 0 && freeBlocks[source].empty()) {
+        --source;
+    }
+    if (source < 0) {
+        return glm::ivec2(-1);
+    }
+
+    glm::ivec2 block = freeBlocks[source].back();
+    freeBlocks[source].pop_back();
+    for (int l = source + 1; l <= level; ++l) {
+        int half = size >> l;
+        // Les trois quarts non utilisés restent libres à ce niveau
+        freeBlocks[l].push_back(block + glm::ivec2(half, half));
+        freeBlocks[l].push_back(block + glm::ivec2(0, half));
+        freeBlocks[l].push_back(block + glm::ivec2(half, 0));
+    }
+    return block;
+}
@@ -1,11 +1,15 @@
 #include "Skybox.h"
+#include "Trace.hpp"
+#include "GLState.hpp"
+#include "ResourceManager.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
-#include <stb/stb_image.h>
 
 Skybox::Skybox(const std::vector<std::string>& faces)
-    : skyboxVAO(0), skyboxVBO(0), cubemapTexture(0), loaded(false) {
+    : skyboxVAO(0), skyboxVBO(0), cubemapTexture(0), loaded(false),
+      uploadBuffer(0), uploadTexture(0), uploadFence(nullptr), reloadPending(false), cubemapBytes(0), uploadBytes(0) {
 
     // Créer le shader
     shader = new Shader("assets/shaders/skybox.vert", "assets/shaders/skybox.frag");
@@ -13,8 +17,12 @@ Skybox::Skybox(const std::vector<std::string>& faces)
     // Setup du mesh (cube)
     setupMesh();
 
-    // Charger les textures
-    loaded = loadCubemap(faces);
+    // Placeholder affiché dès la première frame, remplacé quand les faces sont prêtes
+    cubemapTexture = createPlaceholderTexture();
+    cubemapBytes = 6 * 4;
+    ResourceManager::trackMemory(ResourceCategory::TEXTURE, static_cast<std::int64_t>(cubemapBytes));
+    loaded = true;
+    loadCubemap(faces);
 
     // Configurer le shader
     shader->use();
@@ -22,6 +30,17 @@ Skybox::Skybox(const std::vector<std::string>& faces)
 }
 
 Skybox::~Skybox() {
+    discardPendingFaces();
+    if (uploadFence) {
+        glDeleteSync(uploadFence);
+        glDeleteBuffers(1, &uploadBuffer);
+        GLState::forgetTexture(uploadTexture);
+        glDeleteTextures(1, &uploadTexture);
+        ResourceManager::trackMemory(ResourceCategory::TEXTURE, -static_cast<std::int64_t>(uploadBytes));
+    }
+    ResourceManager::trackMemory(ResourceCategory::TEXTURE, -static_cast<std::int64_t>(cubemapBytes));
+    GLState::forgetVertexArray(skyboxVAO);
+    GLState::forgetTexture(cubemapTexture);
     glDeleteVertexArrays(1, &skyboxVAO);
     glDeleteBuffers(1, &skyboxVBO);
     glDeleteTextures(1, &cubemapTexture);
@@ -78,14 +97,14 @@ void Skybox::setupMesh() {
     glGenVertexArrays(1, &skyboxVAO);
     glGenBuffers(1, &skyboxVBO);
 
-    glBindVertexArray(skyboxVAO);
+    GLState::bindVertexArray(skyboxVAO);
     glBindBuffer(GL_ARRAY_BUFFER, skyboxVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(skyboxVertices), &skyboxVertices, GL_STATIC_DRAW);
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
 
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 }
 
 bool Skybox::loadCubemap(const std::vector<std::string>& faces) {
@@ -94,48 +113,189 @@ bool Skybox::loadCubemap(const std::vector<std::string>& faces) {
         return false;
     }
 
-    if (cubemapTexture != 0) {
-        glDeleteTextures(1, &cubemapTexture);
-    }
-
-    cubemapTexture = loadCubemapTexture(faces);
-    return (cubemapTexture != 0);
+    this->faces = faces;
+    reloadAsync();
+    return true;
 }
 
-unsigned int Skybox::loadCubemapTexture(const std::vector<std::string>& faces) {
+unsigned int Skybox::createPlaceholderTexture() {
+    // Cubemap 1x1 d'un bleu de ciel neutre
+    const unsigned char skyColor[4] = { 150, 170, 200, 255 };
+
     unsigned int textureID;
     glGenTextures(1, &textureID);
+    GLState::bindTexture(0, GL_TEXTURE_CUBE_MAP, textureID);
+    for (unsigned int i = 0; i < 6; i++) {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, skyColor);
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    return textureID;
+}
+
+TextureCache::Image Skybox::decodeFace(const std::string& path) {
+    TRACE_SCOPE("Skybox::decodeFace");
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    // BC1 + mips depuis le cache (transcodage au premier chargement), image invalide si échec
+    TextureCache::Image face;
+    TextureCache::load(path, face);
+    return face;
+}
 
-    int width, height, nrChannels;
-    for (unsigned int i = 0; i < faces.size(); i++)
-    {
+void Skybox::reloadAsync() {
+    if (faces.size() != 6) return;
 
-        unsigned char *data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, STBI_rgb_alpha);
+    // Un chargement à la fois : les fichiers ont pu changer après la lecture des faces en cours,
+    // le rechargement est relancé par pollAsyncLoad une fois celui-ci terminé
+    if (isLoading()) {
+        reloadPending = true;
+        return;
+    }
+    reloadPending = false;
+
+    // Une tâche par face : les six images sont chargées (ou transcodées) en parallèle
+    for (const std::string& path : faces) {
+        pendingFaces.push_back(std::async(std::launch::async, [path] {
+            TRACE_THREAD_NAME("skybox_decode");
+            return decodeFace(path);
+        }));
+    }
+}
 
-        std::cout << nrChannels << std::endl;
+void Skybox::discardPendingFaces() {
+    for (std::future<TextureCache::Image>& pending : pendingFaces) {
+        pending.wait();
+    }
+    pendingFaces.clear();
+}
 
-        if (data)
-        {
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-                         0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+void Skybox::pollAsyncLoad() {
+    // Modification arrivée pendant le chargement précédent, maintenant terminé
+    if (reloadPending && !isLoading()) {
+        reloadAsync();
+        return;
+    }
 
-            stbi_image_free(data);
+    // Transfert terminé : la nouvelle texture remplace l'ancienne
+    if (uploadFence) {
+        GLenum status = glClientWaitSync(uploadFence, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+            finishUpload();
         }
-        else
-        {
-            std::cout << "Cubemap tex failed to load at path: " << faces[i] << std::endl;
+        return;
+    }
+
+    if (pendingFaces.empty()) return;
+    for (std::future<TextureCache::Image>& pending : pendingFaces) {
+        if (pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
         }
     }
 
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    TRACE_SCOPE("Skybox::pollAsyncLoad");
+    std::vector<TextureCache::Image> decoded;
+    decoded.reserve(pendingFaces.size());
+    for (std::future<TextureCache::Image>& pending : pendingFaces) {
+        decoded.push_back(pending.get());
+    }
+    pendingFaces.clear();
+
+    for (const TextureCache::Image& face : decoded) {
+        if (!face.isValid() || face.internalFormat != decoded[0].internalFormat ||
+            face.getWidth() != decoded[0].getWidth() || face.getHeight() != decoded[0].getHeight() ||
+            face.getWidth() != face.getHeight()) {
+            // Image invalide (écriture en cours ?) : garder la cubemap actuelle
+            std::cerr << "Skybox load failed, keeping the current cubemap" << std::endl;
+            return;
+        }
+    }
+    beginUpload(decoded);
+}
+
+void Skybox::beginUpload(const std::vector<TextureCache::Image>& decoded) {
+    TRACE_SCOPE("Skybox::beginUpload");
+
+    // Les faces (toutes leurs mips) sont copiées dans un PBO : les glCompressedTexImage2D lisent
+    // depuis le buffer et le driver peut faire le transfert sans bloquer ; la texture n'est
+    // utilisée qu'après le fence
+    std::vector<size_t> faceOffsets;
+    size_t totalBytes = 0;
+    for (const TextureCache::Image& face : decoded) {
+        faceOffsets.push_back(totalBytes);
+        totalBytes += face.getDataSize();
+    }
+
+    glGenBuffers(1, &uploadBuffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadBuffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, totalBytes, NULL, GL_STREAM_DRAW);
+    unsigned char* mapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, totalBytes,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (mapped) {
+        for (size_t i = 0; i < decoded.size(); i++) {
+            std::memcpy(mapped + faceOffsets[i], decoded[i].getData(), decoded[i].getDataSize());
+        }
+    }
+    if (!mapped || glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) != GL_TRUE) {
+        std::cerr << "Skybox upload failed, keeping the current cubemap" << std::endl;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &uploadBuffer);
+        uploadBuffer = 0;
+        return;
+    }
+
+    glGenTextures(1, &uploadTexture);
+    GLState::bindTexture(0, GL_TEXTURE_CUBE_MAP, uploadTexture);
+    for (unsigned int i = 0; i < decoded.size(); i++) {
+        // Avec un PBO lié, le pointeur est un offset dans le buffer
+        const unsigned char* faceData = reinterpret_cast<const unsigned char*>(faceOffsets[i]);
+        TextureCache::upload(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, decoded[i], faceData);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-    return textureID;
+    uploadBytes = totalBytes;
+    ResourceManager::trackMemory(ResourceCategory::TEXTURE, static_cast<std::int64_t>(uploadBytes));
+
+    uploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+}
+
+void Skybox::finishUpload() {
+    glDeleteSync(uploadFence);
+    uploadFence = nullptr;
+    glDeleteBuffers(1, &uploadBuffer);
+    uploadBuffer = 0;
+
+    // Échange entre deux frames
+    GLState::forgetTexture(cubemapTexture);
+    glDeleteTextures(1, &cubemapTexture);
+    ResourceManager::trackMemory(ResourceCategory::TEXTURE, -static_cast<std::int64_t>(cubemapBytes));
+    cubemapTexture = uploadTexture;
+    cubemapBytes = uploadBytes;
+    uploadTexture = 0;
+    uploadBytes = 0;
+    loaded = true;
+}
+
+void Skybox::finishLoading() {
+    TRACE_SCOPE("Skybox::finishLoading");
+
+    for (std::future<TextureCache::Image>& pending : pendingFaces) {
+        pending.wait();
+    }
+    pollAsyncLoad();
+    if (uploadFence) {
+        glClientWaitSync(uploadFence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        finishUpload();
+    }
 }
 
 void Skybox::render(const glm::mat4& view, const glm::mat4& projection) {
@@ -144,7 +304,8 @@ void Skybox::render(const glm::mat4& view, const glm::mat4& projection) {
         return;
     }
 
-    glDepthFunc(GL_LEQUAL);
+    // GL_LEQUAL est la fonction de profondeur de toute la frame : pas de bascule ici
+    GLState::setDepthFunc(GL_LEQUAL);
 
     shader->use();
 
@@ -155,11 +316,7 @@ void Skybox::render(const glm::mat4& view, const glm::mat4& projection) {
     shader->setUniform("projection", projection);
 
     // Render skybox cube
-    glBindVertexArray(skyboxVAO);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture);
+    GLState::bindVertexArray(skyboxVAO);
+    GLState::bindTexture(0, GL_TEXTURE_CUBE_MAP, cubemapTexture);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glDepthMask(GL_TRUE);
-    glBindVertexArray(0);
-
-    glDepthFunc(GL_LESS);
 }
\ No newline at end of file
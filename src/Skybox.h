@@ -1,10 +1,13 @@
 #ifndef SKYBOX_HPP
 #define SKYBOX_HPP
 
+#include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <future>
 #include <vector>
 #include <string>
 #include "Shader.hpp"
+#include "TextureCache.hpp"
 
 class Skybox {
 public:
@@ -17,17 +20,51 @@ public:
     unsigned int getTextureID() const { return cubemapTexture; }
     bool isLoaded() const { return loaded; }
 
+    // Lance le chargement asynchrone des six faces ; la cubemap courante (ou le placeholder)
+    // reste affichée jusqu'à ce que la nouvelle soit décodée et transférée
     bool loadCubemap(const std::vector<std::string>& faces);
 
+    // Rechargement à chaud : même chemin asynchrone que le chargement initial. Pendant un
+    // chargement, la demande est mémorisée et relancée quand il se termine
+    void reloadAsync();
+
+    // Fait avancer le chargement en cours (à appeler à chaque frame, entre deux frames) :
+    // upload via PBO quand les faces sont décodées, échange de texture quand le transfert est fini
+    void pollAsyncLoad();
+
+    // Bloque jusqu'à ce que la cubemap demandée soit en place (mode headless / benchmark)
+    void finishLoading();
+    bool isLoading() const { return !pendingFaces.empty() || uploadFence != nullptr; }
+
+    Shader* getShader() const { return shader; }
+    const std::vector<std::string>& getFaces() const { return faces; }
+
 private:
     unsigned int skyboxVAO, skyboxVBO;
     unsigned int cubemapTexture;
     Shader* shader;
     bool loaded;
+    std::vector<std::string> faces;
+
+    // Chargement en cours : une tâche par face (cache de textures compressées ou décodage),
+    // puis un upload PBO suivi d'un fence
+    std::vector<std::future<TextureCache::Image>> pendingFaces;
+    unsigned int uploadBuffer;
+    unsigned int uploadTexture;
+    GLsync uploadFence;
+    bool reloadPending;     // Modification arrivée pendant le chargement en cours
+
+    // Taille des cubemaps (affichée et en cours de transfert), comptée par ResourceManager
+    size_t cubemapBytes;
+    size_t uploadBytes;
 
     void setupMesh();
-    
-    unsigned int loadCubemapTexture(const std::vector<std::string>& faces);
+
+    static unsigned int createPlaceholderTexture();
+    static TextureCache::Image decodeFace(const std::string& path);
+    void beginUpload(const std::vector<TextureCache::Image>& decoded);
+    void finishUpload();
+    void discardPendingFaces();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "StressScene.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+    // Emprise des objets : couronne autour de la scène d'origine, densité constante, bornée
+    // par le plateau plat du terrain (Terrain : FLAT_RADIUS = 150)
+    constexpr float INNER_RADIUS = 8.0f;
+    constexpr float MAX_OUTER_RADIUS = 140.0f;
+    constexpr float AREA_PER_OBJECT = 20.0f;    // m² par objet
+
+    // Lumières ponctuelles et spots près du centre, là où la caméra démarre
+    constexpr float LIGHT_RADIUS = 25.0f;
+
+    // PCG32 : suite identique sur toutes les plateformes pour une graine donnée
+    class Random {
+    public:
+        explicit Random(std::uint64_t seed) : state(0) {
+            next();
+            state += seed;
+            next();
+        }
+
+        std::uint32_t next() {
+            std::uint64_t previous = state;
+            state = previous * 6364136223846793005ULL + 1442695040888963407ULL;
+            std::uint32_t xorShifted = static_cast<std::uint32_t>(((previous >> 18u) ^ previous) >> 27u);
+            std::uint32_t rotation = static_cast<std::uint32_t>(previous >> 59u);
+            return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+        }
+
+        // [0, 1)
+        float uniform() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+        float uniform(float low, float high) { return low + (high - low) * uniform(); }
+        int index(int count) { return static_cast<int>(next() % static_cast<std::uint32_t>(count)); }
+
+    private:
+        std::uint64_t state;
+    };
+
+    // Couleur saturée de teinte aléatoire
+    glm::vec3 randomColor(Random& random, float saturation) {
+        float hue = random.uniform() * 6.0f;
+        glm::vec3 rgb = glm::clamp(glm::vec3(std::fabs(hue - 3.0f) - 1.0f,
+                                             2.0f - std::fabs(hue - 2.0f),
+                                             2.0f - std::fabs(hue - 4.0f)), 0.0f, 1.0f);
+        return glm::mix(glm::vec3(1.0f), rgb, saturation);
+    }
+
+    // Point uniforme dans la couronne [inner, outer] du plan XZ
+    glm::vec2 randomInRing(Random& random, float inner, float outer) {
+        float radius = std::sqrt(random.uniform(inner * inner, outer * outer));
+        float angle = random.uniform(0.0f, 6.28318530718f);
+        return glm::vec2(std::cos(angle), std::sin(angle)) * radius;
+    }
+
+    Material randomMaterial(Random& random) {
+        glm::vec3 color = randomColor(random, 0.7f);
+        switch (random.index(4)) {
+            case 0: return Material::createPlastic(color);
+            case 1: return Material::createMetal(color);
+            case 2: return Material::createRubber(color);
+            default: return Material::createWood(color);
+        }
+    }
+}
+
+LightManager::LightCounts generateStressScene(const StressSceneSettings& settings,
+                                              const std::vector<StressScenePrimitive>& primitives,
+                                              std::vector<SceneObject>& objects, LightManager& lights) {
+    Random random(settings.seed);
+
+    // Objets
+    objects.clear();
+    if (!primitives.empty() && settings.objectCount > 0) {
+        objects.reserve(settings.objectCount);
+        float outerRadius = std::sqrt(INNER_RADIUS * INNER_RADIUS +
+                                      settings.objectCount * AREA_PER_OBJECT / 3.14159265359f);
+        outerRadius = std::min(outerRadius, MAX_OUTER_RADIUS);
+
+        for (int i = 0; i < settings.objectCount; ++i) {
+            const StressScenePrimitive& primitive = primitives[random.index(static_cast<int>(primitives.size()))];
+            Material material = randomMaterial(random);
+            glm::vec2 ground = randomInRing(random, INNER_RADIUS, outerRadius);
+            glm::vec3 scale(random.uniform(0.4f, 1.2f));
+            scale.y *= random.uniform(0.7f, 2.0f);
+
+            glm::vec3 axis(0.0f, 1.0f, 0.0f);
+            float speed = 0.0f;
+            if (settings.animate && i % 2 == 0) {
+                axis = glm::normalize(glm::vec3(random.uniform(-1.0f, 1.0f), 1.0f, random.uniform(-1.0f, 1.0f)));
+                speed = random.uniform(0.2f, 1.5f) * (random.index(2) == 0 ? 1.0f : -1.0f);
+            }
+
+            objects.emplace_back(primitive.geometry, material,
+                                 glm::vec3(ground.x, primitive.halfHeight * scale.y, ground.y),
+                                 scale, axis, speed);
+        }
+    }
+
+    // Lumières : un type après l'autre jusqu'à MAX_LIGHTS
+    lights.clear();
+    LightManager::LightCounts counts;
+    int remaining[3] = { std::max(settings.directionalLights, 0), std::max(settings.pointLights, 0),
+                         std::max(settings.spotLights, 0) };
+    int total = 0;
+    while (total < LightManager::MAX_LIGHTS && (remaining[0] > 0 || remaining[1] > 0 || remaining[2] > 0)) {
+        if (remaining[0] > 0 && total < LightManager::MAX_LIGHTS) {
+            // La première est le soleil (ombre des cascades), les suivantes un appoint plus faible
+            glm::vec3 direction = counts.directional == 0
+                    ? glm::vec3(-0.3f, -1.0f, -0.2f)
+                    : glm::vec3(random.uniform(-1.0f, 1.0f), -random.uniform(0.3f, 1.0f), random.uniform(-1.0f, 1.0f));
+            glm::vec3 color = counts.directional == 0 ? glm::vec3(1.0f, 0.95f, 0.8f) : randomColor(random, 0.3f);
+            float intensity = counts.directional == 0 ? 0.8f : 0.3f;
+            lights.addDirectionalLight(DirectionalLight(direction, color, intensity,
+                                                        -glm::normalize(direction) * 10.0f));
+            ++counts.directional;
+            --remaining[0];
+            ++total;
+        }
+        if (remaining[1] > 0 && total < LightManager::MAX_LIGHTS) {
+            glm::vec2 ground = randomInRing(random, 0.0f, LIGHT_RADIUS);
+            lights.addPointLight(PointLight(glm::vec3(ground.x, random.uniform(2.0f, 5.0f), ground.y),
+                                            randomColor(random, 0.5f), 1.5f));
+            ++counts.point;
+            --remaining[1];
+            ++total;
+        }
+        if (remaining[2] > 0 && total < LightManager::MAX_LIGHTS) {
+            glm::vec2 ground = randomInRing(random, 0.0f, LIGHT_RADIUS);
+            glm::vec3 direction(random.uniform(-0.5f, 0.5f), -1.0f, random.uniform(-0.5f, 0.5f));
+            lights.addSpotLight(SpotLight(glm::vec3(ground.x, random.uniform(5.0f, 8.0f), ground.y), direction,
+                                          15.0f, 25.0f, randomColor(random, 0.5f), 2.0f));
+            ++counts.spot;
+            --remaining[2];
+            ++total;
+        }
+    }
+
+    if (remaining[0] > 0 || remaining[1] > 0 || remaining[2] > 0) {
+        std::cerr << "Stress scene: light count limited to " << LightManager::MAX_LIGHTS << " ("
+                  << counts.directional << " directional, " << counts.point << " point, "
+                  << counts.spot << " spot)" << std::endl;
+    }
+
+    return counts;
+}
@@ -0,0 +1,401 @@
+#include "Terrain.hpp"
+#include "Geometry.hpp"
+#include "JobSystem.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int GRID_VERTICES = Terrain::CHUNK_QUADS + 1;
+    constexpr int SKIRT_VERTICES = 4 * GRID_VERTICES;
+    constexpr int VERTEX_COUNT = GRID_VERTICES * GRID_VERTICES + SKIRT_VERTICES;
+    constexpr int INDEX_COUNT = Terrain::CHUNK_QUADS * Terrain::CHUNK_QUADS * 6 + 4 * Terrain::CHUNK_QUADS * 6;
+
+    // Champ de hauteur : plat autour de la scène, collines au-delà
+    constexpr float FLAT_RADIUS = 150.0f;
+    constexpr float RAMP_WIDTH = 400.0f;
+    constexpr float HEIGHT_SCALE = 160.0f;
+    constexpr float FEATURE_SIZE = 700.0f;      // Longueur d'onde de la première octave (m)
+    constexpr int OCTAVES = 6;
+
+    // Chunks ni dessinés ni ancêtres d'un chunk dessiné depuis ce nombre de frames : libérés
+    constexpr std::uint64_t EVICTION_FRAMES = 120;
+
+    float hashLattice(int x, int z) {
+        std::uint32_t h = static_cast<std::uint32_t>(x) * 374761393u + static_cast<std::uint32_t>(z) * 668265263u;
+        h = (h ^ (h >> 13)) * 1274126177u;
+        h ^= h >> 16;
+        return static_cast<float>(h & 0xffffffu) / static_cast<float>(0xffffffu);
+    }
+
+    float valueNoise(float x, float z) {
+        float fx = std::floor(x);
+        float fz = std::floor(z);
+        int xi = static_cast<int>(fx);
+        int zi = static_cast<int>(fz);
+        float tx = x - fx;
+        float tz = z - fz;
+        // Interpolation quintique : dérivée continue, pas de facettes aux mailles du réseau
+        tx = tx * tx * tx * (tx * (tx * 6.0f - 15.0f) + 10.0f);
+        tz = tz * tz * tz * (tz * (tz * 6.0f - 15.0f) + 10.0f);
+        float a = hashLattice(xi, zi);
+        float b = hashLattice(xi + 1, zi);
+        float c = hashLattice(xi, zi + 1);
+        float d = hashLattice(xi + 1, zi + 1);
+        return glm::mix(glm::mix(a, b, tx), glm::mix(c, d, tx), tz);
+    }
+
+    float sampleHeight(float x, float z) {
+        float distance = std::sqrt(x * x + z * z);
+        if (distance <= FLAT_RADIUS) return 0.0f;
+
+        float sum = 0.0f;
+        float amplitude = 0.5f;
+        float frequency = 1.0f / FEATURE_SIZE;
+        for (int octave = 0; octave < OCTAVES; ++octave) {
+            sum += amplitude * valueNoise(x * frequency, z * frequency);
+            amplitude *= 0.5f;
+            frequency *= 2.0f;
+        }
+        float ramp = glm::smoothstep(FLAT_RADIUS, FLAT_RADIUS + RAMP_WIDTH, distance);
+        return HEIGHT_SCALE * ramp * sum * sum;
+    }
+
+    // Topologie commune à tous les chunks : grille puis jupes (une par côté, parcourue de
+    // façon à ce que les faces soient tournées vers l'extérieur)
+    std::vector<unsigned int> buildIndices() {
+        const int n = Terrain::CHUNK_QUADS;
+        auto gridIndex = [](int i, int j) { return static_cast<unsigned int>(j * GRID_VERTICES + i); };
+
+        std::vector<unsigned int> indices;
+        indices.reserve(INDEX_COUNT);
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                unsigned int a = gridIndex(i, j);
+                unsigned int b = gridIndex(i, j + 1);
+                unsigned int c = gridIndex(i + 1, j);
+                unsigned int d = gridIndex(i + 1, j + 1);
+                indices.insert(indices.end(), {a, b, c, c, b, d});
+            }
+        }
+
+        for (int side = 0; side < 4; ++side) {
+            for (int k = 0; k < n; ++k) {
+                unsigned int top0, top1;
+                switch (side) {
+                    case 0:  top0 = gridIndex(k, 0);         top1 = gridIndex(k + 1, 0);         break;   // z min, vers +x
+                    case 1:  top0 = gridIndex(n, k);         top1 = gridIndex(n, k + 1);         break;   // x max, vers +z
+                    case 2:  top0 = gridIndex(n - k, n);     top1 = gridIndex(n - k - 1, n);     break;   // z max, vers -x
+                    default: top0 = gridIndex(0, n - k);     top1 = gridIndex(0, n - k - 1);     break;   // x min, vers -z
+                }
+                unsigned int skirt0 = static_cast<unsigned int>(GRID_VERTICES * GRID_VERTICES + side * GRID_VERTICES + k);
+                unsigned int skirt1 = skirt0 + 1;
+                indices.insert(indices.end(), {top0, top1, skirt0, top1, skirt1, skirt0});
+            }
+        }
+        return indices;
+    }
+
+    void decodeKey(std::uint64_t key, int& level, int& x, int& z) {
+        level = static_cast<int>(key >> 48);
+        x = static_cast<int>((key >> 24) & 0xffffffu);
+        z = static_cast<int>(key & 0xffffffu);
+    }
+}
+
+// Chunk généré sur un thread, en attente de transfert
+struct Terrain::Chunk {
+    std::uint64_t key = 0;
+    std::uint32_t request = 0;
+    std::vector<Vertex> vertices;
+    float minY = 0.0f;
+    float maxY = 0.0f;
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+    double generationMs = 0.0;
+};
+
+Terrain::Terrain(float size, float leafSize)
+        : size(size), maxLevel(0), material(Material::createRubber(glm::vec3(0.4f, 0.4f, 0.4f))), indexBuffer(0),
+          frame(0), readyChunks(std::make_shared<std::vector<Chunk>>()) {
+    while (maxLevel < 16 && getNodeSize(maxLevel + 1) >= leafSize) {
+        ++maxLevel;
+    }
+
+    std::vector<unsigned int> indices = buildIndices();
+    glGenBuffers(1, &indexBuffer);
+    // Rempli par GL_ARRAY_BUFFER : la cible GL_ELEMENT_ARRAY_BUFFER est un état du VAO lié
+    glBindBuffer(GL_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    std::size_t indexBytes = indices.size() * sizeof(unsigned int);
+    ResourceManager::trackMemory(ResourceCategory::GEOMETRY, static_cast<std::int64_t>(indexBytes));
+    stats.residentBytes = indexBytes;
+
+    // Racine générée tout de suite : il y a toujours un chunk à dessiner
+    Chunk root;
+    root.key = makeKey(0, 0, 0);
+    root.request = ++nodes[root.key].request;
+    nodes[root.key].state = NodeState::GENERATING;
+    ++stats.chunksGenerating;
+    generateChunk(size, root);
+    uploadChunk(root);
+}
+
+Terrain::~Terrain() {
+    for (auto& [key, node] : nodes) {
+        releaseNode(node);
+    }
+    if (indexBuffer != 0) {
+        glDeleteBuffers(1, &indexBuffer);
+        ResourceManager::trackMemory(ResourceCategory::GEOMETRY, -static_cast<std::int64_t>(INDEX_COUNT * sizeof(unsigned int)));
+    }
+}
+
+float Terrain::getHeight(float x, float z) const {
+    return sampleHeight(x, z);
+}
+
+std::uint64_t Terrain::makeKey(int level, int x, int z) {
+    return (static_cast<std::uint64_t>(level) << 48) | (static_cast<std::uint64_t>(x) << 24) | static_cast<std::uint64_t>(z);
+}
+
+void Terrain::generateChunk(float terrainSize, Chunk& chunk) {
+    TRACE_SCOPE("Terrain::generateChunk");
+    Clock::time_point start = Clock::now();
+
+    int level, nodeX, nodeZ;
+    decodeKey(chunk.key, level, nodeX, nodeZ);
+    const int n = CHUNK_QUADS;
+    float nodeSize = terrainSize / static_cast<float>(1 << level);
+    float spacing = nodeSize / static_cast<float>(n);
+    float originX = -terrainSize * 0.5f + nodeX * nodeSize;
+    float originZ = -terrainSize * 0.5f + nodeZ * nodeSize;
+
+    // Hauteurs avec une bordure d'un sommet pour les normales (différences centrées)
+    const int padded = GRID_VERTICES + 2;
+    std::vector<float> heights(padded * padded);
+    for (int j = 0; j < padded; ++j) {
+        for (int i = 0; i < padded; ++i) {
+            heights[j * padded + i] = sampleHeight(originX + (i - 1) * spacing, originZ + (j - 1) * spacing);
+        }
+    }
+    auto height = [&](int i, int j) { return heights[(j + 1) * padded + (i + 1)]; };
+
+    chunk.vertices.resize(VERTEX_COUNT);
+    chunk.minY = height(0, 0);
+    chunk.maxY = chunk.minY;
+    for (int j = 0; j < GRID_VERTICES; ++j) {
+        for (int i = 0; i < GRID_VERTICES; ++i) {
+            float x = originX + i * spacing;
+            float z = originZ + j * spacing;
+            float y = height(i, j);
+            glm::vec3 normal = glm::normalize(glm::vec3(height(i - 1, j) - height(i + 1, j), 2.0f * spacing,
+                                                        height(i, j - 1) - height(i, j + 1)));
+            chunk.vertices[j * GRID_VERTICES + i] = {x, y, z, normal.x, normal.y, normal.z, x / 16.0f, z / 16.0f};
+            chunk.minY = std::min(chunk.minY, y);
+            chunk.maxY = std::max(chunk.maxY, y);
+        }
+    }
+
+    // Jupes : copies des sommets de bord abaissées, plus profondes que l'écart possible
+    // avec un voisin d'un niveau plus grossier
+    float skirtDepth = 2.0f * spacing + 1.0f;
+    for (int side = 0; side < 4; ++side) {
+        for (int k = 0; k < GRID_VERTICES; ++k) {
+            int i, j;
+            switch (side) {
+                case 0:  i = k;     j = 0;     break;
+                case 1:  i = n;     j = k;     break;
+                case 2:  i = n - k; j = n;     break;
+                default: i = 0;     j = n - k; break;
+            }
+            Vertex skirt = chunk.vertices[j * GRID_VERTICES + i];
+            skirt.y -= skirtDepth;
+            chunk.vertices[GRID_VERTICES * GRID_VERTICES + side * GRID_VERTICES + k] = skirt;
+        }
+    }
+
+    // Sphère englobante de la grille (les jupes, sous le sol, n'en font pas partie)
+    chunk.center = glm::vec3(originX + nodeSize * 0.5f, (chunk.minY + chunk.maxY) * 0.5f, originZ + nodeSize * 0.5f);
+    chunk.radius = glm::length(glm::vec3(nodeSize * 0.5f, (chunk.maxY - chunk.minY) * 0.5f, nodeSize * 0.5f));
+    chunk.generationMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+float Terrain::getDistance(int level, int x, int z, const Node& node, const glm::vec3& position) const {
+    float nodeSize = getNodeSize(level);
+    glm::vec3 minimum(-size * 0.5f + x * nodeSize, 0.0f, -size * 0.5f + z * nodeSize);
+    glm::vec3 maximum = minimum + glm::vec3(nodeSize, 0.0f, nodeSize);
+    // Hauteurs inconnues avant génération : distance horizontale seulement
+    if (node.state == NodeState::RESIDENT) {
+        minimum.y = node.minY;
+        maximum.y = node.maxY;
+    } else {
+        minimum.y = maximum.y = position.y;
+    }
+    return glm::length(position - glm::clamp(position, minimum, maximum));
+}
+
+void Terrain::selectNode(int level, int x, int z, const glm::vec3& position) {
+    Node& node = nodes[makeKey(level, x, z)];
+    node.lastUsedFrame = frame;
+
+    if (level < maxLevel && getDistance(level, x, z, node, position) < getNodeSize(level) * settings.lodDistance) {
+        // Subdivision seulement quand les quatre enfants peuvent être dessinés
+        bool childrenResident = true;
+        for (int child = 0; child < 4; ++child) {
+            int childX = x * 2 + (child & 1);
+            int childZ = z * 2 + (child >> 1);
+            std::uint64_t childKey = makeKey(level + 1, childX, childZ);
+            Node& childNode = nodes[childKey];
+            childNode.lastUsedFrame = frame;
+            if (childNode.state == NodeState::EMPTY) {
+                requests.push_back({getDistance(level + 1, childX, childZ, childNode, position), childKey});
+            }
+            childrenResident = childrenResident && childNode.state == NodeState::RESIDENT;
+        }
+        if (childrenResident) {
+            for (int child = 0; child < 4; ++child) {
+                selectNode(level + 1, x * 2 + (child & 1), z * 2 + (child >> 1), position);
+            }
+            return;
+        }
+    }
+
+    objects.emplace_back(node.geometry, material);
+    ++stats.chunksSelected;
+    stats.trianglesSelected += INDEX_COUNT / 3;
+    stats.deepestLevel = std::max(stats.deepestLevel, level);
+}
+
+void Terrain::requestNode(std::uint64_t key) {
+    Node& node = nodes[key];
+    node.state = NodeState::GENERATING;
+    std::uint32_t request = ++node.request;
+    ++stats.chunksGenerating;
+
+    float terrainSize = size;
+    std::weak_ptr<std::vector<Chunk>> ready = readyChunks;
+    JobSystem::submit([terrainSize, ready, key, request] {
+        std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+        chunk->key = key;
+        chunk->request = request;
+        generateChunk(terrainSize, *chunk);
+
+        // Remise au thread GL ; ignorée si le terrain a été détruit entre-temps
+        JobSystem::submitToMainThread([ready, chunk] {
+            if (std::shared_ptr<std::vector<Chunk>> readyList = ready.lock()) {
+                readyList->push_back(std::move(*chunk));
+            }
+        });
+    });
+}
+
+void Terrain::uploadChunk(Chunk& chunk) {
+    Node& node = nodes[chunk.key];
+    std::unique_ptr<Geometry> geometry = std::make_unique<Geometry>();
+    geometry->setupMesh(chunk.vertices.data(), chunk.vertices.size(), indexBuffer, INDEX_COUNT, chunk.center,
+                        chunk.radius);
+    node.bytes = geometry->getGpuBytes();
+    node.geometry = ResourceManager::addGeometry(std::move(geometry), "terrain");
+    node.minY = chunk.minY;
+    node.maxY = chunk.maxY;
+    node.state = NodeState::RESIDENT;
+
+    --stats.chunksGenerating;
+    ++stats.chunksResident;
+    ++stats.generated;
+    stats.residentBytes += node.bytes;
+    stats.generationMs += chunk.generationMs;
+    stats.maxGenerationMs = std::max(stats.maxGenerationMs, chunk.generationMs);
+}
+
+void Terrain::releaseNode(Node& node) {
+    if (node.state == NodeState::RESIDENT) {
+        ResourceManager::release(node.geometry);
+        node.geometry = GeometryHandle();
+        --stats.chunksResident;
+        stats.residentBytes -= node.bytes;
+        node.bytes = 0;
+    } else if (node.state == NodeState::GENERATING) {
+        --stats.chunksGenerating;
+    }
+    node.state = NodeState::EMPTY;
+}
+
+void Terrain::update(const glm::vec3& cameraPosition) {
+    TRACE_SCOPE("Terrain::update");
+    ++frame;
+
+    // Chunks remis par les threads : les plus grossiers d'abord, dans le budget de la frame
+    std::vector<Chunk>& ready = *readyChunks;
+    ready.erase(std::remove_if(ready.begin(), ready.end(), [this](const Chunk& chunk) {
+        auto found = nodes.find(chunk.key);
+        return found == nodes.end() || found->second.state != NodeState::GENERATING ||
+               found->second.request != chunk.request;
+    }), ready.end());
+    std::sort(ready.begin(), ready.end(), [](const Chunk& a, const Chunk& b) { return a.key < b.key; });
+    std::size_t uploads = ready.size();
+    if (settings.uploadsPerFrame > 0) {
+        uploads = std::min(uploads, static_cast<std::size_t>(settings.uploadsPerFrame));
+    }
+    for (std::size_t i = 0; i < uploads; ++i) {
+        uploadChunk(ready[i]);
+    }
+    ready.erase(ready.begin(), ready.begin() + static_cast<std::ptrdiff_t>(uploads));
+
+    // Sélection des nœuds dessinés et des enfants manquants
+    Clock::time_point selectStart = Clock::now();
+    objects.clear();
+    requests.clear();
+    stats.chunksSelected = 0;
+    stats.trianglesSelected = 0;
+    stats.deepestLevel = 0;
+    selectNode(0, 0, 0, cameraPosition);
+    stats.selectMs = std::chrono::duration<double, std::milli>(Clock::now() - selectStart).count();
+
+    std::sort(requests.begin(), requests.end(), [](const Request& a, const Request& b) {
+        return a.distance < b.distance;
+    });
+    for (const Request& request : requests) {
+        if (stats.chunksGenerating >= settings.maxGenerationsInFlight) break;
+        requestNode(request.key);
+    }
+
+    // Éviction des nœuds qui ne servent plus (la racine reste)
+    std::uint64_t rootKey = makeKey(0, 0, 0);
+    for (auto it = nodes.begin(); it != nodes.end();) {
+        if (it->first != rootKey && it->second.lastUsedFrame + EVICTION_FRAMES < frame) {
+            if (it->second.state == NodeState::RESIDENT) ++stats.evicted;
+            releaseNode(it->second);
+            it = nodes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void Terrain::finishLoading(const glm::vec3& cameraPosition) {
+    TRACE_SCOPE("Terrain::finishLoading");
+
+    int uploadsPerFrame = settings.uploadsPerFrame;
+    settings.uploadsPerFrame = 0;
+    JobSystem::waitOnMainThread([&] {
+        update(cameraPosition);
+        return requests.empty() && stats.chunksGenerating == 0;
+    });
+    settings.uploadsPerFrame = uploadsPerFrame;
+}
+
+void Terrain::printReport() const {
+    std::cout << "Terrain: " << stats.chunksSelected << " chunks drawn (" << stats.trianglesSelected
+              << " triangles, deepest level " << stats.deepestLevel << "/" << maxLevel << "), "
+              << stats.chunksResident << " resident (" << static_cast<double>(stats.residentBytes) / (1024.0 * 1024.0)
+              << " MB), " << stats.generated << " generated in "
+              << (stats.generated > 0 ? stats.generationMs / stats.generated : 0.0) << " ms avg (max "
+              << stats.maxGenerationMs << " ms), " << stats.evicted << " evicted" << std::endl;
+}
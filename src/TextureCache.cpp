@@ -0,0 +1,336 @@
+#include "TextureCache.hpp"
+#include "AssetPack.hpp"
+#include "BlockCompression.hpp"
+#include "CacheFile.hpp"
+#include "Hash.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stb/stb_image.h>
+
+namespace {
+    std::string cacheDirectory = "texture_cache";
+    bool cacheEnabled = true;
+    TextureCache::Stats cacheStats;
+    std::mutex statsMutex;  // Les textures sont chargées par les threads de décodage
+
+    // À incrémenter quand l'encodeur ou le filtre des mips change : invalide tout le cache
+    const std::uint32_t TRANSCODER_VERSION = 1;
+
+    // En-tête d'une entrée du cache
+    struct EntryHeader {
+        char magic[8];
+        std::uint64_t key;
+        std::uint32_t internalFormat;
+        std::uint32_t levelCount;
+    };
+
+    struct EntryLevel {
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    const char ENTRY_MAGIC[8] = {'T', 'E', 'X', 'B', 'C', '1', '0', '1'};
+
+    // Les entrées d'une archive sont construites avec elle : pas de clé de source
+    const std::uint64_t PACK_KEY = 0;
+
+    void recordLoad(bool cacheHit, double milliseconds, std::size_t bytes, bool fromPack = false) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        if (fromPack) ++cacheStats.packHits;
+        if (cacheHit) {
+            ++cacheStats.hits;
+            cacheStats.hitMs += milliseconds;
+        } else {
+            ++cacheStats.misses;
+            cacheStats.missMs += milliseconds;
+        }
+        cacheStats.bytes += bytes;
+    }
+
+    // Clé : chemin, taille et date de la source, version du transcodeur
+    bool computeKey(const std::string& sourcePath, std::uint64_t& key) {
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(sourcePath, error);
+        if (error) return false;
+        auto modified = std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+        if (error) return false;
+
+        key = hashString(sourcePath);
+        key = hashBytes(&size, sizeof(size), key);
+        key = hashBytes(&modified, sizeof(modified), key);
+        key = hashBytes(&TRANSCODER_VERSION, sizeof(TRANSCODER_VERSION), key);
+        return true;
+    }
+
+    // Niveau suivant de la chaîne de mips (filtre boîte 2x2, bords répétés pour les tailles impaires)
+    std::vector<unsigned char> downsample(const std::vector<unsigned char>& source, int width, int height) {
+        int nextWidth = std::max(1, width / 2);
+        int nextHeight = std::max(1, height / 2);
+        std::vector<unsigned char> result(static_cast<std::size_t>(nextWidth) * nextHeight * 4);
+        for (int y = 0; y < nextHeight; ++y) {
+            int y0 = std::min(2 * y, height - 1);
+            int y1 = std::min(2 * y + 1, height - 1);
+            for (int x = 0; x < nextWidth; ++x) {
+                int x0 = std::min(2 * x, width - 1);
+                int x1 = std::min(2 * x + 1, width - 1);
+                for (int c = 0; c < 4; ++c) {
+                    int sum = source[(static_cast<std::size_t>(y0) * width + x0) * 4 + c]
+                            + source[(static_cast<std::size_t>(y0) * width + x1) * 4 + c]
+                            + source[(static_cast<std::size_t>(y1) * width + x0) * 4 + c]
+                            + source[(static_cast<std::size_t>(y1) * width + x1) * 4 + c];
+                    result[(static_cast<std::size_t>(y) * nextWidth + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+        return result;
+    }
+
+    // Valide l'index des niveaux (contigus, dans l'ordre) et le copie dans 'image'
+    bool readLevels(const EntryHeader& header, const EntryLevel* levels, std::uint64_t key,
+                    TextureCache::Image& image, std::size_t& dataSize) {
+        if (std::memcmp(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) != 0 ||
+            header.key != key || header.levelCount == 0 || header.levelCount > 32) {
+            return false;
+        }
+
+        dataSize = 0;
+        image.levels.clear();
+        image.mappedData = nullptr;
+        image.mappedSize = 0;
+        for (std::uint32_t i = 0; i < header.levelCount; ++i) {
+            const EntryLevel& level = levels[i];
+            if (level.offset != dataSize) return false;
+            image.levels.push_back({static_cast<int>(level.width), static_cast<int>(level.height),
+                                    static_cast<std::size_t>(level.offset), static_cast<std::size_t>(level.size)});
+            dataSize += level.size;
+        }
+        image.internalFormat = header.internalFormat;
+        return true;
+    }
+
+    bool readEntry(const std::string& path, std::uint64_t key, TextureCache::Image& image) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+
+        EntryHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.levelCount > 32) {
+            return false;
+        }
+
+        std::vector<EntryLevel> levels(header.levelCount);
+        std::size_t dataSize = 0;
+        if (!file.read(reinterpret_cast<char*>(levels.data()), levels.size() * sizeof(EntryLevel)) ||
+            !readLevels(header, levels.data(), key, image, dataSize)) {
+            return false;
+        }
+        image.data.resize(dataSize);
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(image.data.data()), dataSize));
+    }
+
+    // Entrée "<source>.tex" de l'archive montée : les niveaux pointent dans la projection
+    bool viewPackedEntry(const std::string& sourcePath, TextureCache::Image& image) {
+        const AssetPack* pack = AssetPack::getMounted();
+        if (!pack) return false;
+
+        std::string_view bytes = pack->view(AssetPack::normalizePath(sourcePath) + TextureCache::getPackSuffix());
+        if (bytes.size() < sizeof(EntryHeader)) return false;
+
+        EntryHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.levelCount > 32 || bytes.size() < sizeof(header) + header.levelCount * sizeof(EntryLevel)) {
+            return false;
+        }
+        std::vector<EntryLevel> levels(header.levelCount);
+        std::memcpy(levels.data(), bytes.data() + sizeof(header), levels.size() * sizeof(EntryLevel));
+
+        std::size_t dataSize = 0;
+        std::size_t payload = sizeof(header) + levels.size() * sizeof(EntryLevel);
+        if (!readLevels(header, levels.data(), PACK_KEY, image, dataSize) || bytes.size() - payload != dataSize) {
+            return false;
+        }
+        image.data.clear();
+        image.mappedData = reinterpret_cast<const unsigned char*>(bytes.data()) + payload;
+        image.mappedSize = dataSize;
+        return true;
+    }
+
+    void writeEntryTo(std::ostream& file, std::uint64_t key, const TextureCache::Image& image) {
+        EntryHeader header;
+        std::memcpy(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+        header.key = key;
+        header.internalFormat = image.internalFormat;
+        header.levelCount = static_cast<std::uint32_t>(image.levels.size());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const TextureCache::Level& level : image.levels) {
+            EntryLevel entry = {static_cast<std::uint32_t>(level.width), static_cast<std::uint32_t>(level.height),
+                                level.offset, level.size};
+            file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        }
+        file.write(reinterpret_cast<const char*>(image.getData()), image.getDataSize());
+    }
+
+    void writeEntry(const std::string& path, std::uint64_t key, const TextureCache::Image& image) {
+        // Fichier temporaire puis renommage : jamais d'entrée à moitié écrite
+        writeCacheFile(path, [&](std::ostream& file) { writeEntryTo(file, key, image); });
+    }
+}
+
+void TextureCache::setDirectory(const std::string& directory) {
+    cacheDirectory = directory;
+}
+
+const std::string& TextureCache::getDirectory() {
+    return cacheDirectory;
+}
+
+void TextureCache::setEnabled(bool enabled) {
+    cacheEnabled = enabled;
+}
+
+bool TextureCache::isEnabled() {
+    return cacheEnabled && isCompressionSupported();
+}
+
+bool TextureCache::isCompressionSupported() {
+    return GLEW_EXT_texture_compression_s3tc;
+}
+
+std::string TextureCache::getEntryPath(std::uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.tex", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(cacheDirectory) / name).string();
+}
+
+bool TextureCache::load(const std::string& sourcePath, Image& image) {
+    TRACE_SCOPE("TextureCache::load");
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&start] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // Entrée pré-transcodée de l'archive d'assets : aucun accès disque. Ignorée avec le cache
+    // désactivé (--no-texture-cache), pour mesurer le décodage de la source non compressée
+    if (isEnabled() && viewPackedEntry(sourcePath, image)) {
+        recordLoad(true, elapsedMs(), image.getDataSize(), true);
+        return true;
+    }
+
+    std::uint64_t key = 0;
+    bool cached = isEnabled() && computeKey(sourcePath, key);
+    if (cached) {
+        std::string path = getEntryPath(key);
+        if (readEntry(path, key, image)) {
+            recordLoad(true, elapsedMs(), image.getDataSize());
+            return true;
+        }
+        // Absente ou corrompue : reconstruite ci-dessous
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+
+    if (!transcode(sourcePath, cached, image)) {
+        return false;
+    }
+    if (cached) {
+        writeEntry(getEntryPath(key), key, image);
+    }
+    recordLoad(false, elapsedMs(), image.getDataSize());
+    return true;
+}
+
+bool TextureCache::transcode(const std::string& sourcePath, bool compress, Image& image) {
+    TRACE_SCOPE("TextureCache::transcode");
+
+    // Source dans l'archive montée (décodée depuis la projection) ou sur le disque
+    int width, height, channels;
+    unsigned char* pixels = nullptr;
+    const AssetPack* pack = AssetPack::getMounted();
+    std::string_view packed = pack ? pack->view(AssetPack::normalizePath(sourcePath)) : std::string_view();
+    if (!packed.empty()) {
+        pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(packed.data()), static_cast<int>(packed.size()),
+                                       &width, &height, &channels, STBI_rgb_alpha);
+    } else {
+        pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    }
+    if (!pixels) {
+        std::cerr << "Texture failed to load at path: " << sourcePath << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> level(pixels, pixels + static_cast<std::size_t>(width) * height * 4);
+    stbi_image_free(pixels);
+
+    image.internalFormat = compress ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_RGBA8;
+    image.levels.clear();
+    image.data.clear();
+    image.mappedData = nullptr;
+    image.mappedSize = 0;
+    while (true) {
+        Level info;
+        info.width = width;
+        info.height = height;
+        info.offset = image.data.size();
+        info.size = compress ? BlockCompression::bc1Size(width, height) : level.size();
+        image.data.resize(info.offset + info.size);
+        if (compress) {
+            BlockCompression::compressBC1(level.data(), width, height, image.data.data() + info.offset);
+        } else {
+            std::memcpy(image.data.data() + info.offset, level.data(), info.size);
+        }
+        image.levels.push_back(info);
+
+        if (width == 1 && height == 1) break;
+        level = downsample(level, width, height);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return true;
+}
+
+void TextureCache::serialize(const Image& image, std::string& bytes) {
+    std::ostringstream stream(std::ios::binary);
+    writeEntryTo(stream, PACK_KEY, image);
+    bytes = stream.str();
+}
+
+void TextureCache::upload(GLenum target, const Image& image, const unsigned char* pixels) {
+    for (size_t level = 0; level < image.levels.size(); ++level) {
+        const Level& info = image.levels[level];
+        if (image.isCompressed()) {
+            glCompressedTexImage2D(target, static_cast<GLint>(level), image.internalFormat, info.width, info.height,
+                                   0, static_cast<GLsizei>(info.size), pixels + info.offset);
+        } else {
+            glTexImage2D(target, static_cast<GLint>(level), image.internalFormat, info.width, info.height, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, pixels + info.offset);
+        }
+    }
+}
+
+TextureCache::Stats TextureCache::getStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return cacheStats;
+}
+
+void TextureCache::printReport() {
+    Stats cacheStats = getStats();
+    double megabytes = static_cast<double>(cacheStats.bytes) / (1024.0 * 1024.0);
+    if (!isEnabled()) {
+        std::cout << "Texture cache: disabled (" << cacheStats.misses << " images decoded in "
+                  << cacheStats.missMs << " ms, " << megabytes << " MB RGBA8)" << std::endl;
+        return;
+    }
+
+    const char* state = cacheStats.misses == 0 ? "warm" : (cacheStats.hits == 0 ? "cold" : "partial");
+    std::cout << "Texture cache (" << state << "): " << cacheStats.hits << " loaded in " << cacheStats.hitMs
+              << " ms (" << cacheStats.packHits << " from asset pack), " << cacheStats.misses << " transcoded in " << cacheStats.missMs << " ms, "
+              << megabytes << " MB BC1" << std::endl;
+}
@@ -0,0 +1,130 @@
+#include "Trace.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    struct TraceEvent {
+        const char* name;
+        std::uint64_t startNs;
+        std::uint64_t endNs;
+    };
+
+    // Buffer circulaire d'un thread : un seul écrivain (le thread propriétaire),
+    // la publication se fait par le compteur atomique 'head'
+    struct ThreadBuffer {
+        static const std::size_t CAPACITY = 1 << 16;
+
+        std::unique_ptr<TraceEvent[]> events{new TraceEvent[CAPACITY]};
+        std::atomic<std::uint64_t> head{0};
+        std::atomic<const char*> threadName{nullptr};
+        int threadId = 0;
+    };
+
+    // Registre des buffers ; le verrou n'est pris qu'à la création d'un buffer et au dump
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    };
+
+    Registry& registry() {
+        static Registry* instance = new Registry();  // Jamais détruit : utilisable pendant la sortie
+        return *instance;
+    }
+
+    ThreadBuffer& threadBuffer() {
+        thread_local ThreadBuffer* buffer = [] {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.buffers.push_back(std::make_unique<ThreadBuffer>());
+            reg.buffers.back()->threadId = static_cast<int>(reg.buffers.size());
+            return reg.buffers.back().get();
+        }();
+        return *buffer;
+    }
+
+    const std::chrono::steady_clock::time_point traceEpoch = std::chrono::steady_clock::now();
+
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+std::uint64_t Tracer::now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - traceEpoch).count());
+}
+
+void Tracer::record(const char* name, std::uint64_t startNs, std::uint64_t endNs) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[index % ThreadBuffer::CAPACITY] = {name, startNs, endNs};
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const char* name) {
+    threadBuffer().threadName.store(name, std::memory_order_release);
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) {
+    if (!isEnabled()) {
+        std::cerr << "Tracing is disabled (build with -DENABLE_TRACING=ON)" << std::endl;
+        return false;
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to write trace: " << path << std::endl;
+        return false;
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    std::size_t eventCount = 0;
+
+    for (const auto& buffer : reg.buffers) {
+        if (const char* threadName = buffer->threadName.load(std::memory_order_acquire)) {
+            file << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+                 << buffer->threadId << ", \"args\": {\"name\": ";
+            writeJsonString(file, threadName);
+            file << "}}";
+            first = false;
+        }
+
+        // Les événements les plus anciens peuvent être en cours d'écrasement par un thread
+        // encore actif : on laisse une marge d'un quart du buffer
+        std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        std::uint64_t window = ThreadBuffer::CAPACITY - ThreadBuffer::CAPACITY / 4;
+        std::uint64_t begin = head > window ? head - window : 0;
+
+        for (std::uint64_t i = begin; i < head; ++i) {
+            const TraceEvent& event = buffer->events[i % ThreadBuffer::CAPACITY];
+            file << (first ? "" : ",\n") << "{\"name\": ";
+            writeJsonString(file, event.name);
+            file << ", \"cat\": \"cpu\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->threadId
+                 << ", \"ts\": " << event.startNs / 1000.0
+                 << ", \"dur\": " << (event.endNs - event.startNs) / 1000.0 << "}";
+            first = false;
+            ++eventCount;
+        }
+    }
+
+    file << "\n]}\n";
+    std::cout << "Wrote " << eventCount << " trace events to " << path << std::endl;
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,489 @@
+#include "WorldStreamer.hpp"
+#include "Geometry.hpp"
+#include "JobSystem.hpp"
+#include "MeshCache.hpp"
+#include "Trace.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+    struct WorldObject {
+        int mesh;
+        int material;
+        glm::mat4 model;
+    };
+
+    // Maillage source : primitive générée au chargement du monde, ou fichier lu par les threads
+    struct MeshSource {
+        std::string path;                   // Vide pour une primitive
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    bool parseMaterial(const std::string& name, const glm::vec3& color, Material& material) {
+        if (name == "plastic") material = Material::createPlastic(color);
+        else if (name == "metal") material = Material::createMetal(color);
+        else if (name == "rubber") material = Material::createRubber(color);
+        else if (name == "wood") material = Material::createWood(color);
+        else return false;
+        return true;
+    }
+
+    // Primitives aux mêmes dimensions que celles de la scène (demi-taille 1)
+    bool generatePrimitive(const std::string& name, Geometry& geometry) {
+        if (name == "sphere") geometry.generateSphere(1.0f, 32, 16);
+        else if (name == "cube") geometry.generateCube(2.0f);
+        else if (name == "cylinder") geometry.generateCylinder(1.0f, 1.0f, 24);
+        else if (name == "cone") geometry.generateCone(1.0f, 1.0f, 16);
+        else if (name == "plane") geometry.generatePlane(2.0f, 2.0f);
+        else return false;
+        return true;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+struct WorldStreamer::Data {
+    float cellSize = 16.0f;
+    std::vector<MeshSource> meshes;
+    std::vector<Material> materials;
+    std::vector<std::vector<WorldObject>> cellObjects;     // Indexé comme WorldStreamer::cells
+};
+
+// Résultat de la compilation d'une cellule : un bloc de sommets en espace monde par matériau
+struct WorldStreamer::CompiledCell {
+    struct Block {
+        int material;
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        glm::vec3 center = glm::vec3(0.0f);
+        float radius = 0.0f;
+    };
+
+    std::uint32_t cell = 0;
+    std::uint32_t request = 0;
+    std::vector<Block> blocks;
+};
+
+void WorldStreamer::compileCell(const Data& data, CompiledCell& compiled) {
+    TRACE_SCOPE("WorldStreamer::compileCell");
+
+    std::unordered_map<int, MeshCache::CompiledMesh> loadedMeshes;
+    std::vector<int> blockOfMaterial(data.materials.size(), -1);
+
+    for (const WorldObject& object : data.cellObjects[compiled.cell]) {
+        const MeshSource& source = data.meshes[object.mesh];
+        const Vertex* vertices = source.vertices.data();
+        std::size_t vertexCount = source.vertices.size();
+        const unsigned int* indices = source.indices.data();
+        std::size_t indexCount = source.indices.size();
+
+        if (!source.path.empty()) {
+            auto found = loadedMeshes.find(object.mesh);
+            if (found == loadedMeshes.end()) {
+                found = loadedMeshes.emplace(object.mesh, MeshCache::CompiledMesh()).first;
+                if (!MeshCache::load(source.path, found->second)) {
+                    std::cerr << "Failed to load world mesh: " << source.path << std::endl;
+                }
+            }
+            const MeshCache::CompiledMesh& mesh = found->second;
+            vertices = mesh.vertices;
+            vertexCount = mesh.vertexCount;
+            indices = mesh.indices;
+            indexCount = mesh.indexCount;
+        }
+        if (vertexCount == 0) continue;
+
+        int& blockIndex = blockOfMaterial[object.material];
+        if (blockIndex < 0) {
+            blockIndex = static_cast<int>(compiled.blocks.size());
+            compiled.blocks.push_back({object.material, {}, {}});
+        }
+        CompiledCell::Block& block = compiled.blocks[blockIndex];
+
+        unsigned int base = static_cast<unsigned int>(block.vertices.size());
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(object.model)));
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            const Vertex& v = vertices[i];
+            glm::vec3 position = glm::vec3(object.model * glm::vec4(v.x, v.y, v.z, 1.0f));
+            glm::vec3 normal = normalMatrix * glm::vec3(v.nx, v.ny, v.nz);
+            float length = glm::length(normal);
+            if (length > 0.0f) normal /= length;
+            block.vertices.push_back({position.x, position.y, position.z, normal.x, normal.y, normal.z, v.u, v.v});
+        }
+        if (indexCount > 0) {
+            for (std::size_t i = 0; i < indexCount; ++i) {
+                block.indices.push_back(base + indices[i]);
+            }
+        } else {
+            for (std::size_t i = 0; i < vertexCount; ++i) {
+                block.indices.push_back(base + static_cast<unsigned int>(i));
+            }
+        }
+    }
+
+    // Sphère englobante de chaque bloc (centre de la boîte englobante)
+    for (CompiledCell::Block& block : compiled.blocks) {
+        glm::vec3 minimum(block.vertices[0].x, block.vertices[0].y, block.vertices[0].z);
+        glm::vec3 maximum = minimum;
+        for (const Vertex& v : block.vertices) {
+            minimum = glm::min(minimum, glm::vec3(v.x, v.y, v.z));
+            maximum = glm::max(maximum, glm::vec3(v.x, v.y, v.z));
+        }
+        block.center = (minimum + maximum) * 0.5f;
+        for (const Vertex& v : block.vertices) {
+            block.radius = std::max(block.radius, glm::length(glm::vec3(v.x, v.y, v.z) - block.center));
+        }
+    }
+}
+
+WorldStreamer::WorldStreamer() : readyCells(std::make_shared<std::vector<CompiledCell>>()) {}
+
+WorldStreamer::~WorldStreamer() {
+    for (Cell& cell : cells) {
+        if (cell.state == CellState::RESIDENT) {
+            unloadCell(cell);
+        }
+    }
+}
+
+bool WorldStreamer::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open world file: " << path << std::endl;
+        return false;
+    }
+
+    std::shared_ptr<Data> world = std::make_shared<Data>();
+    std::map<std::string, int> meshIndices;
+    std::vector<std::pair<glm::ivec2, WorldObject>> placedObjects;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream stream(line);
+        std::string directive;
+        if (!(stream >> directive) || directive[0] == '#') continue;
+
+        if (directive == "cell_size") {
+            if (!(stream >> world->cellSize) || world->cellSize <= 0.0f) {
+                std::cerr << path << ":" << lineNumber << ": invalid cell size" << std::endl;
+                return false;
+            }
+            if (!placedObjects.empty()) {
+                std::cerr << path << ":" << lineNumber << ": cell_size must precede the objects" << std::endl;
+                return false;
+            }
+        } else if (directive == "object") {
+            std::string meshName, materialName;
+            glm::vec3 color, position, scale;
+            float yaw;
+            if (!(stream >> meshName >> materialName >> color.r >> color.g >> color.b
+                         >> position.x >> position.y >> position.z >> scale.x >> scale.y >> scale.z >> yaw)) {
+                std::cerr << path << ":" << lineNumber << ": expected 'object <mesh> <material> r g b x y z sx sy sz yaw'"
+                          << std::endl;
+                return false;
+            }
+
+            auto found = meshIndices.find(meshName);
+            if (found == meshIndices.end()) {
+                MeshSource source;
+                Geometry primitive;
+                if (generatePrimitive(meshName, primitive)) {
+                    source.vertices = primitive.getVertices();
+                    source.indices = primitive.getIndices();
+                } else {
+                    source.path = meshName;
+                }
+                found = meshIndices.emplace(meshName, static_cast<int>(world->meshes.size())).first;
+                world->meshes.push_back(std::move(source));
+            }
+
+            Material material;
+            if (!parseMaterial(materialName, color, material)) {
+                std::cerr << path << ":" << lineNumber << ": unknown material '" << materialName << "'" << std::endl;
+                return false;
+            }
+
+            WorldObject object;
+            object.mesh = found->second;
+            object.material = static_cast<int>(world->materials.size());
+            for (std::size_t i = 0; i < world->materials.size(); ++i) {
+                const Material& other = world->materials[i];
+                if (other.ambient == material.ambient && other.diffuse == material.diffuse &&
+                    other.specular == material.specular && other.shininess == material.shininess) {
+                    object.material = static_cast<int>(i);
+                    break;
+                }
+            }
+            if (object.material == static_cast<int>(world->materials.size())) {
+                world->materials.push_back(material);
+            }
+            object.model = glm::translate(glm::mat4(1.0f), position);
+            object.model = glm::rotate(object.model, glm::radians(yaw), glm::vec3(0.0f, 1.0f, 0.0f));
+            object.model = glm::scale(object.model, scale);
+
+            glm::ivec2 coordinates(static_cast<int>(std::floor(position.x / world->cellSize)),
+                                   static_cast<int>(std::floor(position.z / world->cellSize)));
+            placedObjects.emplace_back(coordinates, object);
+        } else {
+            std::cerr << path << ":" << lineNumber << ": unknown directive '" << directive << "'" << std::endl;
+            return false;
+        }
+    }
+
+    // Cellules non vides, dans l'ordre de la grille
+    std::map<std::pair<int, int>, std::uint32_t> cellIndices;
+    for (const auto& [coordinates, object] : placedObjects) {
+        cellIndices.emplace(std::make_pair(coordinates.x, coordinates.y), 0);
+    }
+
+    // Monde précédent : cellules résidentes libérées. Les compilations en cours le visent
+    // encore : nouvelle liste de remise (leurs résultats sont perdus) et numéros de demande
+    // qui continuent de croître.
+    std::uint32_t lastRequest = 0;
+    for (Cell& cell : cells) {
+        if (cell.state == CellState::RESIDENT) {
+            unloadCell(cell);
+        }
+        lastRequest = std::max(lastRequest, cell.request);
+    }
+    readyCells = std::make_shared<std::vector<CompiledCell>>();
+    cells.clear();
+    for (auto& [coordinates, index] : cellIndices) {
+        index = static_cast<std::uint32_t>(cells.size());
+        cells.emplace_back();
+        cells.back().coordinates = glm::ivec2(coordinates.first, coordinates.second);
+        cells.back().request = lastRequest;
+    }
+    world->cellObjects.resize(cells.size());
+    for (const auto& [coordinates, object] : placedObjects) {
+        world->cellObjects[cellIndices[std::make_pair(coordinates.x, coordinates.y)]].push_back(object);
+    }
+
+    data = world;
+    objects.clear();
+    stats = Stats();
+    stats.cellsTotal = static_cast<int>(cells.size());
+    std::cout << "World " << path << ": " << placedObjects.size() << " objects in " << cells.size() << " cells of "
+              << world->cellSize << " m, " << world->materials.size() << " materials" << std::endl;
+    return true;
+}
+
+float WorldStreamer::getDistance(const Cell& cell, const glm::vec3& position) const {
+    // Distance horizontale au rectangle de la cellule (0 à l'intérieur)
+    glm::vec2 minimum = glm::vec2(cell.coordinates) * data->cellSize;
+    glm::vec2 point(position.x, position.z);
+    glm::vec2 closest = glm::clamp(point, minimum, minimum + data->cellSize);
+    return glm::length(point - closest);
+}
+
+void WorldStreamer::requestCell(std::uint32_t index) {
+    Cell& cell = cells[index];
+    cell.state = CellState::LOADING;
+    std::uint32_t request = ++cell.request;
+
+    std::shared_ptr<const Data> world = data;
+    std::weak_ptr<std::vector<CompiledCell>> ready = readyCells;
+    JobSystem::submit([world, ready, index, request] {
+        std::shared_ptr<CompiledCell> compiled = std::make_shared<CompiledCell>();
+        compiled->cell = index;
+        compiled->request = request;
+        compileCell(*world, *compiled);
+
+        // Remise au thread GL ; ignorée si le monde a été détruit entre-temps
+        JobSystem::submitToMainThread([ready, compiled] {
+            if (std::shared_ptr<std::vector<CompiledCell>> readyList = ready.lock()) {
+                readyList->push_back(std::move(*compiled));
+            }
+        });
+    });
+}
+
+void WorldStreamer::uploadCell(CompiledCell& compiled) {
+    Cell& cell = cells[compiled.cell];
+    std::string name = "cell " + std::to_string(cell.coordinates.x) + "," + std::to_string(cell.coordinates.y);
+    for (CompiledCell::Block& block : compiled.blocks) {
+        std::unique_ptr<Geometry> geometry = std::make_unique<Geometry>();
+        geometry->setupMesh(block.vertices.data(), block.vertices.size(), block.indices.data(), block.indices.size(),
+                            block.center, block.radius);
+        cell.bytes += geometry->getGpuBytes();
+        cell.chunks.push_back({ResourceManager::addGeometry(std::move(geometry), name), block.material});
+    }
+    cell.state = CellState::RESIDENT;
+    cell.wanted = false;
+
+    double latency = elapsedMs(cell.wantedTime);
+    ++stats.loads;
+    stats.latencyMs += latency;
+    stats.maxLatencyMs = std::max(stats.maxLatencyMs, latency);
+    stats.residentBytes += cell.bytes;
+    stats.peakResidentBytes = std::max(stats.peakResidentBytes, stats.residentBytes);
+}
+
+void WorldStreamer::unloadCell(Cell& cell) {
+    for (const Chunk& chunk : cell.chunks) {
+        ResourceManager::release(chunk.geometry);
+    }
+    cell.chunks.clear();
+    stats.residentBytes -= cell.bytes;
+    cell.bytes = 0;
+    cell.state = CellState::UNLOADED;
+    ++stats.unloads;
+}
+
+void WorldStreamer::rebuildObjects() {
+    objects.clear();
+    for (const Cell& cell : cells) {
+        for (const Chunk& chunk : cell.chunks) {
+            objects.emplace_back(chunk.geometry, data->materials[chunk.material]);
+        }
+    }
+}
+
+void WorldStreamer::update(const glm::vec3& cameraPosition) {
+    TRACE_SCOPE("WorldStreamer::update");
+    if (cells.empty()) return;
+
+    settings.unloadRadius = std::max(settings.unloadRadius, settings.loadRadius);
+    bool changed = false;
+
+    // Cellules remises par les threads depuis la dernière frame (résultats périmés écartés)
+    std::vector<CompiledCell>& ready = *readyCells;
+    ready.erase(std::remove_if(ready.begin(), ready.end(), [this](const CompiledCell& compiled) {
+        if (compiled.cell >= cells.size()) return true;
+        Cell& cell = cells[compiled.cell];
+        if (compiled.request != cell.request) return true;
+        if (cell.state == CellState::LOADING) cell.state = CellState::READY;
+        return cell.state != CellState::READY;
+    }), ready.end());
+
+    // File de priorité des cellules à charger, la plus proche en tête
+    using Candidate = std::pair<float, std::uint32_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+    int loading = 0;
+    for (std::uint32_t index = 0; index < cells.size(); ++index) {
+        Cell& cell = cells[index];
+        float distance = getDistance(cell, cameraPosition);
+        bool outside = distance > settings.unloadRadius;
+
+        switch (cell.state) {
+            case CellState::UNLOADED:
+                if (distance < settings.loadRadius) {
+                    if (!cell.wanted) {
+                        cell.wanted = true;
+                        cell.wantedTime = Clock::now();
+                    }
+                    queue.emplace(distance, index);
+                } else {
+                    cell.wanted = false;
+                }
+                break;
+            case CellState::LOADING:
+            case CellState::READY:
+                if (outside) {
+                    // Le résultat (en cours ou en attente) sera écarté
+                    ++cell.request;
+                    cell.state = CellState::UNLOADED;
+                    cell.wanted = false;
+                    ++stats.cancelled;
+                } else if (cell.state == CellState::LOADING) {
+                    ++loading;
+                }
+                break;
+            case CellState::RESIDENT:
+                if (outside) {
+                    unloadCell(cell);
+                    changed = true;
+                }
+                break;
+        }
+    }
+
+    while (!queue.empty() && loading < settings.maxLoadsInFlight) {
+        requestCell(queue.top().second);
+        queue.pop();
+        ++loading;
+    }
+    stats.cellsQueued = static_cast<int>(queue.size());
+
+    // Transferts : cellules prêtes les plus proches d'abord, dans le budget de la frame
+    auto uploadStart = Clock::now();
+    std::vector<std::pair<float, std::size_t>> order;
+    for (std::size_t i = 0; i < ready.size(); ++i) {
+        const Cell& cell = cells[ready[i].cell];
+        if (cell.state == CellState::READY && ready[i].request == cell.request) {
+            order.emplace_back(getDistance(cell, cameraPosition), i);
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    std::size_t budgetBytes = static_cast<std::size_t>(settings.uploadBudgetKB) * 1024;
+    std::size_t uploadedBytes = 0;
+    std::vector<bool> uploaded(ready.size(), false);
+    for (const auto& [distance, i] : order) {
+        if (budgetBytes > 0 && uploadedBytes >= budgetBytes) break;
+        uploadCell(ready[i]);
+        uploadedBytes += cells[ready[i].cell].bytes;
+        uploaded[i] = true;
+        changed = true;
+    }
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < ready.size(); ++i) {
+        if (!uploaded[i] && cells[ready[i].cell].state == CellState::READY) {
+            if (next != i) ready[next] = std::move(ready[i]);
+            ++next;
+        }
+    }
+    ready.resize(next);
+    stats.uploadMs = elapsedMs(uploadStart);
+    stats.maxUploadMs = std::max(stats.maxUploadMs, stats.uploadMs);
+
+    if (changed) {
+        rebuildObjects();
+    }
+
+    stats.cellsResident = 0;
+    stats.cellsLoading = 0;
+    stats.cellsReady = 0;
+    for (const Cell& cell : cells) {
+        if (cell.state == CellState::RESIDENT) ++stats.cellsResident;
+        else if (cell.state == CellState::LOADING) ++stats.cellsLoading;
+        else if (cell.state == CellState::READY) ++stats.cellsReady;
+    }
+}
+
+void WorldStreamer::finishLoading(const glm::vec3& cameraPosition) {
+    TRACE_SCOPE("WorldStreamer::finishLoading");
+    if (cells.empty()) return;
+
+    int uploadBudget = settings.uploadBudgetKB;
+    settings.uploadBudgetKB = 0;
+    JobSystem::waitOnMainThread([&] {
+        update(cameraPosition);
+        return stats.cellsQueued + stats.cellsLoading + stats.cellsReady == 0;
+    });
+    settings.uploadBudgetKB = uploadBudget;
+}
+
+void WorldStreamer::printReport() const {
+    if (cells.empty()) return;
+
+    std::cout << "World streaming: " << stats.cellsResident << "/" << stats.cellsTotal << " cells resident ("
+              << static_cast<double>(stats.residentBytes) / (1024.0 * 1024.0) << " MB, peak "
+              << static_cast<double>(stats.peakResidentBytes) / (1024.0 * 1024.0) << " MB), " << stats.loads
+              << " loads, " << stats.unloads << " unloads, " << stats.cancelled << " cancelled; latency "
+              << (stats.loads > 0 ? stats.latencyMs / stats.loads : 0.0) << " ms avg (max " << stats.maxLatencyMs
+              << " ms), upload " << stats.maxUploadMs << " ms max per frame" << std::endl;
+}
@@ -3,6 +3,10 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <bitset>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <memory>
 #include <stb/stb_image.h>
@@ -13,20 +17,56 @@
 #include "Material.hpp"
 #include "Geometry.hpp"
 #include "Skybox.h"
+#include "FrameArena.hpp"
+#include "AllocationCounter.hpp"
+#include "RenderList.hpp"
+#include "RenderStats.hpp"
+#include "AppOptions.hpp"
+#include "OffscreenTarget.hpp"
+#include "Benchmark.hpp"
+#include "CameraPath.hpp"
+#include "GpuProfiler.hpp"
+#include "FragmentCounter.hpp"
+#include "Trace.hpp"
+#include "ProgramCache.hpp"
+#include "TextureCache.hpp"
+#include "MeshCache.hpp"
+#include "AssetPack.hpp"
+#include "JobSystem.hpp"
+#include "AsyncLoader.hpp"
+#include "ResourceManager.hpp"
+#include "WorldStreamer.hpp"
+#include "Terrain.hpp"
+#include "StressScene.hpp"
+#include "ShaderVariants.hpp"
+#include "ShaderCompiler.hpp"
+#include "HotReloader.hpp"
+#include "GLState.hpp"
+#include "CascadedShadowMap.hpp"
+#include "ShadowSettings.hpp"
+#include "ShadowAtlas.hpp"
+#include "PointShadowMaps.hpp"
 
 // Window dimensions
 const unsigned int SCR_WIDTH = 1200;
 const unsigned int SCR_HEIGHT = 900;
 
-// Shadow map dimensions
-const unsigned int SHADOW_WIDTH = 1024;
-const unsigned int SHADOW_HEIGHT = 1024;
+// Résolution de chaque cascade d'ombre et de la shadow atlas des spots
+const int SHADOW_RESOLUTION = 1024;
+const int SHADOW_ATLAS_SIZE = 2048;
+const int POINT_SHADOW_RESOLUTION = 512;
+
+// Archive construite par la cible asset_pack, à côté de l'exécutable
+const char* const DEFAULT_ASSET_PACK = "assets.pack";
+
+// Temps accordé par frame aux uploads des chargements asynchrones (thread GL)
+const double ASYNC_UPLOAD_BUDGET_MS = 2.0;
 
 // Camera
 std::unique_ptr<Camera> camera;
 
 // Skybox
-Skybox* skybox = nullptr;
+std::unique_ptr<Skybox> skybox;
 
 // Mouse and time
 float lastX = SCR_WIDTH / 2.0f;
@@ -35,55 +75,101 @@ bool firstMouse = true;
 float deltaTime = 0.0f;
 float lastFrame = 0.0f;
 
+// Horloge de la scène (animation). En benchmark, avance d'un pas fixe par frame
+// au lieu de suivre glfwGetTime() pour que chaque exécution soit identique.
+float sceneTime = 0.0f;
+const float FIXED_TIME_STEP = 1.0f / 60.0f;
+
 // GUI settings
 bool shadowsEnabled = true;
+ShadowSettings shadowSettings;
 bool wireframeMode = false;
 bool showLightSources = false;  // Nouvelle option
+bool depthPrepassEnabled = false;  // Pré-passe de profondeur avant la passe éclairée
 bool uiMode = false;  // Mode interface utilisateur
 bool tabKeyPressed = false;  // Pour éviter les répétitions de basculement
+bool traceKeyPressed = false;  // F9 : écriture de la trace CPU
 
 // Gestionnaire de lumières
 LightManager lightManager;
 
-// Géométries
-std::unique_ptr<Geometry> sphereGeometry;
-std::unique_ptr<Geometry> cubeGeometry;
-std::unique_ptr<Geometry> planeGeometry;
-std::unique_ptr<Geometry> groundPlaneGeometry;
-std::unique_ptr<Geometry> cylinderGeometry;
+// Géométries (possédées par ResourceManager)
+GeometryHandle sphereGeometry;
+GeometryHandle cubeGeometry;
+GeometryHandle planeGeometry;
+GeometryHandle cylinderGeometry;
+GeometryHandle modelGeometry;           // Modèle importé (--model), streamable
 
 // Géométries pour visualiser les lumières
-std::unique_ptr<Geometry> lightSphereGeometry;  // Pour point lights
-std::unique_ptr<Geometry> lightConeGeometry;    // Pour spot lights
-std::unique_ptr<Geometry> lightCylinderGeometry; // Pour directional lights
+GeometryHandle lightSphereGeometry;     // Pour point lights
+GeometryHandle lightConeGeometry;       // Pour spot lights
+GeometryHandle lightCylinderGeometry;   // Pour directional lights
+
+// Objets de la scène
+std::vector<SceneObject> sceneObjects;
+
+// Scène de test de montée en charge (--stress-objects, fenêtre Stress Scene)
+StressSceneSettings stressSettings;
+std::vector<SceneObject> stressObjects;
+
+// Sol : terrain en chunks, niveau de détail choisi autour de la caméra
+std::unique_ptr<Terrain> terrain;
+
+// Monde en streaming (--world) : cellules chargées autour de la caméra
+std::unique_ptr<WorldStreamer> worldStreamer;
 
-// Matériaux
-Material metalMaterial;
-Material plasticMaterial;
-Material groundMaterial;
+// Arène pour les allocations transitoires de la frame (listes de rendu, résultats de culling)
+FrameArena frameArena(256 * 1024);
+RenderStats renderStats;
+
+// Profilage : chronomètre CPU par passe et timestamps GPU
+FrameTimer frameTimer;
+std::unique_ptr<GpuProfiler> gpuProfiler;
+std::unique_ptr<FragmentCounter> fragmentCounter;   // Overdraw (GL_SAMPLES_PASSED)
+
+// Filtre d'ombre de chaque frame en vol : le coût GPU est relu plusieurs frames plus tard
+const int FRAME_FILTER_HISTORY = 2 * GpuProfiler::FRAME_LATENCY;
+ShadowFilter frameShadowFilters[FRAME_FILTER_HISTORY];
+bool frameDepthPrepass[FRAME_FILTER_HISTORY];       // Pré-passe active, même principe
 
 // Function prototypes
+GLFWwindow* createWindow(bool headless);
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 void processInput(GLFWwindow *window);
-void renderScene(Shader& shader);
+void renderScene(Shader& shader, const CullResult& items);
+void renderDepth(Shader& shader, const CullResult& items);
+size_t renderPointShadowCasters(Shader& shader, const PointShadowMaps& pointShadows,
+                                const PointShadowMaps::ShadowedLight& shadowed, const RenderList& items, int face);
 void renderLightSources(Shader& shader);
+void beginRenderPass(RenderPass pass);
+void recordShadowFilterCost(const std::vector<GpuProfiler::ScopeResult>& scopes, ShadowFilter filter);
+void recordDepthPrepassCost(const std::vector<GpuProfiler::ScopeResult>& scopes, bool depthPrepass);
+void collectFragmentCounts();
+void endRenderPass(RenderPass pass);
 void initializeScene();
+void initializeLights();
+void applyStressScene();
+Task<bool> loadModel(std::string path);
+ShaderVariantKey getLightingVariantKey();
+std::vector<ShaderVariantKey> getLightingWarmUpKeys();
+
+int main(int argc, char** argv) {
+    TRACE_THREAD_NAME("main");
+
+    AppOptions options;
+    if (!parseAppOptions(argc, argv, options)) {
+        printAppUsage(argv[0]);
+        return -1;
+    }
+    if (options.showHelp) {
+        printAppUsage(argv[0]);
+        return 0;
+    }
 
-int main() {
-    // Initialize GLFW
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-
-    // Create window
-    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Multi-Light Blinn-Phong Scene", NULL, NULL);
+    // Create window (invisible in headless mode)
+    GLFWwindow* window = createWindow(options.headless);
     if (window == NULL) {
         std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
@@ -96,54 +182,129 @@ int main() {
 
     // Commencer en mode UI pour faciliter l'utilisation
     uiMode = true;
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    if (!options.headless) {
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    }
 
     // Initialize GLEW
-    if (glewInit() != GLEW_OK) {
+    // Avec un contexte EGL/OSMesa il n'y a pas de display GLX : ce n'est pas une erreur en headless
+    glewExperimental = GL_TRUE;
+    GLenum glewStatus = glewInit();
+    if (glewStatus != GLEW_OK && !(options.headless && glewStatus == GLEW_ERROR_NO_GLX_DISPLAY)) {
         std::cerr << "Failed to initialize GLEW" << std::endl;
         return -1;
     }
 
+    if (options.headless) {
+        std::cout << "Headless rendering on: " << glGetString(GL_RENDERER)
+                  << " (" << glGetString(GL_VERSION) << ")" << std::endl;
+    }
+
     // Configure global OpenGL state
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
+    // GL_LEQUAL pour toute la frame : la skybox (profondeur 1.0) n'a pas besoin de bascule
+    GLState::setEnabled(GL_DEPTH_TEST, true);
+    GLState::setEnabled(GL_CULL_FACE, true);
+    GLState::setDepthFunc(GL_LEQUAL);
+
+    // Build and compile shaders (programmes liés relus depuis le cache disque si possible)
+    ProgramCache::setEnabled(!options.disableProgramCache);
+    TextureCache::setEnabled(!options.disableTextureCache);
+    MeshCache::setEnabled(!options.disableMeshCache);
+    ResourceManager::setBudget(static_cast<std::size_t>(options.vramBudgetMB) * 1024 * 1024);
+    auto shaderSetupStart = std::chrono::steady_clock::now();
+
+    // Archive d'assets projetée en mémoire. Par défaut seulement sans session interactive :
+    // sinon les fichiers restent la source des shaders et images (rechargement à chaud)
+    std::string assetPackPath = options.assetPackPath;
+    bool interactive = !options.headless && options.benchmarkCameraPath.empty();
+    if (assetPackPath.empty() && !interactive && std::filesystem::exists(DEFAULT_ASSET_PACK)) {
+        assetPackPath = DEFAULT_ASSET_PACK;
+    }
+    if (!options.disableAssetPack && !assetPackPath.empty() && AssetPack::mount(assetPackPath)) {
+        const AssetPack* pack = AssetPack::getMounted();
+        std::chrono::duration<double, std::milli> mountTime = std::chrono::steady_clock::now() - shaderSetupStart;
+        std::cout << "Asset pack " << pack->getPath() << ": " << pack->getEntryCount() << " entries, "
+                  << static_cast<double>(pack->getMappedSize()) / (1024.0 * 1024.0) << " MB mapped in "
+                  << mountTime.count() << " ms" << std::endl;
+    }
 
-    // Build and compile shaders
+    // Débit d'import / chargement d'un modèle : pas de scène
+    if (!options.meshBenchmarkPath.empty()) {
+        bool succeeded = runMeshBenchmark(options.meshBenchmarkPath);
+        glfwTerminate();
+        return succeeded ? 0 : -1;
+    }
+
+    std::unique_ptr<ShaderCompiler> shaderCompiler = std::make_unique<ShaderCompiler>(window);
     Shader shadowMapShader("assets/shaders/shadow.vert", "assets/shaders/shadow.frag");
-    Shader lightingShader("assets/shaders/blinn_phong.vert", "assets/shaders/blinn_phong.frag");  // Nouveaux shaders
+    Shader pointShadowShader("assets/shaders/shadow_point.vert", "assets/shaders/shadow_point.geom",
+                             "assets/shaders/shadow_point.frag");
+    Shader pointShadowFaceShader("assets/shaders/shadow_point.vert", "assets/shaders/shadow_point.frag",
+                                 {{"SINGLE_FACE", "1"}});
+    // Pré-passe de profondeur : chemin des ombres avec les matrices de la caméra
+    Shader depthPrepassShader("assets/shaders/shadow.vert", "assets/shaders/shadow.frag",
+                              {{"DEPTH_PREPASS", "1"}});
+    depthPrepassEnabled = options.depthPrepass;
+    Shader momentsBlurShader("assets/shaders/shadow_moments.vert", "assets/shaders/shadow_moments.frag");
+    shadowSettings.pointShadowsSinglePass = options.pointShadowPasses == 1;
+    shadowSettings.filter = static_cast<ShadowFilter>(options.shadowFilter);
+    ShaderVariants lightingShaders("assets/shaders/blinn_phong.vert", "assets/shaders/blinn_phong.frag",
+                                   shaderCompiler.get());
 
     // Initialize scene (camera, lights, geometries, materials)
     initializeScene();
 
-    // Initialize GUI
-    GUI gui(window);
-
-    // Configure depth map FBO
-    unsigned int depthMapFBO;
-    glGenFramebuffers(1, &depthMapFBO);
-
-    // Create depth texture
-    unsigned int depthMap;
-    glGenTextures(1, &depthMap);
-    glBindTexture(GL_TEXTURE_2D, depthMap);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
-
-    // Attach depth texture as FBO's depth buffer
-    glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthMap, 0);
-    glDrawBuffer(GL_NONE);
-    glReadBuffer(GL_NONE);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-    // Lighting shader configuration
-    lightingShader.use();
-    lightingShader.setUniform("shadowMap", 1);
+    // Scène de test : avant le warm-up, pour que les variantes soumises correspondent à ses lumières
+    stressSettings.enabled = options.stressObjects > 0;
+    stressSettings.objectCount = options.stressObjects > 0 ? options.stressObjects : stressSettings.objectCount;
+    stressSettings.directionalLights = options.stressDirectionalLights;
+    stressSettings.pointLights = options.stressPointLights;
+    stressSettings.spotLights = options.stressSpotLights;
+    stressSettings.seed = options.stressSeed;
+    stressSettings.animate = options.stressAnimate;
+    if (stressSettings.enabled) {
+        applyStressScene();
+    }
+
+    // Chargements en arrière-plan : le modèle rejoint la scène quand il est prêt
+    JobSystem::initialize();
+    Task<bool> modelLoad;
+    if (!options.modelPath.empty()) {
+        modelLoad = loadModel(options.modelPath);
+    }
+    if (!options.worldPath.empty()) {
+        worldStreamer = std::make_unique<WorldStreamer>();
+        if (!worldStreamer->load(options.worldPath)) {
+            glfwTerminate();
+            return -1;
+        }
+    }
+
+    // Warm-up : variantes d'éclairage probables soumises en parallèle, pendant le décodage de la skybox
+    lightingShaders.warmUp(getLightingWarmUpKeys());
+
+    // Initialize GUI (pas d'interface en mode headless)
+    std::unique_ptr<GUI> gui;
+    if (!options.headless) {
+        gui = std::make_unique<GUI>(window);
+    }
+
+    // En mode headless, la scène est rendue dans un FBO au lieu du framebuffer par défaut
+    std::unique_ptr<OffscreenTarget> offscreenTarget;
+    GLuint sceneFramebuffer = 0;
+    if (options.headless) {
+        offscreenTarget = std::make_unique<OffscreenTarget>(SCR_WIDTH, SCR_HEIGHT);
+        if (!offscreenTarget->isComplete()) {
+            glfwTerminate();
+            return -1;
+        }
+        sceneFramebuffer = offscreenTarget->getFramebuffer();
+    }
+
+    // Cascades d'ombre de la lumière directionnelle
+    std::unique_ptr<CascadedShadowMap> shadowCascades = std::make_unique<CascadedShadowMap>(SHADOW_RESOLUTION);
+    std::unique_ptr<ShadowAtlas> shadowAtlas = std::make_unique<ShadowAtlas>(SHADOW_ATLAS_SIZE);
+    std::unique_ptr<PointShadowMaps> pointShadows = std::make_unique<PointShadowMaps>(POINT_SHADOW_RESOLUTION);
 
     std::vector<std::string> faces = {
         "assets/images/right.jpg",   // +X
@@ -154,151 +315,689 @@ int main() {
         "assets/images/back.jpg"     // -Z
     };
 
-    skybox = new Skybox(faces);
+    skybox = std::make_unique<Skybox>(faces);
+
+    // Les premières frames ne doivent pas attendre une compilation
+    shaderCompiler->waitIdle();
+
+    // Temps de démarrage des shaders : cache froid (compilation) vs chaud (binaires)
+    std::chrono::duration<double, std::milli> shaderSetupTime = std::chrono::steady_clock::now() - shaderSetupStart;
+    ProgramCache::printReport();
+    std::cout << "Shader and scene setup: " << shaderSetupTime.count() << " ms" << std::endl;
+
+    // Sans fenêtre, les images produites doivent être identiques d'une exécution à l'autre :
+    // pas de frame avec le placeholder de la skybox
+    if (options.headless || !options.benchmarkCameraPath.empty()) {
+        auto skyboxStart = std::chrono::steady_clock::now();
+        skybox->finishLoading();
+        if (modelLoad.isValid()) {
+            JobSystem::waitOnMainThread([&modelLoad] { return modelLoad.isReady(); });
+        }
+        std::chrono::duration<double, std::milli> skyboxWait = std::chrono::steady_clock::now() - skyboxStart;
+        TextureCache::printReport();
+        MeshCache::printReport();
+        AsyncLoader::printReport();
+        ResourceManager::printReport();
+        std::cout << "Skybox ready after " << skyboxWait.count() << " ms more" << std::endl;
+    }
+
+    // Benchmark : chemin de caméra rejoué avec l'horloge simulée
+    CameraPath benchmarkPath;
+    std::unique_ptr<BenchmarkRecorder> benchmark;
+    if (!options.benchmarkCameraPath.empty()) {
+        if (!benchmarkPath.load(options.benchmarkCameraPath)) {
+            glfwTerminate();
+            return -1;
+        }
+        benchmark = std::make_unique<BenchmarkRecorder>(options.warmupFrames, options.measuredFrames);
+
+        // Contenu de la scène dans le rapport : temps de frame en fonction des objets et des lumières
+        LightManager::LightCounts lightCounts = lightManager.countEnabledLights();
+        BenchmarkScene scene;
+        scene.objects = sceneObjects.size() + stressObjects.size();
+        scene.directionalLights = lightCounts.directional;
+        scene.pointLights = lightCounts.point;
+        scene.spotLights = lightCounts.spot;
+        scene.seed = stressSettings.enabled ? stressSettings.seed : 0;
+        benchmark->setScene(scene);
+    }
+
+    // Sans fenêtre, les chunks du terrain et les cellules autour du point de départ sont
+    // résidents dès la première frame
+    if (options.headless || benchmark) {
+        if (benchmark) {
+            benchmarkPath.apply(0.0f, *camera);
+        }
+        terrain->finishLoading(camera->getPosition());
+        terrain->printReport();
+        if (worldStreamer) {
+            worldStreamer->finishLoading(camera->getPosition());
+            worldStreamer->printReport();
+        }
+    }
+
+    // Rechargement à chaud des shaders et de la skybox (session interactive uniquement)
+    std::unique_ptr<HotReloader> hotReloader;
+    // Les lectures passent par l'archive montée : modifier les fichiers n'aurait aucun effet
+    if (!options.headless && !benchmark && !AssetPack::getMounted()) {
+        hotReloader = std::make_unique<HotReloader>(shaderCompiler.get());
+        hotReloader->watchDirectory("assets/shaders");
+        hotReloader->watchDirectory("assets/shaders/include");
+        hotReloader->watchDirectory("assets/images");
+        hotReloader->addShader(&shadowMapShader);
+        hotReloader->addShader(&depthPrepassShader);
+        hotReloader->addShader(&pointShadowShader);
+        hotReloader->addShader(&pointShadowFaceShader);
+        hotReloader->addShader(&momentsBlurShader);
+        hotReloader->addShader(skybox->getShader());
+        hotReloader->addShaderVariants(&lightingShaders);
+        for (const std::string& face : skybox->getFaces()) {
+            hotReloader->addFile(face, [] { skybox->reloadAsync(); });
+        }
+        if (!options.modelPath.empty()) {
+            // Le cache de maillages recompile la source modifiée (clé = chemin + date)
+            std::filesystem::path modelDirectory = std::filesystem::path(options.modelPath).parent_path();
+            hotReloader->watchDirectory(modelDirectory.empty() ? "." : modelDirectory.string());
+            hotReloader->addFile(options.modelPath, [] { ResourceManager::reloadSource(modelGeometry); });
+        }
+    }
+
+    // Enregistrement du chemin de caméra (session interactive)
+    CameraPath recordedPath;
+    float lastRecordTime = -1.0f;
 
+    gpuProfiler = std::make_unique<GpuProfiler>();
+    fragmentCounter = std::make_unique<FragmentCounter>();
+    renderStats.screenPixels = static_cast<std::size_t>(SCR_WIDTH) * SCR_HEIGHT;
+
+    std::size_t lastAllocationCount = AllocationCounter::getCount();
+    std::size_t lastAllocatedBytes = AllocationCounter::getBytes();
+
+    int frameIndex = 0;
+    double renderStartTime = glfwGetTime();
 
     // Main render loop
     while (!glfwWindowShouldClose(window)) {
+        if (benchmark && frameIndex >= benchmark->getTotalFrames()) {
+            break;
+        }
+        if (!benchmark && options.headless && frameIndex >= options.frameCount) {
+            break;
+        }
+
+        TRACE_SCOPE("frame");
+
+        // Allocations sur le tas pendant la frame précédente
+        renderStats.heapAllocations = AllocationCounter::getCount() - lastAllocationCount;
+        renderStats.heapBytes = AllocationCounter::getBytes() - lastAllocatedBytes;
+        lastAllocationCount = AllocationCounter::getCount();
+        lastAllocatedBytes = AllocationCounter::getBytes();
+
+        // Libérer les allocations transitoires de la frame précédente
+        frameArena.reset();
+
+        // Résultats GPU des frames précédentes (relus avec retard, sans bloquer)
+        while (gpuProfiler->collect()) {
+            renderStats.gpuFrameMs = gpuProfiler->getResolvedFrameMs();
+            recordShadowFilterCost(gpuProfiler->getResolvedScopes(),
+                                   frameShadowFilters[gpuProfiler->getResolvedFrameIndex() % FRAME_FILTER_HISTORY]);
+            recordDepthPrepassCost(gpuProfiler->getResolvedScopes(),
+                                   frameDepthPrepass[gpuProfiler->getResolvedFrameIndex() % FRAME_FILTER_HISTORY]);
+            if (benchmark) {
+                benchmark->recordGpu(gpuProfiler->getResolvedFrameIndex(), gpuProfiler->getResolvedFrameMs(),
+                                     gpuProfiler->getResolvedScopes());
+            }
+        }
+
+        collectFragmentCounts();
+
+        // Variantes de shaders compilées en arrière-plan (repli sur la variante générique d'ici là)
+        shaderCompiler->poll();
+        if (hotReloader) {
+            hotReloader->update();
+        }
+        // Cubemap décodée en arrière-plan : upload PBO puis échange avec le placeholder
+        skybox->pollAsyncLoad();
+        // Reprises des chargements asynchrones sur le thread GL (uploads), dans le budget de la frame
+        JobSystem::runMainThreadJobs(ASYNC_UPLOAD_BUDGET_MS);
+
+        frameTimer.beginFrame();
+        gpuProfiler->beginFrame(frameIndex);
+        fragmentCounter->beginFrame(frameIndex);
+
         // Per-frame time logic
         float currentFrame = static_cast<float>(glfwGetTime());
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
+        if (benchmark) {
+            deltaTime = FIXED_TIME_STEP;
+            sceneTime = frameIndex * FIXED_TIME_STEP;
+            benchmarkPath.apply(sceneTime, *camera);
+        } else {
+            sceneTime = currentFrame;
+        }
+
         // Process input
-        processInput(window);
+        if (!options.headless && !benchmark) {
+            processInput(window);
+        }
+
+        if (!options.recordCameraPath.empty() && currentFrame - lastRecordTime >= 0.1f) {
+            recordedPath.record(currentFrame, *camera);
+            lastRecordTime = currentFrame;
+        }
 
         // Start ImGui frame
-        gui.newFrame();
+        if (gui) {
+            gui->newFrame();
+        }
+
+        GLState::resetCounters();
 
         // Clear screen
+        GLState::bindFramebuffer(sceneFramebuffer);
         glClearColor(0.05f, 0.05f, 0.1f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Set wireframe mode
-        if (wireframeMode) {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        } else {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        }
-
-        // Light space matrix calculation (using first directional light if available)
-        glm::mat4 lightSpaceMatrix = glm::mat4(1.0f);
-        if (lightManager.getLightCount() > 0) {
-            auto& lights = lightManager.getLights();
-            if (lights[0]->type == LightType::DIRECTIONAL) {
-                DirectionalLight* dirLight = static_cast<DirectionalLight*>(lights[0].get());
-                float near_plane = 1.0f, far_plane = 15.0f;
-                glm::mat4 lightProjection = glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, near_plane, far_plane);
-                glm::mat4 lightView = glm::lookAt(dirLight->position,
-                                                  dirLight->position + dirLight->direction,
-                                                  glm::vec3(0.0f, 1.0f, 0.0f));
-                lightSpaceMatrix = lightProjection * lightView;
+        GLState::setPolygonMode(wireframeMode ? GL_LINE : GL_FILL);
+
+        // Niveaux de détail du terrain et cellules du monde selon la position de la caméra,
+        // transfert des chunks et cellules prêts dans le budget de la frame
+        terrain->update(camera->getPosition());
+        if (worldStreamer) {
+            worldStreamer->update(camera->getPosition());
+        }
+
+        // Liste de rendu de la frame (allouée dans l'arène)
+        RenderList renderList(&frameArena);
+        buildRenderList(sceneObjects, sceneTime, renderList);
+        appendRenderList(stressObjects, sceneTime, renderList);
+        appendRenderList(terrain->getObjects(), sceneTime, renderList);
+        if (worldStreamer) {
+            appendRenderList(worldStreamer->getObjects(), sceneTime, renderList);
+        }
+
+        // 1. Render depth of scene to the cascades (first enabled directional light, lights[0] in the shader)
+        const DirectionalLight* dirLight = lightManager.getShadowCaster();
+        float aspectRatio = static_cast<float>(SCR_WIDTH) / static_cast<float>(SCR_HEIGHT);
+        glm::mat4 projection = camera->getProjectionMatrix(aspectRatio);
+        glm::mat4 view = camera->getViewMatrix();
+        size_t shadowCasterCount = 0;
+        beginRenderPass(RenderPass::SHADOW);
+        if (shadowsEnabled && dirLight) {
+            shadowCascades->update(*camera, aspectRatio, dirLight->direction, renderList, shadowSettings);
+            shadowMapShader.use();
+
+            static const char* const cascadeScopeNames[CascadedShadowMap::MAX_CASCADES] = {
+                "cascade0", "cascade1", "cascade2", "cascade3"
+            };
+            for (int cascade = 0; cascade < shadowCascades->getCascadeCount(); ++cascade) {
+                CullResult shadowCasters(&frameArena);
+                cullRenderList(renderList, Frustum(shadowCascades->getMatrix(cascade)), shadowCasters);
+
+                GpuProfiler::Scope scope(*gpuProfiler, cascadeScopeNames[cascade]);
+                shadowMapShader.setUniform("lightSpaceMatrix", shadowCascades->getMatrix(cascade));
+
+                if (!shadowCascades->isCachingEnabled()) {
+                    shadowCascades->beginCascade(cascade, true);
+                    renderScene(shadowMapShader, shadowCasters);
+                    shadowCasterCount += shadowCasters.size();
+                    continue;
+                }
+
+                // Casters statiques dans la couche en cache (seulement si elle est périmée),
+                // casters dynamiques par-dessus une copie de celle-ci
+                CullResult staticCasters(&frameArena);
+                CullResult dynamicCasters(&frameArena);
+                for (const DrawItem* item : shadowCasters) {
+                    (item->isStatic ? staticCasters : dynamicCasters).push_back(item);
+                }
+
+                if (shadowCascades->isStaticRefreshScheduled(cascade)) {
+                    shadowCascades->beginStaticLayer(cascade);
+                    renderScene(shadowMapShader, staticCasters);
+                    shadowCasterCount += staticCasters.size();
+                }
+                if (shadowCascades->beginCascade(cascade, !dynamicCasters.empty())) {
+                    renderScene(shadowMapShader, dynamicCasters);
+                    shadowCasterCount += dynamicCasters.size();
+                }
+            }
+
+            // VSM : moments floutés des cascades recomposées
+            if (shadowSettings.filter == ShadowFilter::VSM) {
+                GpuProfiler::Scope scope(*gpuProfiler, "shadow_prefilter");
+                shadowCascades->prefilterMoments(momentsBlurShader, shadowSettings);
             }
         }
+        frameShadowFilters[frameIndex % FRAME_FILTER_HISTORY] = shadowSettings.filter;
 
-        // 1. Render depth of scene to texture (from light's perspective) - only if shadows enabled
-        if (shadowsEnabled && lightManager.getLightCount() > 0) {
-            glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
-            glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
-            glClear(GL_DEPTH_BUFFER_BIT);
+        // Spots : toutes les tuiles de la shadow atlas dans la même passe
+        shadowAtlas->update(lightManager, camera->getPosition(), projection * view,
+                            std::tan(glm::radians(camera->getZoom()) * 0.5f), shadowSettings);
+        if (shadowsEnabled && !shadowAtlas->getTiles().empty()) {
+            GpuProfiler::Scope scope(*gpuProfiler, "spot_atlas");
             shadowMapShader.use();
-            shadowMapShader.setUniform("lightSpaceMatrix", lightSpaceMatrix);
-            renderScene(shadowMapShader);
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            shadowAtlas->begin();
+            for (int tile = 0; tile < static_cast<int>(shadowAtlas->getTiles().size()); ++tile) {
+                const ShadowAtlas::Tile& atlasTile = shadowAtlas->getTiles()[tile];
+                CullResult shadowCasters(&frameArena);
+                cullRenderList(renderList, Frustum(atlasTile.matrix), shadowCasters);
+                shadowCasterCount += shadowCasters.size();
+
+                shadowAtlas->beginTile(tile);
+                shadowMapShader.setUniform("lightSpaceMatrix", atlasTile.matrix);
+                renderScene(shadowMapShader, shadowCasters);
+            }
+            shadowAtlas->end();
+        }
+
+        // Lumières ponctuelles : six faces par lumière, en une passe (geometry shader) ou six
+        pointShadows->update(lightManager, camera->getPosition(), projection * view,
+                             std::tan(glm::radians(camera->getZoom()) * 0.5f), shadowSettings);
+        size_t pointShadowFaceDraws = 0;
+        if (shadowsEnabled && !pointShadows->getLights().empty()) {
+            GpuProfiler::Scope scope(*gpuProfiler, "point_shadows");
+            if (shadowSettings.pointShadowsSinglePass) {
+                pointShadowShader.use();
+                pointShadows->beginSinglePass();
+                for (const PointShadowMaps::ShadowedLight& shadowed : pointShadows->getLights()) {
+                    pointShadows->applySinglePassUniforms(pointShadowShader, shadowed);
+                    pointShadowFaceDraws += renderPointShadowCasters(pointShadowShader, *pointShadows, shadowed, renderList, -1);
+                }
+            } else {
+                pointShadowFaceShader.use();
+                for (const PointShadowMaps::ShadowedLight& shadowed : pointShadows->getLights()) {
+                    pointShadowFaceShader.setUniform("lightPos", shadowed.light->position);
+                    pointShadowFaceShader.setUniform("farPlane", shadowed.farPlane);
+                    for (int face = 0; face < 6; ++face) {
+                        pointShadows->beginFace(shadowed, face);
+                        pointShadowFaceShader.setUniform("shadowMatrix", shadowed.faceMatrices[face]);
+                        pointShadowFaceDraws += renderPointShadowCasters(pointShadowFaceShader, *pointShadows, shadowed, renderList, face);
+                    }
+                }
+            }
         }
+        GLState::bindFramebuffer(sceneFramebuffer);
+        endRenderPass(RenderPass::SHADOW);
+
+        // Objets visibles, de l'avant vers l'arrière
+        CullResult visibleItems(&frameArena);
+        cullRenderList(renderList, Frustum(projection * view), visibleItems);
+        sortFrontToBack(visibleItems, camera->getPosition());
 
-        // 2. Render scene normally with lighting
-        glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
+        GLState::setViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // 2. Pré-passe de profondeur (pas en wireframe : seules les arêtes y seraient écrites)
+        bool depthPrepass = depthPrepassEnabled && !wireframeMode;
+        frameDepthPrepass[frameIndex % FRAME_FILTER_HISTORY] = depthPrepass;
+        beginRenderPass(RenderPass::DEPTH_PREPASS);
+        if (depthPrepass) {
+            depthPrepassShader.use();
+            depthPrepassShader.setUniform("projection", projection);
+            depthPrepassShader.setUniform("view", view);
+            GLState::setColorMask(false);
+            fragmentCounter->begin(FragmentPass::DEPTH_PREPASS);
+            renderDepth(depthPrepassShader, visibleItems);
+            fragmentCounter->end();
+            GLState::setColorMask(true);
+        }
+        endRenderPass(RenderPass::DEPTH_PREPASS);
+
+        // 3. Render scene normally with lighting
+        // Après la pré-passe, seul le fragment le plus proche de chaque pixel passe le test
+        beginRenderPass(RenderPass::MAIN);
+        // Variante spécialisée pour l'état courant (lumières actives, ombres, PCF)
+        Shader& lightingShader = lightingShaders.get(getLightingVariantKey());
         lightingShader.use();
 
         // View and projection matrices
-        glm::mat4 projection = camera->getProjectionMatrix(static_cast<float>(SCR_WIDTH) / static_cast<float>(SCR_HEIGHT));
-        glm::mat4 view = camera->getViewMatrix();
         lightingShader.setUniform("projection", projection);
         lightingShader.setUniform("view", view);
 
         // Camera position
         lightingShader.setUniform("viewPos", camera->getPosition());
-        lightingShader.setUniform("lightSpaceMatrix", lightSpaceMatrix);
         lightingShader.setUniform("shadowsEnabled", shadowsEnabled);
 
         // Send lights to shader (pour les nouveaux shaders)
-        lightManager.sendLightsToShader(lightingShader);
+        {
+            GpuProfiler::Scope scope(*gpuProfiler, "lights_upload");
+            lightManager.sendLightsToShader(lightingShader);
+        }
 
-        // Bind shadow map only if shadows are enabled
-        if (shadowsEnabled) {
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, depthMap);
+        // Cascades (texture sur l'unité 1, matrices et coupes)
+        shadowCascades->applyUniforms(lightingShader, 1, 4, shadowSettings);
+        GLState::bindTexture(2, GL_TEXTURE_2D, shadowAtlas->getTexture());
+        lightingShader.setUniform("shadowAtlas", 2);
+        GLState::bindTexture(3, GL_TEXTURE_2D_ARRAY, pointShadows->getTexture());
+        lightingShader.setUniform("pointShadowMaps", 3);
+
+        {
+            GpuProfiler::Scope scope(*gpuProfiler, "opaque");
+            if (depthPrepass) {
+                GLState::setDepthFunc(GL_EQUAL);
+                GLState::setDepthMask(false);
+            }
+            fragmentCounter->begin(FragmentPass::LIT);
+            renderScene(lightingShader, visibleItems);
+            fragmentCounter->end();
+            GLState::setDepthFunc(GL_LEQUAL);
+            GLState::setDepthMask(true);
         }
+        endRenderPass(RenderPass::MAIN);
 
-        renderScene(lightingShader);
+        // Géométries vues cette frame (LRU), puis évictions au-delà du budget et rechargement
+        // des géométries évincées revenues dans le champ
+        for (const DrawItem* item : visibleItems) {
+            ResourceManager::markVisible(item->handle, item->center, item->radius);
+        }
+        ResourceManager::update(Frustum(projection * view));
 
+        beginRenderPass(RenderPass::SKYBOX);
         if (skybox && skybox->isLoaded()) {
             skybox->render(view, projection);
         }
+        endRenderPass(RenderPass::SKYBOX);
 
         // Render light sources if enabled (always in wireframe)
+        beginRenderPass(RenderPass::LIGHT_SOURCES);
         if (showLightSources) {
             renderLightSources(lightingShader);
         }
+        endRenderPass(RenderPass::LIGHT_SOURCES);
+
+        renderStats.objectsTotal = renderList.size();
+        renderStats.objectsVisible = visibleItems.size();
+        renderStats.shadowCasters = shadowCasterCount;
+        renderStats.shadowStaticRefreshes = shadowCascades->getStaticRefreshCount();
+        renderStats.shadowCascadesReused = shadowCascades->getReusedCascadeCount();
+        renderStats.shadowAtlasTiles = shadowAtlas->getTiles().size();
+        renderStats.shadowAtlasUsage = shadowAtlas->getUsage();
+        renderStats.pointShadowLights = pointShadows->getLights().size();
+        renderStats.pointShadowFaceDraws = pointShadowFaceDraws;
+        renderStats.arenaUsed = frameArena.getUsed();
+        renderStats.arenaCapacity = frameArena.getCapacity();
+        renderStats.shaderVariantsReady = lightingShaders.getReadyCount();
+        renderStats.shaderVariantsTotal = lightingShaders.getVariantCount();
+        renderStats.shaderCompilesPending = shaderCompiler->getPendingCount();
+        renderStats.asyncLoadsPending = AsyncLoader::getStats().inFlight;
+        renderStats.glCallsIssued = GLState::getCounters().issued;
+        renderStats.glCallsFiltered = GLState::getCounters().filtered;
 
         // Render GUI
-        glm::vec3 cameraPos = camera->getPosition();
-        gui.showMainWindow(&shadowsEnabled, &lightManager, &cameraPos, &wireframeMode, &showLightSources);
-        gui.render();
+        beginRenderPass(RenderPass::GUI);
+        if (gui) {
+            glm::vec3 cameraPos = camera->getPosition();
+            gui->showMainWindow(&shadowsEnabled, &lightManager, &cameraPos, &wireframeMode, &showLightSources,
+                                &depthPrepassEnabled);
+            gui->showStatsWindow(renderStats);
+            gui->showGpuProfilerWindow(*gpuProfiler);
+            gui->showShadowWindow(shadowSettings, renderStats);
+            if (gui->showMemoryWindow(ResourceManager::getStats(), &options.vramBudgetMB)) {
+                ResourceManager::setBudget(static_cast<std::size_t>(options.vramBudgetMB) * 1024 * 1024);
+            }
+            if (gui->showStressSceneWindow(stressSettings, stressObjects.size())) {
+                applyStressScene();
+            }
+            gui->showTerrainWindow(terrain->getSettings(), terrain->getStats());
+            if (worldStreamer) {
+                gui->showStreamingWindow(worldStreamer->getSettings(), worldStreamer->getStats());
+            }
+            gui->render();
+        }
+        endRenderPass(RenderPass::GUI);
+
+        gpuProfiler->endFrame();
+        fragmentCounter->endFrame();
+        frameTimer.endFrame();
+        renderStats.cpuFrameMs = frameTimer.getLastFrame().cpuMs;
+        if (benchmark) {
+            benchmark->recordCpu(frameIndex, frameTimer.getLastFrame());
+        }
 
         // Swap buffers and poll events
-        glfwSwapBuffers(window);
+        {
+            TRACE_SCOPE("swap_buffers");
+            if (options.headless) {
+                glFlush();
+            } else {
+                glfwSwapBuffers(window);
+            }
+        }
         glfwPollEvents();
+        ++frameIndex;
+    }
+
+    if (benchmark) {
+        // Récupérer les dernières requêtes GPU encore en vol
+        glFinish();
+        while (gpuProfiler->collect()) {
+            benchmark->recordGpu(gpuProfiler->getResolvedFrameIndex(), gpuProfiler->getResolvedFrameMs(),
+                                 gpuProfiler->getResolvedScopes());
+        }
+
+        benchmark->printSummary();
+        if (benchmark->writeReports(options.reportPrefix)) {
+            std::cout << "Wrote " << options.reportPrefix << ".csv and " << options.reportPrefix << ".json" << std::endl;
+        }
+    }
+
+    if (!options.tracePath.empty()) {
+        Tracer::writeChromeTrace(options.tracePath);
+    }
+
+    if (!options.recordCameraPath.empty() && recordedPath.save(options.recordCameraPath)) {
+        std::cout << "Recorded camera path to " << options.recordCameraPath << std::endl;
+    }
+
+    if (options.headless) {
+        glFinish();
+        double elapsed = glfwGetTime() - renderStartTime;
+        std::cout << "Rendered " << frameIndex << " frames in " << elapsed * 1000.0 << " ms ("
+                  << (frameIndex > 0 ? elapsed * 1000.0 / frameIndex : 0.0) << " ms/frame)" << std::endl;
+
+        // Overdraw de la dernière frame relue
+        collectFragmentCounts();
+        double pixels = static_cast<double>(renderStats.screenPixels);
+        std::cout << "Overdraw: " << renderStats.litFragments / pixels << " lit fragments per pixel";
+        if (renderStats.depthPrepass) {
+            std::cout << ", " << renderStats.prepassFragments / pixels << " depth pre-pass fragments per pixel";
+        }
+        std::cout << std::endl;
+
+        if (!options.outputImage.empty() && offscreenTarget->saveToPPM(options.outputImage)) {
+            std::cout << "Wrote " << options.outputImage << std::endl;
+        }
+        terrain->printReport();
+        if (worldStreamer) {
+            worldStreamer->printReport();
+        }
+        ResourceManager::printReport();
     }
 
     // Cleanup
-    glDeleteFramebuffers(1, &depthMapFBO);
-    glDeleteTextures(1, &depthMap);
+    skybox.reset();
+    worldStreamer.reset();
+    terrain.reset();
+    ResourceManager::clear();
+    shadowCascades.reset();
+    shadowAtlas.reset();
+    pointShadows.reset();
+    offscreenTarget.reset();
+    gpuProfiler.reset();
+    fragmentCounter.reset();
+    // Le thread de compilation peut encore construire un shader rechargé détenu par le
+    // HotReloader : il est arrêté (join) avant que ce shader soit détruit
+    shaderCompiler.reset();
+    hotReloader.reset();
+    JobSystem::shutdown();
+    gui.reset();
 
     glfwTerminate();
     return 0;
 }
 
+#ifdef ENABLE_TRACING
+std::uint64_t passTraceStart[RENDER_PASS_COUNT];
+#endif
+
+void beginRenderPass(RenderPass pass) {
+    frameTimer.beginPass(pass);
+    gpuProfiler->beginScope(getRenderPassName(pass));
+#ifdef ENABLE_TRACING
+    passTraceStart[static_cast<int>(pass)] = Tracer::now();
+#endif
+}
+
+void endRenderPass(RenderPass pass) {
+#ifdef ENABLE_TRACING
+    Tracer::record(getRenderPassName(pass), passTraceStart[static_cast<int>(pass)], Tracer::now());
+#endif
+    gpuProfiler->endScope();
+    frameTimer.endPass(pass);
+}
+
+// Coût GPU du filtrage d'ombre d'une frame résolue (éclairage des objets + préfiltrage VSM),
+// moyenné par mode pour comparer les filtres dans la fenêtre "Shadows"
+void recordShadowFilterCost(const std::vector<GpuProfiler::ScopeResult>& scopes, ShadowFilter filter) {
+    double costMs = 0.0;
+    for (const GpuProfiler::ScopeResult& scope : scopes) {
+        if (std::strcmp(scope.name, "opaque") == 0 || std::strcmp(scope.name, "shadow_prefilter") == 0) {
+            costMs += scope.durationMs;
+        }
+    }
+    double& average = renderStats.shadowFilterGpuMs[static_cast<int>(filter)];
+    average = average > 0.0 ? average * 0.95 + costMs * 0.05 : costMs;
+}
+
+// Coût GPU de la profondeur et de l'éclairage d'une frame résolue (pré-passe + objets éclairés),
+// moyenné avec et sans pré-passe pour voir dans la fenêtre "Performance" quand elle est rentable
+void recordDepthPrepassCost(const std::vector<GpuProfiler::ScopeResult>& scopes, bool depthPrepass) {
+    double costMs = 0.0;
+    for (const GpuProfiler::ScopeResult& scope : scopes) {
+        if (std::strcmp(scope.name, "opaque") == 0 ||
+            std::strcmp(scope.name, getRenderPassName(RenderPass::DEPTH_PREPASS)) == 0) {
+            costMs += scope.durationMs;
+        }
+    }
+    double& average = renderStats.depthPrepassGpuMs[depthPrepass ? 1 : 0];
+    average = average > 0.0 ? average * 0.95 + costMs * 0.05 : costMs;
+}
+
+// Fragments des frames résolues (sans bloquer), dans les statistiques de rendu
+void collectFragmentCounts() {
+    while (fragmentCounter->collect()) {
+        renderStats.depthPrepass = fragmentCounter->wasMeasured(FragmentPass::DEPTH_PREPASS);
+        renderStats.prepassFragments = fragmentCounter->getFragments(FragmentPass::DEPTH_PREPASS);
+        renderStats.litFragments = fragmentCounter->getFragments(FragmentPass::LIT);
+    }
+}
+
+// Applique les hints de contexte OpenGL 3.3 core
+static void applyContextHints() {
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+}
+
+GLFWwindow* createWindow(bool headless) {
+    if (!headless) {
+        if (!glfwInit()) return nullptr;
+        applyContextHints();
+        return glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Multi-Light Blinn-Phong Scene", NULL, NULL);
+    }
+
+    // 1. Plateforme "null" de GLFW : aucun serveur d'affichage requis.
+    //    Contexte EGL surfaceless (Mesa), sinon OSMesa.
+    if (glfwPlatformSupported(GLFW_PLATFORM_NULL)) {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        if (glfwInit()) {
+            const int contextApis[] = { GLFW_EGL_CONTEXT_API, GLFW_OSMESA_CONTEXT_API };
+            for (int api : contextApis) {
+                applyContextHints();
+                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
+                if (GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Headless", NULL, NULL)) {
+                    return window;
+                }
+            }
+            glfwTerminate();
+        }
+    }
+
+    // 2. Repli : fenêtre invisible sur la plateforme par défaut (nécessite un display)
+    glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+    if (!glfwInit()) return nullptr;
+    applyContextHints();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    return glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Headless", NULL, NULL);
+}
+
 void initializeScene() {
+    TRACE_SCOPE("initializeScene");
+
     // Initialize camera
     camera = std::make_unique<Camera>(glm::vec3(0.0f, 3.0f, 8.0f));
 
-    // Initialize geometries
-    sphereGeometry = std::make_unique<Geometry>();
-    sphereGeometry->generateSphere(1.0f, 32, 16);
-
-    cubeGeometry = std::make_unique<Geometry>();
-    cubeGeometry->generateCube(2.0f);
-
-    planeGeometry = std::make_unique<Geometry>();
-    planeGeometry->generatePlane(20.0f, 20.0f);
+    // Initialize geometries (confiées au gestionnaire de ressources)
+    auto createGeometry = [](const char* name, auto generate) {
+        std::unique_ptr<Geometry> geometry = std::make_unique<Geometry>();
+        generate(*geometry);
+        return ResourceManager::addGeometry(std::move(geometry), name);
+    };
 
-    // Cube large pour le sol
-    groundPlaneGeometry = std::make_unique<Geometry>();
-    groundPlaneGeometry->generateCube(40.0f);
+    sphereGeometry = createGeometry("sphere", [](Geometry& geometry) { geometry.generateSphere(1.0f, 32, 16); });
+    cubeGeometry = createGeometry("cube", [](Geometry& geometry) { geometry.generateCube(2.0f); });
+    planeGeometry = createGeometry("plane", [](Geometry& geometry) { geometry.generatePlane(20.0f, 20.0f); });
 
     // Cylindre solide pour les objets de la scène
-    cylinderGeometry = std::make_unique<Geometry>();
-    cylinderGeometry->generateCylinder(1.0f, 1.0f, 24);
+    cylinderGeometry = createGeometry("cylinder", [](Geometry& geometry) { geometry.generateCylinder(1.0f, 1.0f, 24); });
 
     // Géométries pour visualiser les lumières
-    lightSphereGeometry = std::make_unique<Geometry>();
-    lightSphereGeometry->generateWireSphere(1.0f, 16, 8);
+    lightSphereGeometry = createGeometry("light_sphere", [](Geometry& geometry) { geometry.generateWireSphere(1.0f, 16, 8); });
+    lightConeGeometry = createGeometry("light_cone", [](Geometry& geometry) { geometry.generateCone(1.0f, 1.0f, 12); });
+    lightCylinderGeometry = createGeometry("light_cylinder", [](Geometry& geometry) { geometry.generateWireCylinder(1.0f, 1.0f, 8); });
 
-    lightConeGeometry = std::make_unique<Geometry>();
-    lightConeGeometry->generateCone(1.0f, 1.0f, 12);
+    // Objets de la scène (matériaux construits une seule fois, pas à chaque frame)
+    sceneObjects.clear();
 
-    lightCylinderGeometry = std::make_unique<Geometry>();
-    lightCylinderGeometry->generateWireCylinder(1.0f, 1.0f, 8);  // Utilise generateWireCylinder
+    // Sol : terrain plat autour de la scène, collines au-delà
+    terrain = std::make_unique<Terrain>();
 
-    // Initialize materials
-    metalMaterial = Material::createMetal(glm::vec3(0.7f, 0.7f, 0.8f));
-    plasticMaterial = Material::createPlastic(glm::vec3(0.8f, 0.2f, 0.2f));
-    groundMaterial = Material::createRubber(glm::vec3(0.3f, 0.3f, 0.3f));
+    // Sphere - Metal material
+    sceneObjects.emplace_back(sphereGeometry, Material::createMetal(glm::vec3(0.7f, 0.7f, 0.8f)),
+                              glm::vec3(-2.0f, 1.0f, 0.0f));
 
-    // Initialize lights
+    // Cube - Plastic material (rotation autour de Y)
+    sceneObjects.emplace_back(cubeGeometry, Material::createPlastic(glm::vec3(0.8f, 0.2f, 0.2f)),
+                              glm::vec3(2.0f, 1.0f, 0.0f), glm::vec3(1.0f),
+                              glm::vec3(0.0f, 1.0f, 0.0f), 0.5f);
+
+    // Cylindre en bois
+    sceneObjects.emplace_back(cylinderGeometry, Material::createWood(glm::vec3(0.6f, 0.3f, 0.1f)),
+                              glm::vec3(-4.0f, 1.5f, -2.0f), glm::vec3(0.8f, 3.0f, 0.8f));
+
+    // Second sphere - different metal
+    sceneObjects.emplace_back(sphereGeometry, Material::createMetal(glm::vec3(1.0f, 0.8f, 0.3f)),
+                              glm::vec3(0.0f, 2.0f, -3.0f));
+
+    // Second cube - different plastic
+    sceneObjects.emplace_back(cubeGeometry, Material::createPlastic(glm::vec3(0.2f, 0.2f, 0.8f)),
+                              glm::vec3(0.0f, 1.0f, 3.0f), glm::vec3(1.0f),
+                              glm::vec3(1.0f, 0.0f, 1.0f), -0.3f);
+
+    initializeLights();
+}
+
+// Lumières de la scène par défaut (aussi rétablies quand la scène de test est désactivée)
+void initializeLights() {
     lightManager.clear();
 
     // Lumière directionnelle (soleil)
@@ -315,86 +1014,116 @@ void initializeScene() {
     lightManager.addSpotLight(spotLight);
 }
 
-void renderScene(Shader& shader) {
-    // Sol - Cube large et plat
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(0.0f, -2.0f, 0.0f));
-    model = glm::scale(model, glm::vec3(1.0f, 0.1f, 1.0f));
-    shader.setUniform("model", model);
+// Génère la scène de test selon stressSettings, ou rétablit les lumières par défaut.
+// Les objets de la scène par défaut (et le modèle importé) restent en place au centre.
+void applyStressScene() {
+    TRACE_SCOPE("applyStressScene");
 
-    Material visibleGroundMaterial = Material::createRubber(glm::vec3(0.4f, 0.4f, 0.4f));
-    shader.setUniform("material.ambient", visibleGroundMaterial.ambient);
-    shader.setUniform("material.diffuse", visibleGroundMaterial.diffuse);
-    shader.setUniform("material.specular", visibleGroundMaterial.specular);
-    shader.setUniform("material.shininess", visibleGroundMaterial.shininess);
-
-    groundPlaneGeometry->render();
-
-    // Sphere - Metal material
-    model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(-2.0f, 1.0f, 0.0f));
-    shader.setUniform("model", model);
-
-    shader.setUniform("material.ambient", metalMaterial.ambient);
-    shader.setUniform("material.diffuse", metalMaterial.diffuse);
-    shader.setUniform("material.specular", metalMaterial.specular);
-    shader.setUniform("material.shininess", metalMaterial.shininess);
-
-    sphereGeometry->render();
+    if (!stressSettings.enabled) {
+        stressObjects.clear();
+        initializeLights();
+        return;
+    }
 
-    // Cube - Plastic material
-    model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(2.0f, 1.0f, 0.0f));
-    model = glm::rotate(model, static_cast<float>(glfwGetTime()) * 0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
-    shader.setUniform("model", model);
+    std::vector<StressScenePrimitive> primitives = {
+        {sphereGeometry, 1.0f},
+        {cubeGeometry, 1.0f},
+        {cylinderGeometry, 0.5f}
+    };
+    LightManager::LightCounts counts = generateStressScene(stressSettings, primitives, stressObjects, lightManager);
+    std::cout << "Stress scene (seed " << stressSettings.seed << "): " << stressObjects.size() << " objects, "
+              << counts.directional << " directional, " << counts.point << " point and "
+              << counts.spot << " spot lights" << (stressSettings.animate ? ", animated" : "") << std::endl;
+}
 
-    shader.setUniform("material.ambient", plasticMaterial.ambient);
-    shader.setUniform("material.diffuse", plasticMaterial.diffuse);
-    shader.setUniform("material.specular", plasticMaterial.specular);
-    shader.setUniform("material.shininess", plasticMaterial.shininess);
+// Modèle importé (--model), ramené à un rayon de 1.5 et posé sur le sol. Reprend sur le
+// thread GL après l'upload : l'objet est ajouté à la scène entre deux frames. Streamable :
+// évincé au-delà du budget mémoire quand il n'est plus visible.
+Task<bool> loadModel(std::string path) {
+    std::unique_ptr<Geometry> geometry = std::make_unique<Geometry>();
+    bool loaded = co_await AsyncLoader::loadMesh(path, geometry.get());
+    if (loaded && geometry->getBoundsRadius() > 0.0f) {
+        float scale = 1.5f / geometry->getBoundsRadius();
+        glm::vec3 position = glm::vec3(3.5f, 1.5f, -2.5f) - geometry->getBoundsCenter() * scale;
+        modelGeometry = ResourceManager::addGeometry(std::move(geometry), "model", path);
+        sceneObjects.emplace_back(modelGeometry, Material::createPlastic(glm::vec3(0.75f, 0.75f, 0.7f)),
+                                  position, glm::vec3(scale));
+    }
+    co_return loaded;
+}
 
-    cubeGeometry->render();
+// Clé de permutation du shader d'éclairage à partir de l'état de rendu courant
+ShaderVariantKey getLightingVariantKey() {
+    LightManager::LightCounts counts = lightManager.countEnabledLights();
+
+    ShaderVariantKey key;
+    key.shadows = shadowsEnabled && (counts.directional > 0 || counts.point > 0 || counts.spot > 0);
+    key.numDirLights = counts.directional;
+    key.numPointLights = counts.point;
+    key.numSpotLights = counts.spot;
+    key.pcfTaps = shadowSettings.pcfTaps;
+    key.shadowFilter = static_cast<int>(shadowSettings.filter);
+    return key;
+}
 
-    // Cylindre en bois
-    Material woodMaterial = Material::createWood(glm::vec3(0.6f, 0.3f, 0.1f));
-    model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(-4.0f, 1.5f, -2.0f));
-    model = glm::scale(model, glm::vec3(0.8f, 3.0f, 0.8f));
-    shader.setUniform("model", model);
+// Variantes atteignables depuis l'état initial en un clic dans l'UI :
+// ombres activées ou non, et chaque lumière basculée séparément
+std::vector<ShaderVariantKey> getLightingWarmUpKeys() {
+    std::vector<ShaderVariantKey> keys;
+    for (int shadowToggle = 0; shadowToggle < 2; ++shadowToggle) {
+        keys.push_back(getLightingVariantKey());
+        for (auto& light : lightManager.getLights()) {
+            light->enabled = !light->enabled;
+            keys.push_back(getLightingVariantKey());
+            light->enabled = !light->enabled;
+        }
+        shadowsEnabled = !shadowsEnabled;
+    }
+    return keys;
+}
 
-    shader.setUniform("material.ambient", woodMaterial.ambient);
-    shader.setUniform("material.diffuse", woodMaterial.diffuse);
-    shader.setUniform("material.specular", woodMaterial.specular);
-    shader.setUniform("material.shininess", woodMaterial.shininess);
+void renderScene(Shader& shader, const CullResult& items) {
+    for (const DrawItem* item : items) {
+        shader.setUniform("model", item->model);
 
-    cylinderGeometry->render();  // Utilise le cylindre solide
+        shader.setUniform("material.ambient", item->material->ambient);
+        shader.setUniform("material.diffuse", item->material->diffuse);
+        shader.setUniform("material.specular", item->material->specular);
+        shader.setUniform("material.shininess", item->material->shininess);
 
-    // Second sphere - different metal
-    Material goldMaterial = Material::createMetal(glm::vec3(1.0f, 0.8f, 0.3f));
-    model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(0.0f, 2.0f, -3.0f));
-    shader.setUniform("model", model);
+        item->geometry->render();
+    }
+}
 
-    shader.setUniform("material.ambient", goldMaterial.ambient);
-    shader.setUniform("material.diffuse", goldMaterial.diffuse);
-    shader.setUniform("material.specular", goldMaterial.specular);
-    shader.setUniform("material.shininess", goldMaterial.shininess);
+// Profondeur seule (pré-passe) : pas de matériau à transmettre
+void renderDepth(Shader& shader, const CullResult& items) {
+    for (const DrawItem* item : items) {
+        shader.setUniform("model", item->model);
+        item->geometry->render();
+    }
+}
 
-    sphereGeometry->render();
+// Casters d'une lumière ponctuelle. face = -1 : passe unique, le masque des faces touchées
+// est transmis au geometry shader ; sinon seuls les objets visibles depuis cette face.
+// Retourne le nombre de couples (objet, face) dessinés.
+size_t renderPointShadowCasters(Shader& shader, const PointShadowMaps& pointShadows,
+                                const PointShadowMaps::ShadowedLight& shadowed, const RenderList& items, int face) {
+    size_t faceDraws = 0;
+    for (const DrawItem& item : items) {
+        int mask = pointShadows.computeFaceMask(shadowed, item);
+        if (face >= 0) {
+            mask &= 1 << face;
+        }
+        if (mask == 0) continue;
 
-    // Second cube - different plastic
-    Material bluePlasticMaterial = Material::createPlastic(glm::vec3(0.2f, 0.2f, 0.8f));
-    model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(0.0f, 1.0f, 3.0f));
-    model = glm::rotate(model, static_cast<float>(glfwGetTime()) * -0.3f, glm::vec3(1.0f, 0.0f, 1.0f));
-    shader.setUniform("model", model);
-
-    shader.setUniform("material.ambient", bluePlasticMaterial.ambient);
-    shader.setUniform("material.diffuse", bluePlasticMaterial.diffuse);
-    shader.setUniform("material.specular", bluePlasticMaterial.specular);
-    shader.setUniform("material.shininess", bluePlasticMaterial.shininess);
-
-    cubeGeometry->render();
+        if (face < 0) {
+            shader.setUniform("faceMask", mask);
+        }
+        shader.setUniform("model", item.model);
+        item.geometry->render();
+        faceDraws += std::bitset<6>(mask).count();
+    }
+    return faceDraws;
 }
 
 void renderLightSources(Shader& shader) {
@@ -439,7 +1168,7 @@ void renderLightSources(Shader& shader) {
             }
 
             shader.setUniform("model", model);
-            lightCylinderGeometry->renderWireframe();
+            ResourceManager::getGeometry(lightCylinderGeometry)->renderWireframe();
 
         } else if (light->type == LightType::POINT) {
             PointLight* pointLight = static_cast<PointLight*>(light.get());
@@ -448,7 +1177,7 @@ void renderLightSources(Shader& shader) {
             model = glm::scale(model, glm::vec3(0.5f)); // Plus petit
 
             shader.setUniform("model", model);
-            lightSphereGeometry->renderWireframe();
+            ResourceManager::getGeometry(lightSphereGeometry)->renderWireframe();
 
         } else if (light->type == LightType::SPOT) {
             SpotLight* spotLight = static_cast<SpotLight*>(light.get());
@@ -476,7 +1205,7 @@ void renderLightSources(Shader& shader) {
             model = glm::scale(model, glm::vec3(scale, 1.0f, scale));
 
             shader.setUniform("model", model);
-            lightConeGeometry->renderWireframe();
+            ResourceManager::getGeometry(lightConeGeometry)->renderWireframe();
         }
     }
 }
@@ -504,6 +1233,15 @@ void processInput(GLFWwindow *window) {
         tabKeyPressed = false;
     }
 
+    // F9 : écrire la trace CPU courante
+    if (glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS && !traceKeyPressed) {
+        traceKeyPressed = true;
+        Tracer::writeChromeTrace("trace.json");
+    }
+    if (glfwGetKey(window, GLFW_KEY_F9) == GLFW_RELEASE) {
+        traceKeyPressed = false;
+    }
+
     // Contrôles de caméra seulement si pas en mode UI
     if (!uiMode) {
         if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
@@ -522,7 +1260,7 @@ void processInput(GLFWwindow *window) {
 }
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    GLState::setViewport(0, 0, width, height);
 }
 
 void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
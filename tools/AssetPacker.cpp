@@ -0,0 +1,195 @@
+// Construit l'archive d'assets (AssetPack) à partir du répertoire assets :
+//   asset_packer <répertoire assets> <archive> [--lz4]
+//
+// Chaque fichier est stocké sous son chemin relatif au parent du répertoire ("assets/...").
+// Les images reçoivent en plus une entrée "<image>.tex" pré-transcodée (BC1 + mips, format
+// du cache de textures) et les modèles (OBJ, glTF) une entrée "<modèle>.mesh" compilée (format
+// du cache de maillages), servies sans copie au démarrage. Avec --lz4, les entrées qui y gagnent
+// au moins 10 % (shaders, chemins de caméra) sont compressées ; les textures ne le sont jamais.
+#include "AssetPack.hpp"
+#include "LZ4.hpp"
+#include "MeshCache.hpp"
+#include "MeshImporter.hpp"
+#include "TextureCache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct PendingEntry {
+        std::string path;
+        std::string data;
+        std::uint64_t size = 0;     // Taille décompressée
+        std::uint32_t flags = 0;
+    };
+
+    bool isImage(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        return extension == ".jpg" || extension == ".jpeg" || extension == ".png" ||
+               extension == ".tga" || extension == ".bmp";
+    }
+
+    void addEntry(std::vector<PendingEntry>& entries, const std::string& path, std::string data, bool allowLZ4) {
+        PendingEntry entry;
+        entry.path = path;
+        entry.size = data.size();
+        if (allowLZ4 && !data.empty()) {
+            std::string compressed(LZ4::compressBound(data.size()), '\0');
+            std::size_t compressedSize = LZ4::compress(reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+                                                       reinterpret_cast<unsigned char*>(compressed.data()));
+            if (compressedSize * 10 <= data.size() * 9) {
+                compressed.resize(compressedSize);
+                data = std::move(compressed);
+                entry.flags |= AssetPack::FLAG_LZ4;
+            }
+        }
+        entry.data = std::move(data);
+        entries.push_back(std::move(entry));
+    }
+
+    void pad(std::ofstream& file, std::uint64_t& position, std::size_t alignment) {
+        static const char zeros[AssetPack::ALIGNMENT] = {};
+        std::size_t padding = (alignment - position % alignment) % alignment;
+        file.write(zeros, padding);
+        position += padding;
+    }
+
+    bool writePack(const std::string& outputPath, std::vector<PendingEntry>& entries) {
+        std::sort(entries.begin(), entries.end(), [](const PendingEntry& a, const PendingEntry& b) {
+            return a.path < b.path;
+        });
+
+        // Écriture dans un fichier temporaire puis renommage : jamais d'archive à moitié écrite
+        std::string tempPath = outputPath + ".tmp";
+        std::ofstream file(tempPath, std::ios::binary);
+        if (!file) {
+            std::cerr << "Cannot write asset pack: " << tempPath << std::endl;
+            return false;
+        }
+
+        AssetPack::Header header = {};
+        std::memcpy(header.magic, AssetPack::MAGIC, sizeof(AssetPack::MAGIC));
+        header.version = AssetPack::VERSION;
+        header.entryCount = static_cast<std::uint32_t>(entries.size());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::uint64_t position = sizeof(header);
+
+        // Données, chacune alignée sur 64 octets (lignes de cache, vues directement exploitables)
+        std::vector<AssetPack::Entry> index;
+        std::string paths;
+        for (const PendingEntry& pending : entries) {
+            pad(file, position, AssetPack::ALIGNMENT);
+            AssetPack::Entry entry = {};
+            entry.dataOffset = position;
+            entry.storedSize = pending.data.size();
+            entry.size = pending.size;
+            entry.pathOffset = static_cast<std::uint32_t>(paths.size());
+            entry.pathLength = static_cast<std::uint32_t>(pending.path.size());
+            entry.flags = pending.flags;
+            index.push_back(entry);
+            paths += pending.path;
+
+            file.write(pending.data.data(), pending.data.size());
+            position += pending.data.size();
+        }
+
+        pad(file, position, AssetPack::ALIGNMENT);
+        header.indexOffset = position;
+        file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(AssetPack::Entry));
+        position += index.size() * sizeof(AssetPack::Entry);
+
+        header.pathsOffset = position;
+        header.pathsSize = paths.size();
+        file.write(paths.data(), paths.size());
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.close();
+        if (!file) {
+            std::cerr << "Cannot write asset pack: " << tempPath << std::endl;
+            return false;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, outputPath, error);
+        if (error) {
+            std::cerr << "Cannot write asset pack: " << outputPath << " (" << error.message() << ")" << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <assets directory> <output pack> [--lz4]" << std::endl;
+        return 1;
+    }
+    std::filesystem::path assetDirectory = argv[1];
+    std::string outputPath = argv[2];
+    bool useLZ4 = argc > 3 && std::strcmp(argv[3], "--lz4") == 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::error_code error;
+    std::filesystem::path root = std::filesystem::absolute(assetDirectory, error).lexically_normal().parent_path();
+    if (!std::filesystem::is_directory(assetDirectory, error)) {
+        std::cerr << "Not a directory: " << assetDirectory.string() << std::endl;
+        return 1;
+    }
+
+    std::vector<PendingEntry> entries;
+    std::uint64_t sourceBytes = 0;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(assetDirectory)) {
+        if (!item.is_regular_file()) continue;
+
+        std::filesystem::path absolute = std::filesystem::absolute(item.path()).lexically_normal();
+        std::string path = AssetPack::normalizePath(absolute.lexically_relative(root).generic_string());
+
+        std::ifstream file(item.path(), std::ios::binary);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        if (!file) {
+            std::cerr << "Cannot read asset: " << item.path().string() << std::endl;
+            return 1;
+        }
+        std::string data = stream.str();
+        sourceBytes += data.size();
+
+        if (isImage(item.path())) {
+            // Mêmes niveaux que le cache de textures, mais calculés une fois à la construction
+            TextureCache::Image image;
+            if (!TextureCache::transcode(item.path().string(), true, image)) return 1;
+            std::string transcoded;
+            TextureCache::serialize(image, transcoded);
+            addEntry(entries, path + TextureCache::getPackSuffix(), std::move(transcoded), false);
+            // Source compressée : LZ4 n'y gagnerait rien
+            addEntry(entries, path, std::move(data), false);
+        } else if (MeshImporter::isSupported(item.path().string())) {
+            MeshImporter::MeshData mesh;
+            if (!MeshImporter::importFile(item.path().string(), mesh)) return 1;
+            std::string compiled;
+            MeshCache::serialize(mesh, compiled);
+            addEntry(entries, path + MeshCache::getPackSuffix(), std::move(compiled), false);
+            addEntry(entries, path, std::move(data), useLZ4);
+        } else {
+            addEntry(entries, path, std::move(data), useLZ4);
+        }
+    }
+
+    if (!writePack(outputPath, entries)) return 1;
+
+    std::uint64_t packBytes = std::filesystem::file_size(outputPath, error);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Asset pack " << outputPath << ": " << entries.size() << " entries, "
+              << static_cast<double>(sourceBytes) / (1024.0 * 1024.0) << " MB of sources -> "
+              << static_cast<double>(packBytes) / (1024.0 * 1024.0) << " MB in " << elapsed.count() << " ms"
+              << std::endl;
+    return 0;
+}